@@ -0,0 +1,150 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <mutex>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <iota/api/responses/get_account_data.hpp>
+#include <iota/models/address.hpp>
+#include <iota/models/bundle.hpp>
+#include <iota/models/seed.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+class Extended;
+class Portfolio;
+
+/**
+ * State of an account, kept up to date incrementally.
+ *
+ * The first refresh does the same work as Extended::getAccountData. The next ones only request:
+ * - the hashes of the transactions of the known addresses
+ * - the transactions and bundles not seen before
+ * - the inclusion states of the bundles not confirmed yet
+ * - the balances of the addresses whose confirmed transactions changed
+ * New addresses are generated once the last known address got transactions.
+ *
+ * Refreshes are serialized, the state can be read concurrently. Many accounts are refreshed
+ * together with a Portfolio.
+ */
+class Account {
+public:
+  /**
+   * Ctor.
+   *
+   * @param api Api used to refresh the account, must outlive the account.
+   * @param seed Seed of the account.
+   */
+  Account(const Extended& api, const Models::Seed& seed);
+
+  /**
+   * Default dtor.
+   */
+  ~Account() = default;
+
+  Account(const Account&) = delete;
+  Account& operator=(const Account&) = delete;
+
+public:
+  /**
+   * Synchronize the account with the node.
+   *
+   * @return The state of the account once refreshed, as returned by getAccountData.
+   */
+  Responses::GetAccountData refresh();
+
+  /**
+   * @return The state of the account as of the last refresh.
+   */
+  Responses::GetAccountData getData() const;
+
+  /**
+   * @return Seed of the account.
+   */
+  const Models::Seed& getSeed() const;
+
+  /**
+   * @return Number of transactions known for the account.
+   */
+  std::size_t getKnownTransactionsCount() const;
+
+private:
+  /**
+   * Get the data of the account, the mutex must be locked.
+   *
+   * @param duration Duration to report.
+   */
+  Responses::GetAccountData buildData(int64_t duration) const;
+
+  friend class Portfolio;
+
+private:
+  /**
+   * Api used to refresh the account.
+   */
+  const Extended& api_;
+
+  /**
+   * Seed of the account.
+   */
+  Models::Seed seed_;
+
+  /**
+   * Serializes the refreshes.
+   */
+  std::mutex refreshMutex_;
+
+  /**
+   * Protects the state.
+   */
+  mutable std::mutex mutex_;
+
+  /**
+   * Addresses of the account with their balance, by index. The last one is unused.
+   */
+  std::vector<Models::Address> addresses_;
+
+  /**
+   * Hashes of the transactions whose bundle is known, or invalid and never fetched again.
+   */
+  std::unordered_set<Types::Trytes> knownTransactions_;
+
+  /**
+   * Bundles of the account, by tail hash.
+   */
+  std::unordered_map<Types::Trytes, Models::Bundle> bundles_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
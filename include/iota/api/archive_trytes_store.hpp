@@ -0,0 +1,86 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <mutex>
+#include <string>
+
+#include <iota/api/trytes_cache.hpp>
+#include <iota/storage/transaction_archive.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Persistent trytes store, backed by a TransactionArchive.
+ * Transactions are hashed before being stored, so that a corrupted reply never ends up in the
+ * archive.
+ */
+class ArchiveTrytesStore : public TrytesStore {
+public:
+  /**
+   * Opens the archive stored at the given path, the file is created if it does not exist.
+   * Throws an IllegalState exception if the file can not be opened or is not a valid archive.
+   *
+   * @param path Path of the archive file.
+   */
+  explicit ArchiveTrytesStore(const std::string& path);
+
+  /**
+   * Default dtor.
+   */
+  ~ArchiveTrytesStore() = default;
+
+public:
+  bool load(const Types::Trytes& hash, Types::Trytes& trytes) override;
+  bool save(const Types::Trytes& hash, const Types::Trytes& trytes) override;
+
+  /**
+   * Writes pending transactions to the file.
+   */
+  void flush();
+
+  /**
+   * @return Number of stored transactions.
+   */
+  std::size_t size() const;
+
+private:
+  /**
+   * Protects the archive, which is not thread safe.
+   */
+  mutable std::mutex mutex_;
+
+  /**
+   * The archive.
+   */
+  Storage::TransactionArchive archive_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
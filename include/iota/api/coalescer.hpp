@@ -0,0 +1,228 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <iota/types/trinary.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Merges the requests of concurrent callers into a single one.
+ *
+ * The first caller of a batch waits for the coalescing window, during which other callers of the
+ * same group add their items to the batch. It then sends one request for all the (deduplicated)
+ * items and hands the response to every caller of the batch, along with the positions of their
+ * items. Only requests of the same group, i.e. with the same parameters besides the items, are
+ * merged. No thread is spawned: the request is sent by the first caller.
+ *
+ * @tparam Response The response of the merged requests.
+ */
+template <typename Response>
+class Coalescer {
+public:
+  /**
+   * Sends the merged request.
+   */
+  using Fetch = std::function<Response(const std::vector<Types::Trytes>&)>;
+
+  /**
+   * Result of a call, for one caller.
+   */
+  struct Result {
+    /**
+     * Response to the merged request.
+     */
+    std::shared_ptr<const Response> response;
+
+    /**
+     * Position in the merged request of each item of the caller.
+     */
+    std::vector<std::size_t> indexes;
+  };
+
+public:
+  /**
+   * Ctor.
+   *
+   * @param window Coalescing window, 0 disables coalescing.
+   */
+  explicit Coalescer(const std::chrono::microseconds& window = std::chrono::microseconds(0))
+      : window_(window.count()) {
+  }
+
+public:
+  /**
+   * @return Whether coalescing is enabled.
+   */
+  bool enabled() const { return window_ > 0; }
+
+  /**
+   * @return Coalescing window.
+   */
+  std::chrono::microseconds getWindow() const { return std::chrono::microseconds(window_); }
+
+  /**
+   * @param window Coalescing window, 0 disables coalescing.
+   */
+  void setWindow(const std::chrono::microseconds& window) { window_ = window.count(); }
+
+public:
+  /**
+   * Add items to the batch of the group and wait for the merged response.
+   * Exceptions thrown by the merged request are rethrown to every caller of the batch.
+   *
+   * @param group Requests of different groups are never merged.
+   * @param items Items of the caller.
+   * @param maxItems The batch is sent as soon as it has this many items, 0 for no limit.
+   * @param fetch Function sending the merged request, if the caller opens the batch.
+   *
+   * @return The merged response and the positions of the items.
+   */
+  Result join(const std::string& group, const std::vector<Types::Trytes>& items,
+              std::size_t maxItems, const Fetch& fetch) {
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    auto& open   = batches_[group];
+    bool  leader = !open;
+
+    if (leader) {
+      open = std::make_shared<Batch>();
+    }
+
+    auto   batch = open;
+    Result result;
+
+    result.indexes.reserve(items.size());
+    for (const auto& item : items) {
+      auto position = batch->positions.emplace(item, batch->items.size());
+
+      if (position.second) {
+        batch->items.push_back(item);
+      }
+
+      result.indexes.push_back(position.first->second);
+    }
+
+    if (maxItems != 0 && batch->items.size() >= maxItems) {
+      close(group, batch);
+    }
+
+    if (leader) {
+      cv_.wait_for(lock, getWindow(), [&batch] { return batch->closed; });
+      close(group, batch);
+
+      //! the batch is closed, nobody else touches the items
+      lock.unlock();
+
+      try {
+        batch->response = std::make_shared<const Response>(fetch(batch->items));
+      } catch (...) {
+        batch->error = std::current_exception();
+      }
+
+      lock.lock();
+      batch->done = true;
+      cv_.notify_all();
+    } else {
+      cv_.wait(lock, [&batch] { return batch->done; });
+    }
+
+    if (batch->error) {
+      std::rethrow_exception(batch->error);
+    }
+
+    result.response = batch->response;
+    return result;
+  }
+
+private:
+  /**
+   * Items collected from the callers, and the merged response once received.
+   */
+  struct Batch {
+    std::vector<Types::Trytes>                     items;
+    std::unordered_map<Types::Trytes, std::size_t> positions;
+    std::shared_ptr<const Response>                response;
+    std::exception_ptr                             error;
+    bool                                           closed = false;
+    bool                                           done   = false;
+  };
+
+  /**
+   * Stop adding items to a batch: next callers of the group open a new one. Mutex must be held.
+   *
+   * @param group Group of the batch.
+   * @param batch The batch.
+   */
+  void close(const std::string& group, const std::shared_ptr<Batch>& batch) {
+    if (batch->closed) {
+      return;
+    }
+
+    batch->closed = true;
+    batches_.erase(group);
+    cv_.notify_all();
+  }
+
+private:
+  /**
+   * Coalescing window, in microseconds.
+   */
+  std::atomic<int64_t> window_;
+
+  /**
+   * Open batch of each group.
+   */
+  std::map<std::string, std::shared_ptr<Batch>> batches_;
+
+  /**
+   * Protects the batches.
+   */
+  std::mutex mutex_;
+
+  /**
+   * Signals closed and done batches.
+   */
+  std::condition_variable cv_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -25,8 +25,17 @@
 
 #pragma once
 
+#include <algorithm>
+#include <chrono>
+#include <functional>
+#include <future>
+#include <memory>
+
+#include <iota/api/coalescer.hpp>
+#include <iota/api/node_info_cache.hpp>
 #include <iota/api/responses/fwd.hpp>
 #include <iota/api/service.hpp>
+#include <iota/api/trytes_cache.hpp>
 #include <iota/models/address.hpp>
 #include <iota/models/tag.hpp>
 
@@ -52,6 +61,19 @@ public:
    */
   explicit Core(const std::string& host, const uint16_t& port, bool localPow = true,
                 int timeout = 60, const std::string& user = "", const std::string& pass = "");
+
+  /**
+   * Multi-node ctor: requests are balanced between the nodes, and retried on another node on
+   * failure when possible. See Service.
+   *
+   * @param nodes The hosts and ports of the nodes to connect to.
+   * @param localPow Whether to do local or remote proof of work.
+   * @param timeout Timeout for the requests.
+   * @param user Username for authenticated requests.
+   * @param pass Password for authenticated requests.
+   */
+  explicit Core(const std::vector<Endpoint>& nodes, bool localPow = true, int timeout = 60,
+                const std::string& user = "", const std::string& pass = "");
   /**
    * Default dtor.
    */
@@ -67,6 +89,14 @@ public:
    */
   Responses::GetNodeInfo getNodeInfo() const;
 
+  /**
+   * Same as getNodeInfo, but a node info received less than the node info ttl ago is reused, and
+   * concurrent callers share a single request. See getNodeInfoCache.
+   *
+   * @return The response.
+   */
+  Responses::GetNodeInfo getCachedNodeInfo() const;
+
   /**
    * Returns the set of neighbors you are connected with, as well as their activity count. The
    * activity counter is reset after restarting IRI.
@@ -143,6 +173,17 @@ public:
    */
   Responses::GetTrytes getTrytes(const std::vector<Types::Trytes>& hashes) const;
 
+  /**
+   * Same as getTrytes, but the trytes of each transaction are passed to the callback as soon as
+   * they are read from the reply, in the order of the hashes. The reply is parsed incrementally
+   * instead of being loaded into a json document and then copied into a vector of trytes.
+   *
+   * @param hashes List of transaction hashes of which you want to get trytes from.
+   * @param callback Function called with the trytes of each transaction.
+   */
+  void getTrytes(const std::vector<Types::Trytes>&                hashes,
+                 const std::function<void(const Types::Trytes&)>& callback) const;
+
   /**
    * Get the inclusion states of a set of transactions. This is for determining if a transaction was
    * accepted and confirmed by the network or not. You can search for multiple tips (and thus,
@@ -281,6 +322,274 @@ public:
    */
   Responses::CheckConsistency checkConsistency(const std::vector<Types::Trytes>& tails) const;
 
+public:
+  /**
+   * Asynchronous versions of the api calls.
+   * Requests are run on the workers of the service (see Service::getWorkerPool): many requests can
+   * be in flight without dedicating a thread to each of them. Errors are rethrown by the returned
+   * futures. The arguments are copied, the api object does not need to outlive the futures.
+   */
+public:
+  /**
+   * Asynchronous version of getNodeInfo.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::GetNodeInfo> getNodeInfoAsync() const;
+
+  /**
+   * Asynchronous version of findTransactions.
+   *
+   * @param addresses List of addresses.
+   * @param tags List of transaction tags.
+   * @param approvees List of approvees of a transaction.
+   * @param bundles List of bundle hashes.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::FindTransactions> findTransactionsAsync(
+      const std::vector<Models::Address>& addresses, const std::vector<Models::Tag>& tags,
+      const std::vector<Types::Trytes>& approvees, const std::vector<Types::Trytes>& bundles) const;
+
+  /**
+   * Asynchronous version of getTrytes.
+   *
+   * @param hashes List of transaction hashes of which you want to get trytes from.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::GetTrytes> getTrytesAsync(const std::vector<Types::Trytes>& hashes) const;
+
+  /**
+   * Asynchronous version of getInclusionStates.
+   *
+   * @param transactions List of transactions you want to get the inclusion state for.
+   * @param tips List of tips (including milestones) you want to search for the inclusion state.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::GetInclusionStates> getInclusionStatesAsync(
+      const std::vector<Types::Trytes>& transactions, const std::vector<Types::Trytes>& tips) const;
+
+  /**
+   * Asynchronous version of getBalances.
+   *
+   * @param addresses List of addresses you want to get the confirmed balance from.
+   * @param threshold Confirmation threshold, should be set to 100.
+   * @param tips List of hashes to compute the balances from.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::GetBalances> getBalancesAsync(
+      const std::vector<Models::Address>& addresses, const int& threshold = 100,
+      const std::vector<Types::Trytes>& tips = {}) const;
+
+  /**
+   * Asynchronous version of getTransactionsToApprove.
+   *
+   * @param depth Number of bundles to go back to determine the transactions for approval.
+   * @param reference Hash of transaction to start random-walk from.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::GetTransactionsToApprove> getTransactionsToApproveAsync(
+      const int& depth, const Types::Trytes& reference = "") const;
+
+  /**
+   * Asynchronous version of broadcastTransactions.
+   *
+   * @param trytes List of raw data of transactions to be rebroadcast.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::Base> broadcastTransactionsAsync(
+      const std::vector<Types::Trytes>& trytes) const;
+
+  /**
+   * Asynchronous version of storeTransactions.
+   *
+   * @param trytes List of raw data of transactions to be stored.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::Base> storeTransactionsAsync(
+      const std::vector<Types::Trytes>& trytes) const;
+
+  /**
+   * Asynchronous version of wereAddressesSpentFrom.
+   *
+   * @param addresses List of addresses you want to check if they were spent from.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::WereAddressesSpentFrom> wereAddressesSpentFromAsync(
+      const std::vector<Models::Address>& addresses) const;
+
+  /**
+   * Asynchronous version of checkConsistency.
+   *
+   * @param tails Tails to check consistency.
+   *
+   * @return The future response.
+   */
+  std::future<Responses::CheckConsistency> checkConsistencyAsync(
+      const std::vector<Types::Trytes>& tails) const;
+
+public:
+  /**
+   * Internal service used for api calls, to tune the way the node is contacted.
+   *
+   * @return The service.
+   */
+  const Service& getService() const;
+
+  /**
+   * Internal service used for api calls, to tune the way the nodes are contacted.
+   *
+   * @return The service.
+   */
+  Service& getService();
+
+  /**
+   * @return Maximum number of items (hashes, addresses...) sent in a single request.
+   */
+  std::size_t getMaxItemsPerRequest() const;
+
+  /**
+   * Larger getTrytes, getBalances, findTransactions, getInclusionStates and wereAddressesSpentFrom
+   * calls are split into several requests, run concurrently on the workers of the service. Results
+   * are merged back in the order of the input.
+   *
+   * @param maxItems Maximum number of items sent in a single request, 0 disables chunking.
+   */
+  void setMaxItemsPerRequest(std::size_t maxItems);
+
+  /**
+   * @return Coalescing window of getTrytes and getBalances calls.
+   */
+  std::chrono::microseconds getCoalescingWindow() const;
+
+  /**
+   * Opt-in merging of concurrent getTrytes and getBalances calls, for example from several threads
+   * sharing this api object: calls made within the window are sent as a single request, whose
+   * response is then split back between the callers. Calls are delayed by up to the window.
+   * The setting is shared with the copies of this object.
+   *
+   * @param window Coalescing window (typically a few milliseconds), 0 disables coalescing.
+   */
+  void setCoalescingWindow(const std::chrono::microseconds& window);
+
+  /**
+   * @return Cache of the transaction trytes, null if disabled.
+   */
+  const std::shared_ptr<TrytesCache>& getTrytesCache() const;
+
+  /**
+   * Opt-in caching of getTrytes results: transactions found in the cache are not requested to the
+   * node again. Copies of this object made afterwards use the same cache, which may also be shared
+   * by several api objects.
+   *
+   * @param cache Cache of the transaction trytes, null disables caching.
+   */
+  void setTrytesCache(const std::shared_ptr<TrytesCache>& cache);
+
+  /**
+   * Cache of the node info used by getCachedNodeInfo, shared by copies. Its ttl can be changed, 0
+   * disabling caching.
+   *
+   * @return The cache.
+   */
+  NodeInfoCache& getNodeInfoCache() const;
+
+  /**
+   * Fetch the node info of the cache in the background, so that getCachedNodeInfo callers never
+   * wait for it. The refresh runs until stopped or until the last copy of this object is destroyed.
+   */
+  void startNodeInfoRefresh() const;
+
+  /**
+   * Stop the background refresh of the node info.
+   */
+  void stopNodeInfoRefresh() const;
+
+public:
+  /**
+   * Default maximum number of items sent in a single request.
+   */
+  static const std::size_t DefaultMaxItemsPerRequest = 1000;
+
+private:
+  /**
+   * Split items into chunks of at most maxItemsPerRequest_ items and call request for each of
+   * them, concurrently.
+   *
+   * @param items The items to split.
+   * @param request The function sending the request for a chunk.
+   *
+   * @return The responses, in the order of the chunks.
+   */
+  template <typename Response, typename T, typename F>
+  std::vector<Response> requestChunks(const std::vector<T>& items, F request) const {
+    auto                  size = maxItemsPerRequest_;
+    std::vector<Response> responses((items.size() + size - 1) / size);
+
+    service_.getWorkerPool().parallelFor(responses.size(), [&](std::size_t i) {
+      auto begin = items.begin() + i * size;
+      auto end   = items.begin() + std::min(items.size(), (i + 1) * size);
+
+      responses[i] = request(std::vector<T>(begin, end));
+    });
+
+    return responses;
+  }
+
+  /**
+   * @param count Number of items of a call.
+   *
+   * @return Whether the call must be split into several requests.
+   */
+  bool mustChunk(std::size_t count) const;
+
+  /**
+   * getTrytes, without caching.
+   *
+   * @param hashes List of transaction hashes of which you want to get trytes from.
+   *
+   * @return The response.
+   */
+  Responses::GetTrytes joinTrytes(const std::vector<Types::Trytes>& hashes) const;
+
+  /**
+   * Streamed getTrytes, without caching.
+   *
+   * @param hashes List of transaction hashes of which you want to get trytes from.
+   * @param callback Called with the trytes of each transaction, in order.
+   */
+  void streamTrytes(const std::vector<Types::Trytes>&                hashes,
+                    const std::function<void(const Types::Trytes&)>& callback) const;
+
+  /**
+   * getTrytes, without coalescing.
+   *
+   * @param hashes List of transaction hashes of which you want to get trytes from.
+   *
+   * @return The response.
+   */
+  Responses::GetTrytes fetchTrytes(const std::vector<Types::Trytes>& hashes) const;
+
+  /**
+   * getBalances, without coalescing.
+   *
+   * @param addresses List of addresses you want to get the confirmed balance from.
+   * @param threshold Confirmation threshold.
+   * @param tips List of hashes to compute the balances from.
+   *
+   * @return The response.
+   */
+  Responses::GetBalances fetchBalances(const std::vector<Models::Address>& addresses,
+                                       const int&                          threshold,
+                                       const std::vector<Types::Trytes>&   tips) const;
+
 private:
   /**
    * Internal service for api calls.
@@ -290,6 +599,26 @@ private:
    * Defines whether PoW is done locally or remotely.
    */
   bool localPow_;
+  /**
+   * Maximum number of items sent in a single request.
+   */
+  std::size_t maxItemsPerRequest_;
+  /**
+   * Merges concurrent getTrytes calls, shared by copies.
+   */
+  std::shared_ptr<Coalescer<Responses::GetTrytes>> trytesCoalescer_;
+  /**
+   * Merges concurrent getBalances calls, shared by copies.
+   */
+  std::shared_ptr<Coalescer<Responses::GetBalances>> balancesCoalescer_;
+  /**
+   * Cache of the transaction trytes, shared by copies. Null if disabled.
+   */
+  std::shared_ptr<TrytesCache> trytesCache_;
+  /**
+   * Cache of the node info, shared by copies.
+   */
+  std::shared_ptr<NodeInfoCache> nodeInfoCache_;
 };
 
 }  // namespace API
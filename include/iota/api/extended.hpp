@@ -25,6 +25,8 @@
 
 #pragma once
 
+#include <unordered_map>
+
 #include <iota/api/core.hpp>
 #include <iota/models/fwd.hpp>
 #include <iota/utils/stop_watch.hpp>
@@ -49,6 +51,19 @@ public:
    * @param timeout Timeout for the requests.
    */
   Extended(const std::string& host, const uint16_t& port, bool localPow = true, int timeout = 60, const std::string& user = "", const std::string& pass = "");
+
+  /**
+   * Multi-node ctor: requests are balanced between the nodes, and retried on another node on
+   * failure when possible. See Service.
+   *
+   * @param nodes The hosts and ports of the nodes to connect to.
+   * @param localPow Whether to do local or remote proof of work.
+   * @param timeout Timeout for the requests.
+   * @param user Username for authenticated requests.
+   * @param pass Password for authenticated requests.
+   */
+  explicit Extended(const std::vector<Endpoint>& nodes, bool localPow = true, int timeout = 60,
+                    const std::string& user = "", const std::string& pass = "");
   /**
    * Default dtor.
    */
@@ -71,6 +86,59 @@ public:
                                             const int32_t& end       = 0,
                                             const int64_t& threshold = 0) const;
 
+  /**
+   * Gets the balances of all the funded addresses of a seed, with a single getBalances call (split
+   * in chunks by the core api if needed). Addresses are either derived in parallel for the given
+   * key range, or looked for by windows of addresses derived in parallel until one is neither used
+   * nor spent from: that one is then kept as remainder address.
+   *
+   * @param seed  Seed to be used for address generation.
+   * @param start Starting key index for address generation (included).
+   * @param end   Ending key index for address generation (excluded), 0 to look for all addresses.
+   *
+   * @return The funded addresses, with the proof of their balances.
+   */
+  Responses::GetInputsSnapshot getInputsSnapshot(const Models::Seed& seed, const int32_t& start = 0,
+                                                 const int32_t& end = 0) const;
+
+  /**
+   * How inputs are chosen among the funded addresses.
+   */
+  enum class InputStrategy {
+    //! as few inputs as possible, leaving the lowest remainder for that number of inputs
+    FewestInputs,
+    //! the lowest remainder, with as few inputs as possible for that remainder
+    MinimizeRemainder,
+    //! inputs by key index, as getInputs does
+    OldestFirst
+  };
+
+  /**
+   * Select inputs to send a value from a snapshot, without any request.
+   * Throws an IllegalState exception if the snapshot has not enough balance.
+   *
+   * @param snapshot Funded addresses to choose from.
+   * @param value    Value to send.
+   * @param strategy How inputs are chosen.
+   *
+   * @return The selected inputs, with the proof of their balances.
+   */
+  static Responses::SelectInputs selectInputs(const Responses::GetInputsSnapshot& snapshot,
+                                              const int64_t& value, InputStrategy strategy);
+
+  /**
+   * Select inputs of a seed to send a value: same as selectInputs on the result of
+   * getInputsSnapshot(seed).
+   *
+   * @param seed     Seed to be used for address generation.
+   * @param value    Value to send.
+   * @param strategy How inputs are chosen.
+   *
+   * @return The selected inputs, with the proof of their balances.
+   */
+  Responses::SelectInputs selectInputs(const Models::Seed& seed, const int64_t& value,
+                                       InputStrategy strategy = InputStrategy::FewestInputs) const;
+
   /**
    * Gets the balances for the given addresses.
    *
@@ -145,6 +213,32 @@ public:
   std::vector<Models::Bundle> bundlesFromAddresses(const std::vector<Models::Address>& addresses,
                                                    bool withInclusionStates = false) const;
 
+  /**
+   * Get the bundles the given transactions belong to: the tails are traversed directly, the
+   * bundles of the other transactions are looked up by bundle hash. Invalid bundles are skipped.
+   *
+   * @param trxs                Transactions, as returned by findTransactionObjects.
+   * @param withInclusionStates If <code>true</code>, it gets the inclusion states of the transfers.
+   *
+   * @return Bundles.
+   */
+  std::vector<Models::Bundle> bundlesFromTransactions(const std::vector<Models::Transaction>& trxs,
+                                                      bool withInclusionStates = false) const;
+
+  /**
+   * Same as bundlesFromTransactions, also giving the bundles that were read but failed the
+   * verification. Unlike the bundles that could not be read, they will never be valid.
+   *
+   * @param trxs                Transactions, as returned by findTransactionObjects.
+   * @param withInclusionStates If <code>true</code>, it gets the inclusion states of the transfers.
+   * @param rejected            Set with the invalid bundles.
+   *
+   * @return Bundles.
+   */
+  std::vector<Models::Bundle> bundlesFromTransactions(
+      const std::vector<Models::Transaction>& trxs, bool withInclusionStates,
+      std::vector<Models::Bundle>& rejected) const;
+
   /**
    * Lookup transactions for given addresses and return a list of transaction objects
    *
@@ -155,6 +249,17 @@ public:
   std::vector<Models::Transaction> findTransactionObjects(
       const std::vector<Models::Address>& addresses) const;
 
+  /**
+   * Same as findTransactionObjects, but each transaction is passed to the callback as soon as it
+   * is read from the reply instead of being returned in a list.
+   *
+   * @param addresses Addresses for which transactions objects should be found.
+   * @param callback Function called for each transaction.
+   */
+  void findTransactionObjects(
+      const std::vector<Models::Address>&                    addresses,
+      const std::function<void(const Models::Transaction&)>& callback) const;
+
   /**
    * Lookup transactions for given transaction hashes and return a list of transaction objects
    * If a specific transaction does not exist, return valid transaction tryte 9-filled
@@ -166,6 +271,18 @@ public:
   std::vector<Models::Transaction> getTransactionsObjects(
       const std::vector<IOTA::Types::Trytes>& trx_hashes) const;
 
+  /**
+   * Same as getTransactionsObjects, but each transaction is passed to the callback as soon as it is
+   * read from the reply instead of being returned in a list. Peak memory does not depend on the
+   * number of transactions, apart from the raw reply itself.
+   *
+   * @param trx_hashes Hashes of the transactions to find
+   * @param callback Function called for each transaction, in the order of the hashes.
+   */
+  void getTransactionsObjects(
+      const std::vector<IOTA::Types::Trytes>&                trx_hashes,
+      const std::function<void(const Models::Transaction&)>& callback) const;
+
   /**
    * Same as findTransactionObjects, but based on bundle hash
    *
@@ -177,7 +294,8 @@ public:
       const std::vector<IOTA::Types::Trytes>& input) const;
 
   /**
-   * Get inclusion states for the given transactions.
+   * Get inclusion states for the given transactions, relative to the latest solid milestone given
+   * by getCachedNodeInfo.
    *
    * @param hashes Hash of the transactions for which the inclusion states will be retrieved.
    *
@@ -205,6 +323,23 @@ public:
                                               const std::vector<Models::Address>&  inputs    = {},
                                               bool validateInputs = true) const;
 
+  /**
+   * Same as prepareTransfers, with inputs given by selectInputs: their balances are not requested
+   * again.
+   *
+   * @param seed      Seed to be used for address generation.
+   * @param transfers Array of transfer objects.
+   * @param selection The selected inputs.
+   * @param remainder If this address will be used for sending the remainder value to. Leave empty
+   * to use the remainder address of the selection, if any.
+   *
+   * @return Returns bundle trytes.
+   */
+  std::vector<Types::Trytes> prepareTransfers(const Models::Seed&                  seed,
+                                              const std::vector<Models::Transfer>& transfers,
+                                              const Responses::SelectInputs&       selection,
+                                              const Models::Address& remainder = {}) const;
+
   /**
    * Gets the associated bundle of a tail transaction.
    * Does validation of signatures, total sum as well as bundle ordering.
@@ -388,6 +523,40 @@ public:
    */
   bool isPromotable(const Types::Trytes& tail) const;
 
+  /**
+   * Checks if tail transactions are promotable, with as few checkConsistency calls as possible.
+   * Tails are checked by chunks of getMaxItemsPerRequest tails. A chunk which is not consistent as
+   * a whole, or which is rejected by the node, is split in halves until the tails which are not
+   * promotable are isolated.
+   *
+   * @param tails Tail transactions hashes.
+   *
+   * @return whether each tail is promotable or not.
+   */
+  std::vector<bool> isPromotable(const std::vector<Types::Trytes>& tails) const;
+
+  /**
+   * State of a pending tail transaction.
+   */
+  enum class TailState {
+    //! the tail is confirmed
+    Confirmed,
+    //! the tail is not confirmed yet, and can be promoted
+    Promotable,
+    //! the tail is not confirmed and can not be promoted: its bundle must be reattached
+    Reattachable
+  };
+
+  /**
+   * Classify pending tail transactions, with a getLatestInclusion call and the checkConsistency
+   * calls of isPromotable for the tails which are not confirmed.
+   *
+   * @param tails Tail transactions hashes.
+   *
+   * @return the state of each tail.
+   */
+  std::vector<TailState> getTailStates(const std::vector<Types::Trytes>& tails) const;
+
   /**
    * Promotes a transaction by adding spam on top of it, as long as it is promotable. Will promote
    * by adding transfers on top of the current one with delay interval. Use params.interrupt to
@@ -416,10 +585,44 @@ public:
    **/
   std::vector<bool> isReattachable(const std::vector<Models::Address>& addresses);
 
+  /**
+   * Same as isReattachable, for several sets of addresses at once (for example the pending inputs
+   * of several accounts): the transactions of all the addresses are found, read and checked for
+   * inclusion with a single request per step.
+   * Only the address and value of the transactions are read from their trytes, and only the
+   * inclusion of the spending transactions is requested.
+   *
+   * @param addresses Sets of input addresses you want to have tested
+   * @return array of bool associated to each input address, for each set
+   **/
+  std::vector<std::vector<bool>> isReattachable(
+      const std::vector<std::vector<Models::Address>>& addresses) const;
+
 private:
-  void traverseBundles(const std::vector<Types::Trytes>&                          trxs,
-                       const std::vector<std::reference_wrapper<Models::Bundle>>& bundles,
-                       bool throwOnFail) const;
+  /**
+   * Fetch all the transactions of the given bundles, in two requests.
+   * Nothing is fetched if the bundles have many more transactions than expected, because of their
+   * reattachments: the caller then walks their trunks.
+   *
+   * @param bundleHashes Hashes of the bundles.
+   * @param expected Number of transactions of the bundles, reattachments excluded.
+   * @param fetched Transactions already known, completed with the bundles transactions.
+   */
+  void prefetchBundles(const std::vector<Types::Trytes>&                       bundleHashes,
+                       std::size_t                                             expected,
+                       std::unordered_map<Types::Trytes, Models::Transaction>& fetched) const;
+
+  /**
+   * Check the consistency of tails, splitting them in halves until the inconsistent ones are
+   * isolated.
+   *
+   * @param tails Tail transactions hashes.
+   * @param first First tail to check.
+   * @param last End of the tails to check.
+   * @param promotable Set to false for the inconsistent tails.
+   */
+  void checkConsistencyBisect(const std::vector<Types::Trytes>& tails, std::size_t first,
+                              std::size_t last, std::vector<char>& promotable) const;
 
   /**
    * @return true if all transfers are valid, false otherwise
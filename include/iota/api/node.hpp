@@ -0,0 +1,197 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <chrono>
+#include <mutex>
+#include <string>
+
+#include <cpr/cpr.h>
+
+#include <iota/api/session_pool.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Host and port of a node.
+ */
+struct Endpoint {
+  /**
+   * Host of the node, including the scheme.
+   */
+  std::string host;
+  /**
+   * Port of the node.
+   */
+  uint16_t port;
+};
+
+/**
+ * A node contacted by a Service, along with its keep-alive sessions and health statistics.
+ * Statistics are exponentially weighted moving averages of the latency and of the error rate of
+ * the requests sent to the node. A failed request counts as a request lasting the whole timeout,
+ * so that an unreachable node is more expensive than a slow one. Thread safe.
+ */
+class Node {
+public:
+  /**
+   * Ctor.
+   *
+   * @param endpoint Host and port of the node.
+   * @param timeout Request timeout, in seconds.
+   * @param user Username for authenticated requests.
+   * @param pass Password for authenticated requests.
+   */
+  Node(const Endpoint& endpoint, int timeout, const std::string& user, const std::string& pass);
+
+  /**
+   * Default dtor.
+   */
+  ~Node() = default;
+
+  Node(const Node&) = delete;
+  Node& operator=(const Node&) = delete;
+
+public:
+  /**
+   * Send a request to the node, and update the statistics.
+   * Throws a Network exception if the node could not be reached.
+   *
+   * @param body The serialized request.
+   * @param headers Additional headers.
+   *
+   * @return The raw response.
+   */
+  cpr::Response post(const std::string& body, const cpr::Header& headers = {});
+
+  /**
+   * Account for a reply that was received but that is not usable, such as a gateway error.
+   */
+  void recordFailure();
+
+public:
+  /**
+   * Cost of sending a request to the node, lower is better: the expected latency, weighted by the
+   * requests in flight and the error rate. Nodes never contacted are expected to answer within
+   * PriorLatency.
+   *
+   * @return The score of the node.
+   */
+  double getScore() const;
+
+  /**
+   * @return Moving average of the latency of the requests, failures counting as the timeout.
+   * PriorLatency until the node is contacted.
+   */
+  std::chrono::microseconds getLatency() const;
+
+  /**
+   * @return Moving average of the error rate, between 0 and 1.
+   */
+  double getErrorRate() const;
+
+  /**
+   * @return Number of requests in flight.
+   */
+  int getInFlight() const;
+
+  /**
+   * @return Url of the node.
+   */
+  const std::string& getUrl() const;
+
+  /**
+   * @return The keep-alive sessions used to contact the node.
+   */
+  SessionPool& getSessionPool();
+
+public:
+  /**
+   * Weight of the last request in the moving averages.
+   */
+  static constexpr double Smoothing = 0.3;
+
+  /**
+   * Latency expected from a node never contacted.
+   */
+  static const std::chrono::microseconds PriorLatency;
+
+private:
+  /**
+   * Add a request to the statistics.
+   *
+   * @param latency Latency of the request, in microseconds.
+   * @param failed Whether the request failed or not.
+   */
+  void record(double latency, bool failed);
+
+private:
+  /**
+   * Url of the node.
+   */
+  std::string url_;
+
+  /**
+   * Keep-alive sessions.
+   */
+  SessionPool sessions_;
+
+  /**
+   * Latency accounted for a failed request, in microseconds: the request timeout.
+   */
+  double failureLatency_;
+
+  /**
+   * Moving average of the latency, in microseconds.
+   */
+  double latency_;
+
+  /**
+   * Whether the latency was measured at least once, or is still PriorLatency.
+   */
+  bool measured_;
+
+  /**
+   * Moving average of the error rate.
+   */
+  double errorRate_;
+
+  /**
+   * Requests in flight.
+   */
+  int inFlight_;
+
+  /**
+   * Protects the statistics.
+   */
+  mutable std::mutex mutex_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
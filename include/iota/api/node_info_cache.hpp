@@ -0,0 +1,179 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include <iota/api/responses/get_node_info.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Thread safe cache of the node info, used to get the latest milestone without a getNodeInfo
+ * request each time.
+ *
+ * The node info is fetched again once older than the ttl. Concurrent callers needing a fetch wait
+ * for a single request and share its response. An optional background refresh fetches the node
+ * info before it expires, so that callers never wait for it.
+ */
+class NodeInfoCache {
+public:
+  /**
+   * Sends the getNodeInfo request.
+   */
+  using Fetch = std::function<Responses::GetNodeInfo()>;
+
+public:
+  /**
+   * Ctor.
+   *
+   * @param ttl Time during which a node info is used, 0 disables caching.
+   */
+  explicit NodeInfoCache(const std::chrono::milliseconds& ttl = DefaultTtl);
+
+  /**
+   * Dtor: stops the background refresh.
+   */
+  ~NodeInfoCache();
+
+  NodeInfoCache(const NodeInfoCache&) = delete;
+  NodeInfoCache& operator=(const NodeInfoCache&) = delete;
+
+public:
+  /**
+   * Get the cached node info, fetching it if it expired.
+   * Exceptions thrown by the fetch are rethrown to every caller waiting for it.
+   *
+   * @param fetch Function sending the request, if the caller is the one fetching.
+   *
+   * @return The node info.
+   */
+  Responses::GetNodeInfo get(const Fetch& fetch);
+
+  /**
+   * Drop the cached node info: the next call fetches it again.
+   */
+  void invalidate();
+
+  /**
+   * Start fetching the node info in the background, twice per ttl. Failures are ignored: callers
+   * fetch the node info themselves once it expired.
+   *
+   * @param fetch Function sending the request, called from the refresh thread.
+   */
+  void startRefresh(const Fetch& fetch);
+
+  /**
+   * Stop the background refresh.
+   */
+  void stopRefresh();
+
+public:
+  /**
+   * @return Time during which a node info is used.
+   */
+  std::chrono::milliseconds getTtl() const;
+
+  /**
+   * @param ttl Time during which a node info is used, 0 disables caching.
+   */
+  void setTtl(const std::chrono::milliseconds& ttl);
+
+public:
+  /**
+   * Default time during which a node info is used: milestones are much less frequent.
+   */
+  static const std::chrono::milliseconds DefaultTtl;
+
+private:
+  /**
+   * Result of a single fetch, shared with the callers waiting for it.
+   */
+  struct Fetched {
+    std::shared_ptr<const Responses::GetNodeInfo> info;
+    std::exception_ptr                            error;
+    bool                                          done = false;
+  };
+
+  /**
+   * Fetch the node info and store it. Expects the mutex to be locked, which is released during the
+   * request.
+   *
+   * @param lock Lock of the mutex.
+   * @param fetch Function sending the request.
+   *
+   * @return The result of the fetch.
+   */
+  std::shared_ptr<const Fetched> fetch(std::unique_lock<std::mutex>& lock, const Fetch& fetch);
+
+  /**
+   * Refresh thread loop.
+   *
+   * @param fetch Function sending the request.
+   */
+  void refresh(Fetch fetch);
+
+private:
+  /**
+   * Protects the state below.
+   */
+  mutable std::mutex      mutex_;
+  std::condition_variable cv_;
+
+  /**
+   * Cached node info, null if none, and when it was received.
+   */
+  std::shared_ptr<const Responses::GetNodeInfo> info_;
+  std::chrono::steady_clock::time_point         updated_;
+
+  /**
+   * Result of the running fetch, null if none.
+   */
+  std::shared_ptr<Fetched> fetching_;
+
+  /**
+   * Time during which a node info is used.
+   */
+  std::chrono::milliseconds ttl_;
+
+  /**
+   * Refresh thread and its stop signal.
+   */
+  std::thread refresher_;
+  bool        stopping_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
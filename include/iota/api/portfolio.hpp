@@ -0,0 +1,202 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+#include <iota/api/account.hpp>
+#include <iota/api/responses/get_account_data.hpp>
+#include <iota/models/seed.hpp>
+#include <iota/models/transaction.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+class Extended;
+
+/**
+ * Set of accounts refreshed together.
+ *
+ * A refresh costs about the same number of requests whatever the number of accounts:
+ * - addresses of all accounts are derived in parallel, by windows of consecutive addresses
+ * - findTransactions, wereAddressesSpentFrom, getBalances and getInclusionStates requests are
+ *   merged across accounts
+ * - bundles shared by several accounts are fetched once
+ * Results are still returned per account.
+ *
+ * Transactions already known by one of the accounts are not fetched again: accounts of a portfolio
+ * should be refreshed through it rather than on their own.
+ */
+class Portfolio {
+public:
+  /**
+   * Ctor.
+   *
+   * @param api Api used to refresh the accounts, must outlive the portfolio.
+   */
+  explicit Portfolio(const Extended& api);
+
+  /**
+   * Default dtor.
+   */
+  ~Portfolio() = default;
+
+  Portfolio(const Portfolio&) = delete;
+  Portfolio& operator=(const Portfolio&) = delete;
+
+public:
+  /**
+   * Add an account, synced on the next refresh.
+   *
+   * @param seed Seed of the account.
+   *
+   * @return The account.
+   */
+  std::shared_ptr<Account> addAccount(const Models::Seed& seed);
+
+  /**
+   * @return Accounts, in the order they were added.
+   */
+  const std::vector<std::shared_ptr<Account>>& getAccounts() const;
+
+  /**
+   * Refresh all the accounts.
+   *
+   * @return State of each account, in the order they were added.
+   */
+  std::vector<Responses::GetAccountData> refresh();
+
+public:
+  /**
+   * @return Number of addresses derived at once when looking for new addresses.
+   */
+  std::size_t getDiscoveryWindow() const;
+
+  /**
+   * @param window Number of addresses derived at once when looking for new addresses.
+   */
+  void setDiscoveryWindow(std::size_t window);
+
+public:
+  /**
+   * Refresh accounts sharing the same api.
+   *
+   * @param api Api used to refresh the accounts.
+   * @param accounts Accounts to refresh.
+   * @param discoveryWindow Number of addresses derived at once when looking for new addresses.
+   *
+   * @return State of each account, in the order of the accounts.
+   */
+  static std::vector<Responses::GetAccountData> sync(
+      const Extended& api, const std::vector<Account*>& accounts,
+      std::size_t discoveryWindow = DefaultDiscoveryWindow);
+
+public:
+  /**
+   * Default number of addresses derived at once when looking for new addresses.
+   */
+  static const std::size_t DefaultDiscoveryWindow = 10;
+
+private:
+  /**
+   * State of an account during a sync.
+   */
+  struct Sync {
+    //! the account
+    Account* account;
+
+    //! whether addresses following the known ones must be looked for
+    bool discover;
+
+    //! addresses whose balance may have changed
+    std::unordered_set<Types::Trytes> touched;
+  };
+
+  //! transactions fetched during a sync, by hash
+  using Transactions = std::unordered_map<Types::Trytes, Models::Transaction>;
+
+  //! indexes of the accounts owning each address
+  using Owners = std::unordered_map<Types::Trytes, std::vector<std::size_t>>;
+
+  /**
+   * Update the inclusion states of the bundles not confirmed yet, in one request.
+   */
+  static void updateInclusionStates(const Extended& api, std::vector<Sync>& syncs);
+
+  /**
+   * Fetch the transactions of the known addresses that no account knows yet.
+   */
+  static void scanAddresses(const Extended& api, std::vector<Sync>& syncs, const Owners& owners,
+                            Transactions& fetched);
+
+  /**
+   * Look for the addresses following the known ones, up to the first unused one.
+   */
+  static void discoverAddresses(const Extended& api, std::vector<Sync>& syncs, Owners& owners,
+                                Transactions& fetched, std::size_t window);
+
+  /**
+   * Build the bundles of the fetched transactions and give them to the accounts involved.
+   */
+  static void updateBundles(const Extended& api, std::vector<Sync>& syncs, const Owners& owners,
+                            const Transactions& fetched);
+
+  /**
+   * Get the balances of the touched addresses, in one request.
+   */
+  static void updateBalances(const Extended& api, std::vector<Sync>& syncs);
+
+  /**
+   * Get the transactions that were not fetched yet.
+   */
+  static void fetch(const Extended& api, const std::vector<Types::Trytes>& hashes,
+                    Transactions& fetched);
+
+private:
+  /**
+   * Api used to refresh the accounts.
+   */
+  const Extended& api_;
+
+  /**
+   * Accounts, in the order they were added.
+   */
+  std::vector<std::shared_ptr<Account>> accounts_;
+
+  /**
+   * Number of addresses derived at once when looking for new addresses.
+   */
+  std::size_t discoveryWindow_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,329 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include <iota/models/transfer.hpp>
+#include <iota/types/trytes.hpp>
+#include <iota/utils/worker_pool.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+class Extended;
+
+/**
+ * Keeps many pending bundles moving until they are confirmed, from a single thread.
+ *
+ * Tracked bundles are scheduled on a timer wheel. On each tick, the bundles which are due are
+ * checked for inclusion with a single request. Confirmed bundles are reported and dropped. The
+ * latest tails of the others are checked for consistency at once (see Extended::isPromotable), and
+ * each bundle is then promoted if consistent, or reattached otherwise, before being scheduled again
+ * after the promotion interval. Each tail of a reattached bundle is still checked for inclusion.
+ *
+ * Promotions and reattachments run on a pool whose size is the number of PoW done at once, shared
+ * by all the bundles. Outcomes are reported through callbacks, which are
+ * called from the threads of the promoter.
+ *
+ * The wheel is either driven by the promoter thread (see start), or by calling tick.
+ */
+class Promoter {
+public:
+  /**
+   * Outcome of a step for a bundle.
+   */
+  enum class Event {
+    //! one of the tails of the bundle is confirmed: the bundle is no longer tracked
+    Confirmed,
+    //! the latest tail of the bundle got promoted
+    Promoted,
+    //! the bundle was inconsistent and got reattached
+    Reattached,
+    //! the step failed, the bundle is tried again later
+    Failed
+  };
+
+  /**
+   * Outcome callback.
+   *
+   * @param tail Tail the bundle is tracked with.
+   * @param event What happened.
+   * @param trx Tail of the confirmed bundle, of the promotion or of the reattachment, empty on
+   * failures.
+   * @param error The failure, if any.
+   */
+  using Callback = std::function<void(const Types::Trytes& tail, Event event,
+                                      const Types::Trytes& trx, std::exception_ptr error)>;
+
+public:
+  /**
+   * Ctor.
+   *
+   * @param api Api used to check, promote and reattach bundles, must outlive the promoter.
+   * @param depth The depth used for promotions and reattachments.
+   * @param minWeightMagnitude The minimum weight magnitude used for promotions and reattachments.
+   */
+  Promoter(const Extended& api, int depth, int minWeightMagnitude);
+
+  /**
+   * Dtor: stops the promoter thread.
+   */
+  ~Promoter();
+
+  Promoter(const Promoter&) = delete;
+  Promoter& operator=(const Promoter&) = delete;
+
+public:
+  /**
+   * Track a bundle, handled on the next tick.
+   * Tracking an already tracked tail does nothing.
+   *
+   * @param tail Tail transaction of the bundle.
+   * @param callback Called with the outcome of each step.
+   */
+  void track(const Types::Trytes& tail, const Callback& callback);
+
+  /**
+   * Stop tracking a bundle. A step already running for it still reports its outcome.
+   *
+   * @param tail Tail the bundle is tracked with.
+   *
+   * @return Whether the bundle was tracked.
+   */
+  bool untrack(const Types::Trytes& tail);
+
+  /**
+   * @return Number of tracked bundles.
+   */
+  std::size_t size() const;
+
+public:
+  /**
+   * Start the promoter thread, ticking the wheel every resolution.
+   */
+  void start();
+
+  /**
+   * Stop the promoter thread, waiting for the current tick to be done.
+   */
+  void stop();
+
+  /**
+   * Advance the wheel by one tick and handle the bundles which are due.
+   * Returns once all of them are handled.
+   */
+  void tick();
+
+public:
+  /**
+   * @return Delay between two steps of a bundle.
+   */
+  std::chrono::milliseconds getInterval() const;
+
+  /**
+   * @param interval Delay between two steps of a bundle, rounded up to a number of ticks.
+   */
+  void setInterval(const std::chrono::milliseconds& interval);
+
+  /**
+   * @return Duration of a tick of the wheel.
+   */
+  std::chrono::milliseconds getResolution() const;
+
+  /**
+   * Set the duration of a tick of the wheel.
+   * Throws an IllegalState exception if the promoter thread is running.
+   *
+   * @param resolution Duration of a tick, not null.
+   */
+  void setResolution(const std::chrono::milliseconds& resolution);
+
+  /**
+   * @return Number of promotions and reattachments run at once.
+   */
+  std::size_t getPowCapacity() const;
+
+  /**
+   * Set the number of promotions and reattachments run at once.
+   * Throws an IllegalState exception once the first bundles were handled.
+   *
+   * @param capacity Number of promotions and reattachments run at once, at least one.
+   */
+  void setPowCapacity(std::size_t capacity);
+
+  /**
+   * @return Zero-value transfer sent to promote bundles.
+   */
+  Models::Transfer getPromotionTransfer() const;
+
+  /**
+   * @param transfer Zero-value transfer sent to promote bundles.
+   */
+  void setPromotionTransfer(const Models::Transfer& transfer);
+
+public:
+  /**
+   * Default delay between two steps of a bundle.
+   */
+  static const std::chrono::milliseconds DefaultInterval;
+
+  /**
+   * Default duration of a tick of the wheel.
+   */
+  static const std::chrono::milliseconds DefaultResolution;
+
+  /**
+   * Default number of promotions and reattachments run at once.
+   */
+  static const std::size_t DefaultPowCapacity = 2;
+
+  /**
+   * Number of slots of the wheel.
+   */
+  static const std::size_t WheelSize = 64;
+
+private:
+  /**
+   * A tracked bundle.
+   */
+  struct Entry {
+    //! tail the bundle is tracked with, followed by the tails of its reattachments
+    std::vector<Types::Trytes> tails;
+
+    //! outcome callback
+    Callback callback;
+
+    //! tick at which the next step is due
+    std::size_t due;
+
+    //! whether the bundle is still tracked
+    bool tracked;
+  };
+
+  /**
+   * Run a step for a bundle which is not confirmed: promote or reattach its latest tail.
+   *
+   * @param entry The bundle.
+   * @param promotable Whether its latest tail is promotable.
+   */
+  void step(Entry& entry, bool promotable);
+
+  /**
+   * Report a failure for bundles and schedule their next step.
+   *
+   * @param entries The bundles.
+   * @param error The failure.
+   */
+  void fail(const std::vector<std::shared_ptr<Entry>>& entries, const std::exception_ptr& error);
+
+  /**
+   * Schedule the next step of a bundle. Expects the mutex to be locked.
+   *
+   * @param entry The bundle.
+   * @param ticks Number of ticks from now.
+   */
+  void schedule(const std::shared_ptr<Entry>& entry, std::size_t ticks);
+
+  /**
+   * @return Number of ticks between two steps of a bundle. Expects the mutex to be locked.
+   */
+  std::size_t getIntervalTicks() const;
+
+  /**
+   * Promoter thread loop.
+   */
+  void run();
+
+private:
+  /**
+   * Api used to check, promote and reattach bundles.
+   */
+  const Extended& api_;
+
+  /**
+   * Depth and minimum weight magnitude for promotions and reattachments.
+   */
+  int depth_;
+  int minWeightMagnitude_;
+
+  /**
+   * Protects the state below.
+   */
+  mutable std::mutex mutex_;
+
+  /**
+   * Tracked bundles, by tail they are tracked with.
+   */
+  std::unordered_map<Types::Trytes, std::shared_ptr<Entry>> entries_;
+
+  /**
+   * Bundles scheduled in each slot of the wheel.
+   */
+  std::vector<std::vector<std::shared_ptr<Entry>>> wheel_;
+
+  /**
+   * Current tick.
+   */
+  std::size_t now_;
+
+  /**
+   * Settings.
+   */
+  std::chrono::milliseconds interval_;
+  std::chrono::milliseconds resolution_;
+  Models::Transfer          promotionTransfer_;
+
+  /**
+   * Runs the promotions and reattachments.
+   */
+  Utils::WorkerPool pool_;
+
+  /**
+   * Serializes ticks.
+   */
+  std::mutex tickMutex_;
+
+  /**
+   * Promoter thread and its stop signal.
+   */
+  std::thread             thread_;
+  std::condition_variable cv_;
+  bool                    stopping_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
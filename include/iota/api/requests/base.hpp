@@ -25,8 +25,12 @@
 
 #pragma once
 
+#include <string>
+
 #include <json_fwd.hpp>
 
+#include <iota/utils/json_writer.hpp>
+
 using json = nlohmann::json;
 
 namespace IOTA {
@@ -60,6 +64,19 @@ public:
    */
   virtual void serialize(json& data) const;
 
+  /**
+   * Serialize object, without building a json document.
+   * Big requests are much cheaper to serialize this way.
+   *
+   * @param writer where to write the fields of the request, inside an opened object.
+   */
+  virtual void serialize(Utils::JsonWriter& writer) const;
+
+  /**
+   * @return The command name.
+   */
+  const std::string& getCommand() const;
+
 private:
   /**
    * The command name.
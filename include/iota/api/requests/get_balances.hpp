@@ -69,6 +69,13 @@ public:
    */
   void serialize(json& data) const override;
 
+  /**
+   * Serialize object, without building a json document.
+   *
+   * @param writer where to write the fields of the request.
+   */
+  void serialize(Utils::JsonWriter& writer) const override;
+
 private:
   /**
    * List of addresses you want to get the confirmed balance from.
@@ -29,6 +29,8 @@
 
 #include <json_fwd.hpp>
 
+#include <iota/utils/json_fields_handler.hpp>
+
 using json = nlohmann::json;
 
 namespace IOTA {
@@ -69,6 +71,14 @@ public:
    */
   virtual void deserialize(const json& res);
 
+  /**
+   * Bind the fields of the response, so that it is filled while the reply is being parsed,
+   * without building a json document first.
+   *
+   * @param handler Handler receiving the fields of the reply.
+   */
+  virtual void bind(Utils::JsonFieldsHandler& handler);
+
 public:
   /**
    * @return duration of operation
@@ -41,6 +41,7 @@ class GetBalances;
 class GetBalancesAndFormat;
 class GetBundle;
 class GetInclusionStates;
+class GetInputsSnapshot;
 class GetNeighbors;
 class GetNewAddresses;
 class GetNodeInfo;
@@ -50,6 +51,7 @@ class GetTransfers;
 class GetTrytes;
 class RemoveNeighbors;
 class ReplayBundle;
+class SelectInputs;
 class SendTransfer;
 class WereAddressesSpentFrom;
 
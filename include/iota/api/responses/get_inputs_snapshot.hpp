@@ -0,0 +1,110 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <iota/api/responses/base.hpp>
+#include <iota/models/address.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+namespace Responses {
+
+/**
+ * GetInputsSnapshot API call response.
+ *
+ * Balances of all the funded addresses of a seed, read with a single getBalances call. The
+ * references and milestone index of that call are kept as a proof of the balances, so that inputs
+ * selected from the snapshot do not need to be checked again.
+ */
+class GetInputsSnapshot : public Base {
+public:
+  /**
+   * Default ctor.
+   */
+  GetInputsSnapshot() = default;
+
+  /**
+   * Full init ctor.
+   *
+   * @param inputs Funded addresses, with their balance, by key index.
+   * @param totalBalance The total balance.
+   * @param remainderAddress First address neither used nor spent from, empty if unknown.
+   * @param references Tips or milestone the balances were computed from.
+   * @param milestoneIndex Index of the milestone the balances were computed from.
+   * @param duration Request duration.
+   */
+  GetInputsSnapshot(const std::vector<Models::Address>& inputs, const int64_t& totalBalance,
+                    const Models::Address&            remainderAddress,
+                    const std::vector<Types::Trytes>& references, const int64_t& milestoneIndex,
+                    const int64_t& duration);
+
+  /**
+   * Default dtor.
+   */
+  ~GetInputsSnapshot() = default;
+
+public:
+  /**
+   * @return Funded addresses, with their balance, by key index.
+   */
+  const std::vector<Models::Address>& getInputs() const;
+
+  /**
+   * @return Total balance.
+   */
+  const int64_t& getTotalBalance() const;
+
+  /**
+   * @return First address neither used nor spent from, empty if unknown.
+   */
+  const Models::Address& getRemainderAddress() const;
+
+  /**
+   * @return Tips or milestone the balances were computed from.
+   */
+  const std::vector<Types::Trytes>& getReferences() const;
+
+  /**
+   * @return Index of the milestone the balances were computed from.
+   */
+  const int64_t& getMilestoneIndex() const;
+
+private:
+  std::vector<Models::Address> inputs_;
+  int64_t                      totalBalance_ = 0;
+  Models::Address              remainderAddress_;
+  std::vector<Types::Trytes>   references_;
+  int64_t                      milestoneIndex_ = 0;
+};
+
+}  // namespace Responses
+
+}  // namespace API
+
+}  // namespace IOTA
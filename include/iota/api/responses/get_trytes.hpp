@@ -71,6 +71,13 @@ public:
    */
   void deserialize(const json& res) override;
 
+  /**
+   * Bind the fields of the response, so that it is filled while the reply is being parsed.
+   *
+   * @param handler Handler receiving the fields of the reply.
+   */
+  void bind(Utils::JsonFieldsHandler& handler) override;
+
 public:
   /**
    * @return trytes.
@@ -0,0 +1,89 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <iota/api/responses/get_inputs_snapshot.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+namespace Responses {
+
+/**
+ * SelectInputs API call response.
+ *
+ * Inputs selected from a GetInputsSnapshot to send a given value, along with the proof of their
+ * balances: the selection can be given as is to prepareTransfers.
+ */
+class SelectInputs : public GetInputsSnapshot {
+public:
+  /**
+   * Default ctor.
+   */
+  SelectInputs() = default;
+
+  /**
+   * Full init ctor.
+   *
+   * @param inputs Selected addresses, with their balance, by key index.
+   * @param totalBalance The total balance of the selected addresses.
+   * @param value Value to send.
+   * @param remainderAddress First address neither used nor spent from, empty if unknown.
+   * @param references Tips or milestone the balances were computed from.
+   * @param milestoneIndex Index of the milestone the balances were computed from.
+   * @param duration Request duration.
+   */
+  SelectInputs(const std::vector<Models::Address>& inputs, const int64_t& totalBalance,
+               const int64_t& value, const Models::Address& remainderAddress,
+               const std::vector<Types::Trytes>& references, const int64_t& milestoneIndex,
+               const int64_t& duration);
+
+  /**
+   * Default dtor.
+   */
+  ~SelectInputs() = default;
+
+public:
+  /**
+   * @return Value to send.
+   */
+  const int64_t& getValue() const;
+
+  /**
+   * @return Value left over by the selected inputs, sent to the remainder address.
+   */
+  int64_t getRemainder() const;
+
+private:
+  int64_t value_ = 0;
+};
+
+}  // namespace Responses
+
+}  // namespace API
+
+}  // namespace IOTA
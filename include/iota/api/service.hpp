@@ -25,16 +25,26 @@
 
 #pragma once
 
+#include <chrono>
+#include <memory>
+#include <vector>
+
 #include <cpr/cpr.h>
 #include <cpr/auth.h>
 #include <json.hpp>
 
+#include <iota/api/node.hpp>
+#include <iota/api/requests/base.hpp>
+#include <iota/api/service_metrics.hpp>
 #include <iota/constants.hpp>
 #include <iota/errors/bad_request.hpp>
 #include <iota/errors/internal_server_error.hpp>
 #include <iota/errors/network.hpp>
 #include <iota/errors/unauthorized.hpp>
 #include <iota/errors/unrecognized.hpp>
+#include <iota/utils/json_fields_handler.hpp>
+#include <iota/utils/json_stream_parser.hpp>
+#include <iota/utils/worker_pool.hpp>
 
 using json = nlohmann::json;
 
@@ -43,7 +53,13 @@ namespace IOTA {
 namespace API {
 
 /**
- * Service to contact a IOTA node.
+ * Service to contact a IOTA node, or a set of equivalent nodes.
+ *
+ * With several nodes, each request is sent to the best of two randomly picked nodes, according to
+ * their measured latency, load and error rate. Idempotent requests (reads) are retried on another
+ * node when a node cannot be reached, times out or is unavailable, and can be hedged: if a reply
+ * takes longer than the hedge delay, the request is also sent to another node and the first
+ * successful reply is used.
  */
 class Service {
 public:
@@ -55,6 +71,18 @@ public:
    * @param timeout Request timeout.
    */
   Service(const std::string& host, const uint16_t& port, int timeout = 60, const std::string& user = "", const std::string& pass = "");
+
+  /**
+   * Multi-node ctor.
+   *
+   * @param nodes Hosts and ports of the nodes, at least one.
+   * @param timeout Request timeout.
+   * @param user Username for authenticated requests.
+   * @param pass Password for authenticated requests.
+   */
+  explicit Service(const std::vector<Endpoint>& nodes, int timeout = 60,
+                   const std::string& user = "", const std::string& pass = "");
+
   /**
    * Default dtor;
    */
@@ -70,84 +98,330 @@ public:
    */
   template <typename Request, typename Response, typename... Args>
   Response request(Args&&... args) const {
-    auto request = Request{ args... };
+    auto     request = Request{ args... };
+    Response response;
 
-    json data;
-    request.serialize(data);
-
-    auto url     = cpr::Url{ host_ + ":" + std::to_string(port_) };
-    auto body    = cpr::Body{ data.dump() };
-    auto headers = cpr::Header{ { "Content-Type", "application/json" },
-                                { "Content-Length", std::to_string(body.size()) },
-                                { "X-IOTA-API-Version", APIVersion } };
-    cpr::Response res;
-    if(!user_.empty() && !pass_.empty() && host_.compare(0,5,"https") == 0){
-      res = cpr::Post(url, body, headers, cpr::Timeout{ timeout_ * 1000 }, cpr::Authentication{user_, pass_});
-    }
-    else
-      res = cpr::Post(url, body, headers, cpr::Timeout{ timeout_ * 1000 });
-    if (res.error.code != cpr::ErrorCode::OK)
-      throw Errors::Network(res.error.message);
+    exchange(request, [&](const cpr::Response& res) {
+      auto resJson = parse(res);
 
-    json        resJson;
-    std::string error;
+      if (res.status_code != 200) {
+        throwError(res, resJson);
+      }
 
-    try {
-      resJson = json::parse(res.text);
+      response = Response{ resJson };
+    });
 
-      if (resJson.count("error")) {
-        error = resJson["error"].get<decltype(error)>();
-      }
-    } catch (const std::runtime_error&) {
-      if (res.elapsed >= timeout_) {
-        throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
+    return response;
+  }
+
+  /**
+   * Request to the node, the response is streamed to the given handler while being parsed instead
+   * of being deserialized in a response object.
+   *
+   * @param handler Handler receiving the json events of the response.
+   * @param args The request parameters.
+   */
+  template <typename Request, typename... Args>
+  void stream(Utils::JsonStreamParser::Handler& handler, Args&&... args) const {
+    auto request = Request{ args... };
+
+    exchange(request, [&](const cpr::Response& res) {
+      if (res.status_code != 200) {
+        throwError(res, parse(res));
       }
 
-      throw Errors::Unrecognized("Invalid reply from node (unrecognized format): " + res.text);
-    }
+      parse(res, handler);
+    });
+  }
 
-    Response response;
-    switch (res.status_code) {
-      case 200:
-        return Response{ resJson };
-      case 400:
-        throw Errors::BadRequest(error);
-      case 401:
-        throw Errors::Unauthorized(error);
-      case 500:
-        throw Errors::InternalServerError(error);
-      default:
-        if (res.elapsed >= timeout_) {
-          throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
-        }
-
-        throw Errors::Unrecognized(error);
-    }
+  /**
+   * Request to the node, the response object is filled while the reply is being parsed, without
+   * building a json document first. Much cheaper than request() for big replies.
+   *
+   * @param args The request parameters.
+   *
+   * @return The request response.
+   */
+  template <typename Request, typename Response, typename... Args>
+  Response requestStreamed(Args&&... args) const {
+    Response                 response;
+    Utils::JsonFieldsHandler handler;
+
+    response.bind(handler);
+    stream<Request>(handler, args...);
 
     return response;
   }
 
+  /**
+   * Run a task, typically making requests, on the workers of the service.
+   * The task must not refer to objects that may be destroyed before it is run: capture by value.
+   *
+   * @param fn The task.
+   *
+   * @return Future set with the result of the task, or the exception it threw.
+   */
+  template <typename F>
+  std::future<typename std::result_of<F()>::type> async(F fn) const {
+    return workers_->submit(std::move(fn));
+  }
+
+public:
+  /**
+   * Nodes contacted by the service, along with their sessions and statistics.
+   * Shared by the copies of this service.
+   *
+   * @return The nodes.
+   */
+  const std::vector<std::shared_ptr<Node>>& getNodes() const;
+
+  /**
+   * @return Maximum number of nodes an idempotent request is sent to.
+   */
+  std::size_t getMaxAttempts() const;
+
+  /**
+   * @param maxAttempts Maximum number of nodes an idempotent request is sent to, including
+   * hedged requests. 1 disables retries.
+   */
+  void setMaxAttempts(std::size_t maxAttempts);
+
+  /**
+   * @return Delay after which an idempotent request is also sent to another node.
+   */
+  std::chrono::milliseconds getHedgeDelay() const;
+
+  /**
+   * Hedged requests trade a few duplicate requests for a lower tail latency. Requests are then run
+   * on the hedge worker pool, so that the first reply can be used while the other is still pending.
+   *
+   * @param hedgeDelay Delay after which an idempotent request is also sent to another node, 0
+   * disables hedging.
+   */
+  void setHedgeDelay(const std::chrono::milliseconds& hedgeDelay);
+
+public:
+  /**
+   * Latency, size, retries and errors of the requests, per api command.
+   * Shared by the copies of this service.
+   *
+   * @return The metrics.
+   */
+  ServiceMetrics& getMetrics() const;
+
+  /**
+   * @return Whether compressed replies are accepted.
+   */
+  bool getAcceptCompression() const;
+
+  /**
+   * Let the nodes compress their replies (gzip or deflate) if they support it. Enabled by default
+   * when the library is built with zlib, otherwise enabling it throws an IllegalState exception.
+   * Replies made of trytes typically shrink by half or more.
+   * Replies inflating to more than Utils::DefaultMaxInflatedSize are rejected as network errors.
+   *
+   * @param accept Whether compressed replies are accepted.
+   */
+  void setAcceptCompression(bool accept);
+
+  /**
+   * @return Size above which request bodies are compressed, 0 if disabled.
+   */
+  std::size_t getCompressRequestsAbove() const;
+
+  /**
+   * Compress the bodies of big requests (storeTransactions, attachToTangle...) with gzip.
+   * Only enable it for nodes, or proxies in front of them, that accept compressed requests.
+   * Throws an IllegalState exception if the library is built without zlib.
+   *
+   * @param size Size above which request bodies are compressed, 0 disables compression.
+   */
+  void setCompressRequestsAbove(std::size_t size);
+
+public:
+  /**
+   * Default maximum number of nodes an idempotent request is sent to.
+   */
+  static const std::size_t DefaultMaxAttempts = 3;
+
+  /**
+   * Default number of threads sending the hedged requests.
+   */
+  static const std::size_t DefaultHedgeWorkers = 32;
+
+  /**
+   * Threads running the asynchronous requests, shared by the copies of this service.
+   * Their number bounds the number of asynchronous requests in flight.
+   *
+   * @return The worker pool.
+   */
+  Utils::WorkerPool& getWorkerPool() const;
+
+  /**
+   * Threads sending the hedged requests, shared by the copies of this service.
+   * Their number bounds the number of hedged requests in flight, further ones wait for a thread.
+   * Requests still in flight when the last copy of the service is destroyed are waited for.
+   *
+   * @return The worker pool.
+   */
+  Utils::WorkerPool& getHedgeWorkerPool() const;
+
 private:
   /**
-   * Host of the node.
+   * Send a request and handle its reply, recording the metrics of the exchange.
+   *
+   * @param request The request.
+   * @param handle Parses the raw response, throws on error.
+   */
+  template <typename F>
+  void exchange(const Requests::Base& request, F handle) const {
+    ServiceMetrics::Sample sample;
+    sample.command = request.getCommand();
+
+    try {
+      auto res   = send(request, sample);
+      auto start = std::chrono::steady_clock::now();
+
+      handle(res);
+      sample.parseTime += std::chrono::duration_cast<std::chrono::microseconds>(
+          std::chrono::steady_clock::now() - start);
+    } catch (...) {
+      sample.error = ServiceMetrics::classify(std::current_exception());
+      metrics_->record(sample);
+      throw;
+    }
+
+    metrics_->record(sample);
+  }
+
+  /**
+   * Serialize a request and send it, measuring the serialization and network phases.
+   * Bodies are compressed and decompressed according to the compression settings.
+   *
+   * @param request The request.
+   * @param sample Updated with the measures.
+   *
+   * @return The raw response.
+   */
+  cpr::Response send(const Requests::Base& request, ServiceMetrics::Sample& sample) const;
+
+  /**
+   * Send the given body to a node, retrying or hedging idempotent requests on other nodes.
+   * Throws a Network exception if no node could be reached.
+   *
+   * @param body The serialized request.
+   * @param headers Additional headers.
+   * @param idempotent Whether the request can be sent to several nodes.
+   * @param attempts Set with the number of nodes the request was sent to.
+   *
+   * @return The raw response.
+   */
+  cpr::Response post(const std::string& body, const cpr::Header& headers, bool idempotent,
+                     std::size_t& attempts) const;
+
+  /**
+   * Send the given body to a node, and to another one if no reply came within the hedge delay.
+   *
+   * @param node The node to send the request to first.
+   * @param body The serialized request.
+   * @param headers Additional headers.
+   * @param tried Nodes already used for this request, updated with the hedge node.
+   *
+   * @return The first successful raw response.
+   */
+  cpr::Response hedge(const std::shared_ptr<Node>& node, const std::string& body,
+                      const cpr::Header& headers, std::vector<std::shared_ptr<Node>>& tried) const;
+
+  /**
+   * Pick the node to send a request to: the best of two random nodes (power of two choices).
+   *
+   * @param tried Nodes not to pick.
+   *
+   * @return The node, null if all nodes were tried.
+   */
+  std::shared_ptr<Node> pick(const std::vector<std::shared_ptr<Node>>& tried) const;
+
+  /**
+   * Serialize a request, without building a json document first.
+   *
+   * @param request The request.
+   *
+   * @return The body of the request.
+   */
+  static std::string serialize(const Requests::Base& request);
+
+  /**
+   * @param command The command of the request.
+   *
+   * @return Whether the request only reads data, and can safely be sent to several nodes.
+   */
+  static bool isIdempotent(const std::string& command);
+
+  /**
+   * Parse the body of a response.
+   * Throws a Network exception on time out, or an Unrecognized exception for invalid json.
+   *
+   * @param res The raw response.
+   *
+   * @return The parsed body.
+   */
+  json parse(const cpr::Response& res) const;
+
+  /**
+   * Stream the body of a response to the given handler.
+   * Throws a Network exception on time out, or an Unrecognized exception for invalid json.
+   *
+   * @param res The raw response.
+   * @param handler Handler receiving the json events.
+   */
+  void parse(const cpr::Response& res, Utils::JsonStreamParser::Handler& handler) const;
+
+  /**
+   * Throw the exception corresponding to an error response.
+   *
+   * @param res The raw response.
+   * @param resJson The parsed body.
    */
-  std::string host_;
+  [[noreturn]] void throwError(const cpr::Response& res, const json& resJson) const;
+
+private:
   /**
-   * Port of the node.
+   * Nodes to contact, shared by copies.
    */
-  unsigned int port_;
+  std::vector<std::shared_ptr<Node>> nodes_;
   /**
    * Timeout for requests.
    */
   const int timeout_;
   /**
-   * Username for authenticated requests.
+   * Maximum number of nodes an idempotent request is sent to.
+   */
+  std::size_t maxAttempts_;
+  /**
+   * Delay after which idempotent requests are hedged, 0 to disable.
+   */
+  std::chrono::milliseconds hedgeDelay_;
+  /**
+   * Whether compressed replies are accepted.
+   */
+  bool acceptCompression_;
+  /**
+   * Size above which request bodies are compressed, 0 if disabled.
+   */
+  std::size_t compressRequestsAbove_;
+  /**
+   * Threads running the asynchronous requests.
+   */
+  std::shared_ptr<Utils::WorkerPool> workers_;
+  /**
+   * Threads sending the hedged requests. Separate from the asynchronous requests workers, so that
+   * a hedged request made from an asynchronous one never waits for a thread it is holding.
    */
-  std::string user_;
+  std::shared_ptr<Utils::WorkerPool> hedgeWorkers_;
   /**
-   * Password for authenticated requests.
+   * Metrics of the requests, shared by copies.
    */
-  std::string pass_;
+  std::shared_ptr<ServiceMetrics> metrics_;
 };
 
 }  // namespace API
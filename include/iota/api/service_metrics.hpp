@@ -0,0 +1,178 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Metrics of the requests sent by a Service, aggregated per api command.
+ *
+ * The latency of a request is split between the serialization of the request, the network
+ * (including the node processing time and the retries) and the parsing of the reply, so that slow
+ * calls can be attributed to the client, the network or the node.
+ * Thread safe.
+ */
+class ServiceMetrics {
+public:
+  /**
+   * Measures of a single request.
+   */
+  struct Sample {
+    //! api command
+    std::string command;
+    //! time spent serializing the request
+    std::chrono::microseconds serializeTime{ 0 };
+    //! time spent waiting for the node, including retries
+    std::chrono::microseconds networkTime{ 0 };
+    //! time spent parsing the reply
+    std::chrono::microseconds parseTime{ 0 };
+    //! size of the request body
+    std::size_t requestBytes = 0;
+    //! size of the reply body
+    std::size_t responseBytes = 0;
+    //! number of nodes the request was sent to
+    std::size_t attempts = 0;
+    //! class of the error (see classify), empty on success
+    std::string error;
+
+    /**
+     * @return Total time spent on the request.
+     */
+    std::chrono::microseconds getLatency() const;
+  };
+
+  /**
+   * Aggregated measures of an api command.
+   */
+  struct Command {
+    //! number of requests
+    uint64_t requests = 0;
+    //! number of additional attempts on other nodes
+    uint64_t retries = 0;
+    //! total size of the request bodies
+    uint64_t requestBytes = 0;
+    //! total size of the reply bodies
+    uint64_t responseBytes = 0;
+    //! total time spent in each phase
+    std::chrono::microseconds serializeTime{ 0 };
+    std::chrono::microseconds networkTime{ 0 };
+    std::chrono::microseconds parseTime{ 0 };
+    //! number of requests per latency bucket (see getLatencyBounds), the last one is unbounded
+    std::vector<uint64_t> latencyBuckets;
+    //! number of failed requests per error class
+    std::map<std::string, uint64_t> errors;
+  };
+
+  /**
+   * Called with each sample, to export them to another metrics system.
+   */
+  using Callback = std::function<void(const Sample&)>;
+
+public:
+  /**
+   * Default ctor.
+   */
+  ServiceMetrics() = default;
+
+  /**
+   * Default dtor.
+   */
+  ~ServiceMetrics() = default;
+
+public:
+  /**
+   * Aggregate a sample, and pass it to the callback if any.
+   *
+   * @param sample Measures of a request.
+   */
+  void record(const Sample& sample);
+
+  /**
+   * @return Aggregated measures, by api command.
+   */
+  std::map<std::string, Command> getCommands() const;
+
+  /**
+   * @param callback Called with each sample, from the thread that made the request. Null to
+   * remove it.
+   */
+  void setCallback(const Callback& callback);
+
+  /**
+   * Drop the aggregated measures.
+   */
+  void reset();
+
+  /**
+   * @return The aggregated measures, in the Prometheus text exposition format.
+   */
+  std::string toPrometheus() const;
+
+public:
+  /**
+   * @return Upper bounds of the latency buckets.
+   */
+  static const std::vector<std::chrono::microseconds>& getLatencyBounds();
+
+  /**
+   * @param error An exception thrown by a request.
+   *
+   * @return Class of the error: network, bad_request, unauthorized, internal_server_error,
+   * unrecognized or other.
+   */
+  static std::string classify(const std::exception_ptr& error);
+
+private:
+  /**
+   * Protects the measures and the callback.
+   */
+  mutable std::mutex mutex_;
+
+  /**
+   * Aggregated measures.
+   */
+  std::map<std::string, Command> commands_;
+
+  /**
+   * Optional export callback.
+   */
+  Callback callback_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,222 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+#include <cpr/cpr.h>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Pool of reusable http sessions.
+ * Each session keeps its underlying connection alive between requests, which saves the tcp (and
+ * tls) handshake on subsequent calls to the same node.
+ * Sessions are created on demand: the pool only bounds the number of idle sessions it keeps.
+ * Thread safe.
+ */
+class SessionPool {
+public:
+  /**
+   * Creates a new session, configured for the node.
+   */
+  using Factory = std::function<std::unique_ptr<cpr::Session>()>;
+
+  /**
+   * Session borrowed from the pool, given back when destroyed.
+   */
+  class Lease {
+  public:
+    /**
+     * Ctor.
+     *
+     * @param pool The pool the session is borrowed from.
+     * @param session The borrowed session.
+     */
+    Lease(SessionPool* pool, std::unique_ptr<cpr::Session> session);
+
+    /**
+     * Dtor: gives the session back to the pool, unless discarded.
+     */
+    ~Lease();
+
+    Lease(Lease&& rhs);
+    Lease(const Lease&) = delete;
+    Lease& operator=(const Lease&) = delete;
+
+  public:
+    /**
+     * @return The borrowed session.
+     */
+    cpr::Session& operator*() const;
+
+    /**
+     * @return The borrowed session.
+     */
+    cpr::Session* operator->() const;
+
+    /**
+     * Drop the session instead of giving it back to the pool, for example after a network error.
+     */
+    void discard();
+
+  private:
+    /**
+     * The pool the session is borrowed from.
+     */
+    SessionPool* pool_;
+
+    /**
+     * The borrowed session.
+     */
+    std::unique_ptr<cpr::Session> session_;
+  };
+
+public:
+  /**
+   * Ctor.
+   *
+   * @param factory Function creating new sessions.
+   * @param maxIdle Maximum number of idle sessions kept by the pool.
+   * @param idleTimeout Idle sessions unused for longer than this are closed.
+   */
+  explicit SessionPool(const Factory& factory, std::size_t maxIdle = DefaultMaxIdle,
+                       const std::chrono::seconds& idleTimeout = DefaultIdleTimeout);
+
+  /**
+   * Default dtor.
+   */
+  ~SessionPool() = default;
+
+public:
+  /**
+   * Borrow a session: the most recently used idle session if any, a new one otherwise.
+   *
+   * @return The borrowed session.
+   */
+  Lease acquire();
+
+  /**
+   * @return The number of idle sessions currently kept by the pool.
+   */
+  std::size_t idleCount() const;
+
+  /**
+   * Close all idle sessions.
+   */
+  void clear();
+
+public:
+  /**
+   * @return Maximum number of idle sessions kept by the pool.
+   */
+  std::size_t getMaxIdle() const;
+
+  /**
+   * @param maxIdle Maximum number of idle sessions kept by the pool. 0 disables pooling.
+   */
+  void setMaxIdle(std::size_t maxIdle);
+
+  /**
+   * @return Duration after which idle sessions are closed.
+   */
+  std::chrono::seconds getIdleTimeout() const;
+
+  /**
+   * @param idleTimeout Duration after which idle sessions are closed.
+   */
+  void setIdleTimeout(const std::chrono::seconds& idleTimeout);
+
+public:
+  /**
+   * Default maximum number of idle sessions.
+   */
+  static const std::size_t DefaultMaxIdle = 8;
+
+  /**
+   * Default duration after which idle sessions are closed.
+   */
+  static const std::chrono::seconds DefaultIdleTimeout;
+
+private:
+  /**
+   * Give back a session to the pool.
+   *
+   * @param session The session.
+   */
+  void release(std::unique_ptr<cpr::Session> session);
+
+  /**
+   * Close sessions idle for too long. Mutex must be held.
+   *
+   * @param now Current time.
+   */
+  void evict(const std::chrono::steady_clock::time_point& now);
+
+private:
+  /**
+   * Idle session along with the last time it was used.
+   */
+  struct IdleSession {
+    std::unique_ptr<cpr::Session>         session;
+    std::chrono::steady_clock::time_point lastUsed;
+  };
+
+  /**
+   * Function creating new sessions.
+   */
+  Factory factory_;
+
+  /**
+   * Idle sessions, least recently used first.
+   */
+  std::vector<IdleSession> idle_;
+
+  /**
+   * Maximum number of idle sessions.
+   */
+  std::size_t maxIdle_;
+
+  /**
+   * Duration after which idle sessions are closed.
+   */
+  std::chrono::seconds idleTimeout_;
+
+  /**
+   * Protects the idle sessions and the settings.
+   */
+  mutable std::mutex mutex_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
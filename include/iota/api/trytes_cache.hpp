@@ -0,0 +1,228 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+#include <utility>
+
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+/**
+ * Persistent storage of transaction trytes, backing a TrytesCache.
+ * Implementations must be thread safe.
+ */
+class TrytesStore {
+public:
+  /**
+   * Default dtor.
+   */
+  virtual ~TrytesStore() = default;
+
+public:
+  /**
+   * @param hash Transaction hash.
+   * @param trytes Set with the trytes of the transaction, if found.
+   *
+   * @return Whether the transaction was found.
+   */
+  virtual bool load(const Types::Trytes& hash, Types::Trytes& trytes) = 0;
+
+  /**
+   * @param hash Transaction hash.
+   * @param trytes Trytes of the transaction.
+   *
+   * @return Whether the transaction could be stored.
+   */
+  virtual bool save(const Types::Trytes& hash, const Types::Trytes& trytes) = 0;
+};
+
+/**
+ * Size-bounded, thread safe cache of transaction trytes by hash.
+ *
+ * The trytes of a transaction never change once it is known by the node, so they can be kept
+ * forever: the least recently used transactions are evicted when the cache is full. Transactions
+ * unknown to the node (all-9 trytes) are never cached.
+ * An optional store keeps the transactions across runs: missing transactions are looked up in the
+ * store before being requested to the node, and transactions received from the node are saved.
+ */
+class TrytesCache {
+public:
+  /**
+   * Ctor.
+   *
+   * @param capacity Maximum number of transactions kept in memory.
+   * @param store Optional persistent store.
+   */
+  explicit TrytesCache(std::size_t                         capacity = DefaultCapacity,
+                       const std::shared_ptr<TrytesStore>& store    = nullptr);
+
+  /**
+   * Default dtor.
+   */
+  ~TrytesCache() = default;
+
+public:
+  /**
+   * Look up a transaction, in memory first and then in the store.
+   *
+   * @param hash Transaction hash.
+   * @param trytes Set with the trytes of the transaction, if found.
+   *
+   * @return Whether the transaction was found.
+   */
+  bool get(const Types::Trytes& hash, Types::Trytes& trytes);
+
+  /**
+   * Add a transaction to the cache and to the store, unless it is unknown to the node or its trytes
+   * do not match the hash.
+   *
+   * @param hash Transaction hash.
+   * @param trytes Trytes of the transaction.
+   */
+  void put(const Types::Trytes& hash, const Types::Trytes& trytes);
+
+  /**
+   * Drop the transactions kept in memory. The store is left untouched.
+   */
+  void clear();
+
+  /**
+   * @return Number of transactions kept in memory.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return Maximum number of transactions kept in memory.
+   */
+  std::size_t getCapacity() const;
+
+  /**
+   * @param capacity Maximum number of transactions kept in memory, evicting the least recently
+   * used ones if needed.
+   */
+  void setCapacity(std::size_t capacity);
+
+  /**
+   * @return The persistent store, null if none.
+   */
+  const std::shared_ptr<TrytesStore>& getStore() const;
+
+public:
+  /**
+   * @return Number of lookups answered from memory or from the store.
+   */
+  uint64_t getHits() const;
+
+  /**
+   * @return Number of lookups answered from the store.
+   */
+  uint64_t getStoreHits() const;
+
+  /**
+   * @return Number of lookups that had to be requested to the node.
+   */
+  uint64_t getMisses() const;
+
+  /**
+   * @return Ratio of lookups answered locally, 0 if there was no lookup.
+   */
+  double getHitRate() const;
+
+  /**
+   * Reset the hits and misses counters.
+   */
+  void resetStatistics();
+
+public:
+  /**
+   * Default maximum number of transactions kept in memory (about 27MB).
+   */
+  static const std::size_t DefaultCapacity = 10000;
+
+private:
+  /**
+   * Add a transaction in memory, evicting the least recently used one if full.
+   * Must be called with the mutex locked.
+   *
+   * @param hash Transaction hash.
+   * @param trytes Trytes of the transaction.
+   */
+  void insert(const Types::Trytes& hash, const Types::Trytes& trytes);
+
+  /**
+   * Evict the least recently used transactions exceeding the capacity.
+   * Must be called with the mutex locked.
+   */
+  void evict();
+
+private:
+  using Entry = std::pair<Types::Trytes, Types::Trytes>;
+
+  /**
+   * Protects the entries.
+   */
+  mutable std::mutex mutex_;
+
+  /**
+   * Transactions, most recently used first.
+   */
+  std::list<Entry> entries_;
+
+  /**
+   * Transactions by hash.
+   */
+  std::unordered_map<Types::Trytes, std::list<Entry>::iterator> index_;
+
+  /**
+   * Maximum number of transactions kept in memory.
+   */
+  std::size_t capacity_;
+
+  /**
+   * Optional persistent store.
+   */
+  std::shared_ptr<TrytesStore> store_;
+
+  /**
+   * Statistics.
+   */
+  std::atomic<uint64_t> hits_;
+  std::atomic<uint64_t> storeHits_;
+  std::atomic<uint64_t> misses_;
+};
+
+}  // namespace API
+
+}  // namespace IOTA
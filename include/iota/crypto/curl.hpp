@@ -28,6 +28,7 @@
 #include <algorithm>
 
 #include <iota/constants.hpp>
+#include <iota/types/packed_trits.hpp>
 #include <iota/types/trits.hpp>
 
 namespace IOTA {
@@ -74,6 +75,28 @@ public:
    */
   void squeeze(Types::Trits& trits, std::size_t offset = 0, std::size_t length = 0);
 
+  /**
+   * Absorb packed trits into the current state, unpacking them directly into the state.
+   *
+   * @param trits input packed trits to be applied (absorbed) on current state.
+   * @param offset offset (in trits) at which the input should be read.
+   * @param length number of trits of the given input that should be used for absorption.
+   */
+  template <unsigned int TritsPerByte>
+  void absorb(const Types::BasicPackedTrits<TritsPerByte>& trits, std::size_t offset = 0,
+              std::size_t length = 0);
+
+  /**
+   * Squeeze the current state to the given packed trits.
+   *
+   * @param trits packed trits to be updated (squeezed) based on current state.
+   * @param offset offset (in trits) at which the packed trits should be modified.
+   * @param length length of the current state that should be used for squeezing.
+   */
+  template <unsigned int TritsPerByte>
+  void squeeze(Types::BasicPackedTrits<TritsPerByte>& trits, std::size_t offset = 0,
+               std::size_t length = 0);
+
 private:
   /**
    * Apply sponge fonction transformation algorithm during absorption/squeezing.
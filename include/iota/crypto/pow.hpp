@@ -29,6 +29,7 @@
 
 #include <iota/constants.hpp>
 #include <iota/crypto/i_pow.hpp>
+#include <iota/types/packed_trits.hpp>
 #include <iota/types/trits.hpp>
 
 namespace IOTA {
@@ -82,9 +83,30 @@ public:
   Types::Trytes operator()(const Types::Trytes& trytes, int minWeightMagnitude,
                            int threads = 0) override;
 
+  /**
+   * Compute nonce from the given packed transaction trits.
+   * The transaction is unpacked hash by hash during the initialization of the state.
+   *
+   * @param trits The packed trits to compute nonce from.
+   * @param minWeightMagnitude The minimum number of zeroes the hash has to end with.
+   * @param threads The number of thread to run the algorithm to.
+   *
+   * @return The nonce.
+   */
+  Types::Trytes operator()(const Types::PackedTrits& trits, int minWeightMagnitude,
+                           int threads = 0);
+
 private:
+  Types::Trytes search(const std::vector<uint64_t>& stateLow,
+                       const std::vector<uint64_t>& stateHigh, int minWeightMagnitude,
+                       int threads);
   static inline void initialize(uint64_t* stateLow, uint64_t* stateHigh,
                                 const IOTA::Types::Trits& trits);
+  static inline void initialize(uint64_t* stateLow, uint64_t* stateHigh,
+                                const IOTA::Types::PackedTrits& trits);
+  static inline void copyToState(uint64_t* stateLow, uint64_t* stateHigh, const int8_t* trits,
+                                 std::size_t length);
+  static inline void initializeNonce(uint64_t* stateLow, uint64_t* stateHigh);
   static inline void transform(uint64_t* stateLow, uint64_t* stateHigh, uint64_t* scratchpadLow,
                                uint64_t* scratchpadHigh);
   static inline void increment(uint64_t* stateLow, uint64_t* stateHigh, int fromIndex, int toIndex);
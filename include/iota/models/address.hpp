@@ -27,13 +27,15 @@
 
 #include <memory>
 
-#include <iota/crypto/kerl.hpp>
 #include <iota/types/trinary.hpp>
+#include <iota/utils/deprecated.hpp>
 
 namespace IOTA {
 
 namespace Models {
 
+class MultisigAddressBuilder;
+
 /**
  * Used to store addresses.
  * Provides validity checks at construction / value set.
@@ -68,7 +70,8 @@ public:
           const int32_t& security = 2, const Type& type = NORMAL);
 
   /**
-   * Ctor - mainly to used to build multisig addresses.
+   * Ctor - mainly used to build empty multisig addresses.
+   * See MultisigAddressBuilder to generate the address value from key digests.
    *
    * @param type The address type, normal or multisig.
    */
@@ -129,15 +132,17 @@ public:
   /**
    * Absorbs key digests
    * Increments security according to digests.
+   * Deprecated: use MultisigAddressBuilder instead.
    *
    * @param digests The key digests in bytes.
    **/
-  void absorbDigests(const std::vector<uint8_t>& digests);
+  DEPRECATED void absorbDigests(const std::vector<uint8_t>& digests);
 
   /**
    * Finalizes and set the multisig address.
+   * Deprecated: use MultisigAddressBuilder instead.
    **/
-  void finalize();
+  DEPRECATED void finalize();
 
   /**
    * Validates a generated multisig address.
@@ -146,7 +151,7 @@ public:
    *
    * @return whether the multisig address is valid or not.
    **/
-  bool validate(const std::vector<std::vector<uint8_t>>& digests);
+  bool validate(const std::vector<std::vector<uint8_t>>& digests) const;
 
 public:
   /**
@@ -251,10 +256,9 @@ private:
   Types::Trytes checksum_;
 
   /**
-   * Instance of Kerl for multisig addresses.
-   * Due to an alignement issue on MSVC15/32bits, kerl has been made a shared_ptr.
+   * Builder used by the deprecated absorbDigests/finalize, only allocated on their first call.
    */
-  std::shared_ptr<Crypto::Kerl> k_;
+  std::shared_ptr<MultisigAddressBuilder> builder_;
 };
 
 std::ostream& operator<<(std::ostream& os, const Address& address);
@@ -0,0 +1,86 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <memory>
+#include <vector>
+
+#include <iota/crypto/kerl.hpp>
+#include <iota/models/address.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+/**
+ * Accumulates key digests to generate a multisig address.
+ * Kept apart from Address so that plain addresses do not carry any sponge state.
+ */
+class MultisigAddressBuilder {
+public:
+  /**
+   * Ctor.
+   */
+  MultisigAddressBuilder();
+
+  /**
+   * Default dtor.
+   */
+  ~MultisigAddressBuilder() = default;
+
+public:
+  /**
+   * Absorbs key digests.
+   * Increments the security of the resulting address according to digests.
+   *
+   * @param digests The key digests in bytes.
+   */
+  void absorbDigests(const std::vector<uint8_t>& digests);
+
+  /**
+   * Finalizes the multisig address.
+   * Must be called once all the digests have been absorbed.
+   *
+   * @return the multisig address.
+   */
+  Address finalize();
+
+private:
+  /**
+   * Instance of Kerl absorbing the digests.
+   * Due to an alignement issue on MSVC15/32bits, kerl has been made a pointer.
+   */
+  std::unique_ptr<Crypto::Kerl> k_;
+
+  /**
+   * Security accumulated so far.
+   */
+  int32_t security_ = 0;
+};
+
+}  // namespace Models
+
+}  // namespace IOTA
@@ -57,6 +57,15 @@ public:
    */
   explicit Transaction(const Types::Trytes& trytes);
 
+  /**
+   * Initializes a new instance of the Transaction class from trytes and an already known hash.
+   * The hash is trusted and not recomputed.
+   *
+   * @param trytes The trytes.
+   * @param hash The hash of the transaction.
+   */
+  Transaction(const Types::Trytes& trytes, const Types::Trytes& hash);
+
   /**
    * Initializes a new instance of the Transaction class.
    *
@@ -370,8 +379,30 @@ public:
    * Initializes a new instance of the Transaction class based on tryte string.
    *
    * @param trytes The trytes from which to initialize the transaction.
+   * @param hash The hash of the transaction, computed from the trytes if empty.
+   */
+  void initFromTrytes(const Types::Trytes& trytes, const Types::Trytes& hash = "");
+
+public:
+  /**
+   * Reads the address of a transaction from its trytes, without parsing the other fields nor
+   * computing its hash.
+   *
+   * @param trytes The trytes of the transaction.
+   *
+   * @return The address, without checksum.
+   */
+  static Types::Trytes addressFromTrytes(const Types::Trytes& trytes);
+
+  /**
+   * Reads the value of a transaction from its trytes, without parsing the other fields nor
+   * computing its hash.
+   *
+   * @param trytes The trytes of the transaction.
+   *
+   * @return The value.
    */
-  void initFromTrytes(const Types::Trytes& trytes);
+  static int64_t valueFromTrytes(const Types::Trytes& trytes);
 
 private:
   /**
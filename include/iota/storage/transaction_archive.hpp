@@ -0,0 +1,309 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include <iota/models/address.hpp>
+#include <iota/models/transaction.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace Storage {
+
+/**
+ * Read-only view on a transaction stored in a TransactionArchive.
+ *
+ * Fields are decoded on demand from the memory-mapped record, the transaction is never copied.
+ * A view is invalidated by any subsequent append to the archive and by the archive destruction.
+ */
+class TransactionView {
+public:
+  /**
+   * @param record Pointer to the packed record in the archive.
+   */
+  explicit TransactionView(const uint8_t* record);
+
+  /**
+   * Default dtor.
+   */
+  ~TransactionView() = default;
+
+public:
+  /**
+   * @return The hash of the transaction.
+   */
+  Types::Trytes getHash() const;
+
+  /**
+   * @return The address of the transaction (without checksum).
+   */
+  Types::Trytes getAddress() const;
+
+  /**
+   * @return The bundle hash of the transaction.
+   */
+  Types::Trytes getBundle() const;
+
+  /**
+   * @return The trunk transaction hash.
+   */
+  Types::Trytes getTrunkTransaction() const;
+
+  /**
+   * @return The branch transaction hash.
+   */
+  Types::Trytes getBranchTransaction() const;
+
+  /**
+   * @return The value of the transaction.
+   */
+  int64_t getValue() const;
+
+  /**
+   * @return The timestamp of the transaction.
+   */
+  int64_t getTimestamp() const;
+
+  /**
+   * @return The index of the transaction in its bundle.
+   */
+  int64_t getCurrentIndex() const;
+
+  /**
+   * @return The last index of the bundle.
+   */
+  int64_t getLastIndex() const;
+
+  /**
+   * @return Whether the transaction is a tail transaction or not.
+   */
+  bool isTailTransaction() const;
+
+  /**
+   * @return The trytes of the transaction.
+   */
+  Types::Trytes toTrytes() const;
+
+  /**
+   * @return The decoded transaction, the hash is not recomputed.
+   */
+  Models::Transaction toTransaction() const;
+
+private:
+  Types::Trytes getTrytes(std::size_t offset, std::size_t length) const;
+  int64_t       getInt(std::size_t offset, std::size_t length) const;
+
+private:
+  /**
+   * Packed record.
+   */
+  const uint8_t* record_;
+};
+
+/**
+ * Append-only binary archive of transactions.
+ *
+ * Transactions are stored as fixed-size records of packed trits (5 trits per byte): the hash
+ * followed by the transaction trits, which is 1653 bytes per transaction instead of 2673 bytes of
+ * trytes. The file is memory-mapped for reads and indexed by hash, bundle and address when opened,
+ * so that any transaction can be looked up without re-querying the node.
+ *
+ * Const members can be called concurrently. Appends and flush require exclusive access, and
+ * invalidate the views returned so far. An interrupted append leaves a partial record at the end
+ * of the file, which is dropped when the archive is opened again.
+ */
+class TransactionArchive {
+public:
+  /**
+   * Opens the archive stored at the given path, the file is created if it does not exist.
+   * Throws an IllegalState exception if the file can not be opened or is not a valid archive.
+   *
+   * @param path Path of the archive file.
+   */
+  explicit TransactionArchive(const std::string& path);
+
+  /**
+   * Unmaps and closes the archive.
+   */
+  ~TransactionArchive();
+
+  TransactionArchive(const TransactionArchive&) = delete;
+  TransactionArchive& operator=(const TransactionArchive&) = delete;
+
+public:
+  /**
+   * Appends a transaction to the archive, unless it is already stored.
+   * The hash is always recomputed from the trytes: throws an IllegalState exception if the
+   * transaction has a valid hash which does not match them, or invalid trytes.
+   *
+   * @param trx The transaction to store.
+   *
+   * @return Whether the transaction was added or was already stored.
+   */
+  bool append(const Models::Transaction& trx);
+
+  /**
+   * Appends a transaction to the archive, unless it is already stored.
+   * Throws an IllegalState exception if the trytes are not valid transaction trytes.
+   *
+   * @param trytes The trytes of the transaction to store.
+   *
+   * @return Whether the transaction was added or was already stored.
+   */
+  bool append(const Types::Trytes& trytes);
+
+  /**
+   * Writes pending appends to the file.
+   */
+  void flush();
+
+public:
+  /**
+   * @return Number of stored transactions.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return Whether the archive is empty or not.
+   */
+  bool empty() const;
+
+  /**
+   * Throws an IllegalState exception if the index is out of range.
+   *
+   * @param index Index of the transaction, in order of insertion.
+   *
+   * @return View on the transaction.
+   */
+  TransactionView at(std::size_t index) const;
+
+  /**
+   * @param hash Hash of the transaction.
+   *
+   * @return Whether the transaction is stored or not.
+   */
+  bool contains(const Types::Trytes& hash) const;
+
+  /**
+   * Throws an IllegalState exception if the transaction is not stored.
+   *
+   * @param hash Hash of the transaction.
+   *
+   * @return View on the transaction.
+   */
+  TransactionView get(const Types::Trytes& hash) const;
+
+  /**
+   * @param bundle Bundle hash.
+   *
+   * @return Views on the stored transactions of the bundle, in order of insertion.
+   */
+  std::vector<TransactionView> findByBundle(const Types::Trytes& bundle) const;
+
+  /**
+   * @param address Address.
+   *
+   * @return Views on the stored transactions of the address, in order of insertion.
+   */
+  std::vector<TransactionView> findByAddress(const Models::Address& address) const;
+
+public:
+  /**
+   * Size in bytes of a transaction record.
+   */
+  static const std::size_t RecordSize;
+
+private:
+  /**
+   * Appends a packed record, unless the hash is already indexed.
+   */
+  bool appendRecord(const std::string& record);
+
+  /**
+   * Index the given record.
+   */
+  void index(const uint8_t* record, std::size_t position);
+
+  /**
+   * Make sure that the mapping covers all the records.
+   */
+  const uint8_t* record(std::size_t position) const;
+
+private:
+  /**
+   * Memory-mapped file, platform dependent.
+   */
+  class MappedFile;
+
+private:
+  /**
+   * Path of the archive.
+   */
+  std::string path_;
+
+  /**
+   * Stream used to append records, flushed before remapping.
+   */
+  mutable std::ofstream writer_;
+
+  /**
+   * Read-only mapping of the archive, refreshed lazily after appends.
+   */
+  mutable std::unique_ptr<MappedFile> file_;
+
+  /**
+   * Previous mappings, kept alive until the next append for the views pointing to them.
+   */
+  mutable std::vector<std::unique_ptr<MappedFile>> retired_;
+
+  /**
+   * Serializes the remapping done by concurrent readers.
+   */
+  mutable std::mutex mutex_;
+
+  /**
+   * Number of records.
+   */
+  std::size_t size_;
+
+  /**
+   * Indexes, keyed by packed hashes.
+   */
+  std::unordered_map<std::string, std::size_t>              hashes_;
+  std::unordered_map<std::string, std::vector<std::size_t>> bundles_;
+  std::unordered_map<std::string, std::vector<std::size_t>> addresses_;
+};
+
+}  // namespace Storage
+
+}  // namespace IOTA
@@ -0,0 +1,304 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <iterator>
+#include <vector>
+
+#include <iota/types/trits.hpp>
+#include <iota/types/trytes.hpp>
+
+namespace IOTA {
+
+namespace Types {
+
+/**
+ * Trits container storing several trits per byte.
+ *
+ * Each byte holds the balanced ternary value of TritsPerByte consecutive trits, least significant
+ * trit first, stored as a signed byte. The last byte is zero-padded if the number of trits is not a
+ * multiple of TritsPerByte.
+ *
+ * Two encodings are provided:
+ *  * PackedTrits (T5B1): 5 trits per byte, the most compact encoding (a transaction fits in 1604
+ * bytes instead of 8019).
+ *  * PackedTrytes (T3B1): 3 trits per byte, one tryte per byte, which keeps trytes boundaries
+ * aligned on bytes.
+ */
+template <unsigned int TritsPerByte>
+class BasicPackedTrits {
+  static_assert(TritsPerByte == 3 || TritsPerByte == 5, "only T3B1 and T5B1 are supported");
+
+public:
+  /**
+   * Read-only random access iterator over the packed trits.
+   */
+  class const_iterator {
+  public:
+    using iterator_category = std::random_access_iterator_tag;
+    using value_type        = int8_t;
+    using difference_type   = std::ptrdiff_t;
+    using pointer           = const int8_t*;
+    using reference         = int8_t;
+
+  public:
+    const_iterator() = default;
+    const_iterator(const BasicPackedTrits* trits, std::size_t index);
+
+  public:
+    int8_t          operator*() const;
+    int8_t          operator[](std::ptrdiff_t n) const;
+    const_iterator& operator++();
+    const_iterator  operator++(int);
+    const_iterator& operator--();
+    const_iterator  operator--(int);
+    const_iterator& operator+=(std::ptrdiff_t n);
+    const_iterator& operator-=(std::ptrdiff_t n);
+    const_iterator  operator+(std::ptrdiff_t n) const;
+    const_iterator  operator-(std::ptrdiff_t n) const;
+    std::ptrdiff_t  operator-(const const_iterator& rhs) const;
+    bool            operator==(const const_iterator& rhs) const;
+    bool            operator!=(const const_iterator& rhs) const;
+    bool            operator<(const const_iterator& rhs) const;
+    bool            operator>(const const_iterator& rhs) const;
+    bool            operator<=(const const_iterator& rhs) const;
+    bool            operator>=(const const_iterator& rhs) const;
+
+  private:
+    const BasicPackedTrits* trits_ = nullptr;
+    std::size_t             index_ = 0;
+  };
+
+public:
+  /**
+   * Default ctor, empty container.
+   */
+  BasicPackedTrits();
+
+  /**
+   * Initializes a container of the given number of trits, all set to 0.
+   *
+   * @param size Number of trits.
+   */
+  explicit BasicPackedTrits(std::size_t size);
+
+  /**
+   * Packs the given trits.
+   *
+   * @param trits The trits to pack.
+   */
+  explicit BasicPackedTrits(const Trits& trits);
+
+  /**
+   * Packs the given trits.
+   *
+   * @param trits Pointer to the trits to pack.
+   * @param size Number of trits to pack.
+   */
+  BasicPackedTrits(const int8_t* trits, std::size_t size);
+
+  /**
+   * Default dtor.
+   */
+  ~BasicPackedTrits() = default;
+
+public:
+  /**
+   * Packs the given trytes, without going through an intermediate trits vector.
+   * Throws an IllegalState exception if the trytes are invalid.
+   *
+   * @param trytes The trytes to pack.
+   *
+   * @return The packed trits.
+   */
+  static BasicPackedTrits fromTrytes(const Types::Trytes& trytes);
+
+  /**
+   * Builds a container from already packed bytes (as returned by getBytes).
+   * Throws an IllegalState exception if the bytes do not match the encoding.
+   *
+   * @param bytes The packed bytes.
+   * @param size Number of trits stored in the bytes.
+   *
+   * @return The packed trits.
+   */
+  static BasicPackedTrits fromBytes(const std::vector<uint8_t>& bytes, std::size_t size);
+
+  /**
+   * Encodes the given trits into bytes. bytes must be able to hold packedSize(size) bytes.
+   *
+   * @param trits The trits to pack.
+   * @param size Number of trits to pack.
+   * @param bytes Where to store the packed bytes.
+   */
+  static void pack(const int8_t* trits, std::size_t size, uint8_t* bytes);
+
+  /**
+   * Decodes trits from packed bytes, without bound checking.
+   * This allows reading packed trits that are not owned by a container (e.g. memory-mapped).
+   *
+   * @param bytes The packed bytes.
+   * @param offset Offset (in trits) of the first trit to unpack.
+   * @param length Number of trits to unpack.
+   * @param trits Where to store the unpacked trits, must be able to hold length trits.
+   */
+  static void unpack(const uint8_t* bytes, std::size_t offset, std::size_t length, int8_t* trits);
+
+  /**
+   * Decodes trytes from packed bytes, without bound checking.
+   * Throws an IllegalState exception if length is not a multiple of 3.
+   *
+   * @param bytes The packed bytes.
+   * @param offset Offset (in trits) of the first trit to decode.
+   * @param length Number of trits to decode.
+   *
+   * @return The trytes.
+   */
+  static Types::Trytes toTrytes(const uint8_t* bytes, std::size_t offset, std::size_t length);
+
+  /**
+   * @param size Number of trits.
+   *
+   * @return Number of bytes required to store the given number of trits.
+   */
+  static constexpr std::size_t packedSize(std::size_t size) {
+    return (size + TritsPerByte - 1) / TritsPerByte;
+  }
+
+public:
+  /**
+   * @return the number of trits stored.
+   */
+  std::size_t size() const;
+
+  /**
+   * @return whether the container is empty or not.
+   */
+  bool empty() const;
+
+  /**
+   * @return the packed bytes.
+   */
+  const std::vector<uint8_t>& getBytes() const;
+
+  /**
+   * @param index Index of the trit.
+   *
+   * @return The trit at the given index, no bound check is performed.
+   */
+  int8_t operator[](std::size_t index) const;
+
+  /**
+   * Set the trit at the given index.
+   * Throws an IllegalState exception if the trit or the index are invalid.
+   *
+   * @param index Index of the trit.
+   * @param trit The new trit value.
+   */
+  void set(std::size_t index, int8_t trit);
+
+  /**
+   * Copy trits[0, length] to this container, starting at the given offset.
+   * Throws an IllegalState exception if the trits do not fit in the container.
+   *
+   * @param trits The trits to copy.
+   * @param offset Offset (in trits) of the first trit to update.
+   * @param length Number of trits to copy.
+   */
+  void assign(const int8_t* trits, std::size_t offset, std::size_t length);
+
+  /**
+   * Unpack [offset, offset + length] to trits.
+   * Throws an IllegalState exception if the range is out of bounds.
+   *
+   * @param trits Where to store the unpacked trits, must be able to hold length trits.
+   * @param offset Offset (in trits) of the first trit to unpack.
+   * @param length Number of trits to unpack.
+   */
+  void unpack(int8_t* trits, std::size_t offset, std::size_t length) const;
+
+  /**
+   * @return All the trits, unpacked.
+   */
+  Trits toTrits() const;
+
+  /**
+   * @return All the trits, converted to trytes. The size must be a multiple of 3.
+   */
+  Types::Trytes toTrytes() const;
+
+public:
+  const_iterator begin() const;
+  const_iterator end() const;
+
+public:
+  /**
+   * Comparison operator.
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two containers hold the same trits or not.
+   */
+  bool operator==(const BasicPackedTrits& rhs) const;
+
+  /**
+   * Comparison operator.
+   *
+   * @param rhs other object to compare with.
+   *
+   * @return Whether the two containers hold different trits or not.
+   */
+  bool operator!=(const BasicPackedTrits& rhs) const;
+
+private:
+  /**
+   * Packed trits.
+   */
+  std::vector<uint8_t> bytes_;
+
+  /**
+   * Number of trits stored.
+   */
+  std::size_t size_;
+};
+
+/**
+ * 5 trits per byte.
+ */
+using PackedTrits = BasicPackedTrits<5>;
+
+/**
+ * 3 trits (1 tryte) per byte.
+ */
+using PackedTrytes = BasicPackedTrits<3>;
+
+extern template class BasicPackedTrits<3>;
+extern template class BasicPackedTrits<5>;
+
+}  // namespace Types
+
+}  // namespace IOTA
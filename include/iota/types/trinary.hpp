@@ -41,7 +41,9 @@ int8_t tryteIndex(const char& tryte);
 bool isValidTryte(const char& tryte);
 
 /**
- * @return whether the given tryte is valid or not
+ * Validation is done 32 chars at a time on the fast path.
+ *
+ * @return whether the given trytes are valid or not
  */
 bool isValidTrytes(const Trytes& trytes);
 
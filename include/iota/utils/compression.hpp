@@ -0,0 +1,70 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Default maximum size of decompressed data: about 20 times a getTrytes reply of 1000
+ * transactions, the biggest reply expected from a node.
+ */
+static const std::size_t DefaultMaxInflatedSize = 64 * 1024 * 1024;
+
+/**
+ * @return Whether the library was built with zlib. Without it, gzip and inflate throw an
+ * IllegalState exception.
+ */
+bool isCompressionSupported();
+
+/**
+ * Compress data in the gzip format.
+ *
+ * @param data The data to compress.
+ *
+ * @return The compressed data.
+ */
+std::string gzip(const std::string& data);
+
+/**
+ * Decompress gzip or deflate (zlib or raw) data.
+ * Throws an Unrecognized exception if the data is corrupted, or a Network exception if it inflates
+ * to more than the given size, so that a broken or hostile node can not exhaust memory.
+ *
+ * @param data The compressed data.
+ * @param maxSize Maximum size of the decompressed data.
+ *
+ * @return The decompressed data.
+ */
+std::string inflate(const std::string& data, std::size_t maxSize = DefaultMaxInflatedSize);
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -0,0 +1,147 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <functional>
+#include <map>
+#include <string>
+
+#include <iota/utils/json_stream_parser.hpp>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Stream parser handler dispatching the fields of the root object to callbacks bound by name.
+ * Only the scalar fields and the arrays of scalars of the root object can be bound: deeper values
+ * and fields that are not bound are skipped.
+ * Throws an Unrecognized exception when a bound field does not have the expected type.
+ */
+class JsonFieldsHandler : public JsonStreamParser::Handler {
+public:
+  /**
+   * Ctor.
+   */
+  JsonFieldsHandler();
+
+  /**
+   * Default dtor.
+   */
+  ~JsonFieldsHandler() = default;
+
+public:
+  /**
+   * @param key Name of a string field.
+   * @param fn Called with the value, which can be moved from.
+   */
+  void bindString(const std::string& key, const std::function<void(std::string&)>& fn);
+
+  /**
+   * @param key Name of an integer field.
+   * @param fn Called with the value.
+   */
+  void bindInteger(const std::string& key, const std::function<void(int64_t)>& fn);
+
+  /**
+   * @param key Name of an array of strings.
+   * @param fn Called with each element, which can be moved from.
+   */
+  void bindStrings(const std::string& key, const std::function<void(std::string&)>& fn);
+
+  /**
+   * @param key Name of an array of booleans.
+   * @param fn Called with each element.
+   */
+  void bindBools(const std::string& key, const std::function<void(bool)>& fn);
+
+public:
+  void onStartObject() override;
+  void onEndObject() override;
+  void onStartArray() override;
+  void onEndArray() override;
+  void onKey(std::string& key) override;
+  void onString(std::string& value) override;
+  void onNumber(const std::string& value) override;
+  void onBool(bool value) override;
+  void onNull() override;
+
+private:
+  /**
+   * Expected type of a bound field.
+   */
+  enum class Type { String, Integer, Strings, Bools };
+
+  /**
+   * Callbacks of a bound field.
+   */
+  struct Binding {
+    Type                               type;
+    std::function<void(std::string&)>  onString;
+    std::function<void(int64_t)>       onInteger;
+    std::function<void(bool)>          onBool;
+  };
+
+  /**
+   * Binding of the field being read, null if the field is not bound or the value is nested.
+   *
+   * @param type The type of the value being read.
+   *
+   * @return the binding, if it expects a value of the given type.
+   */
+  const Binding* current(Type type) const;
+
+  /**
+   * Throw an Unrecognized exception if the value being read belongs to a bound field.
+   */
+  void unexpected() const;
+
+private:
+  /**
+   * Bound fields.
+   */
+  std::map<std::string, Binding> bindings_;
+
+  /**
+   * Nesting level.
+   */
+  int depth_;
+
+  /**
+   * Binding of the current field of the root object, null if not bound.
+   */
+  const Binding* field_;
+
+  /**
+   * Name of the current field of the root object.
+   */
+  std::string key_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
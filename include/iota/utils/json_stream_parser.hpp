@@ -0,0 +1,166 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Incremental (push) JSON parser.
+ *
+ * Data can be fed chunk by chunk and each value is reported to a handler as soon as it is
+ * complete, without building any json document. This keeps the memory usage bounded by the size of
+ * the biggest string value (a transaction for most API calls) instead of the size of the reply.
+ *
+ * Throws an Unrecognized exception on malformed json.
+ */
+class JsonStreamParser {
+public:
+  /**
+   * Receives parsing events. All callbacks do nothing by default.
+   */
+  class Handler {
+  public:
+    virtual ~Handler() = default;
+
+  public:
+    virtual void onStartObject() {}
+    virtual void onEndObject() {}
+    virtual void onStartArray() {}
+    virtual void onEndArray() {}
+
+    /**
+     * @param key Object key, can be moved from.
+     */
+    virtual void onKey(std::string& key) { (void)key; }
+
+    /**
+     * @param value Unescaped string value, can be moved from.
+     */
+    virtual void onString(std::string& value) { (void)value; }
+
+    /**
+     * @param value Raw representation of the number.
+     */
+    virtual void onNumber(const std::string& value) { (void)value; }
+
+    virtual void onBool(bool value) { (void)value; }
+    virtual void onNull() {}
+  };
+
+public:
+  /**
+   * @param handler Handler notified of parsing events. Must outlive the parser.
+   */
+  explicit JsonStreamParser(Handler& handler);
+
+  /**
+   * Default dtor.
+   */
+  ~JsonStreamParser() = default;
+
+public:
+  /**
+   * Parse the next chunk of data.
+   *
+   * @param data Pointer to the chunk.
+   * @param size Size of the chunk.
+   */
+  void feed(const char* data, std::size_t size);
+
+  /**
+   * Notify the parser that all the data has been fed.
+   * Throws an Unrecognized exception if the json document is incomplete.
+   */
+  void finish();
+
+  /**
+   * @return current nesting level (0 at top level, 1 inside the root object or array, ...).
+   */
+  std::size_t depth() const;
+
+private:
+  /**
+   * What is expected after the current token.
+   */
+  enum class Expect { Value, ValueOrArrayEnd, Key, KeyOrObjectEnd, Colon, CommaOrEnd, Done };
+
+  /**
+   * Token being currently read.
+   */
+  enum class Token { None, String, Number, Literal };
+
+private:
+  std::size_t readString(const char* data, std::size_t size);
+  void        readEscape(char c);
+  void        startValue(char c);
+  void        endValue();
+  void        endContainer(char c);
+  void        endNumber();
+  void        endLiteral();
+  void        appendCodePoint(unsigned int codePoint);
+
+private:
+  /**
+   * Handler notified of parsing events.
+   */
+  Handler& handler_;
+
+  /**
+   * Stack of opened containers ('{' or '[').
+   */
+  std::vector<char> containers_;
+
+  /**
+   * Parser state.
+   */
+  Expect expect_;
+  Token  token_;
+
+  /**
+   * Pending token data.
+   */
+  std::string buffer_;
+
+  /**
+   * String token state: whether the string is an object key, whether the previous char was a
+   * backslash, and the pending \uXXXX escape.
+   */
+  bool         isKey_;
+  bool         escape_;
+  int          unicodeDigits_;
+  unsigned int unicode_;
+  unsigned int highSurrogate_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -0,0 +1,141 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Writes a json document directly into a string, without building a json document first.
+ * Separators are inserted automatically: callers only need to open and close containers and
+ * write keys and values in order.
+ */
+class JsonWriter {
+public:
+  /**
+   * Ctor.
+   *
+   * @param capacity Expected size of the document, to avoid reallocations.
+   */
+  explicit JsonWriter(std::size_t capacity = 0);
+
+  /**
+   * Default dtor.
+   */
+  ~JsonWriter() = default;
+
+public:
+  JsonWriter& startObject();
+  JsonWriter& endObject();
+  JsonWriter& startArray();
+  JsonWriter& endArray();
+
+  /**
+   * @param key Object key, escaped if needed.
+   */
+  JsonWriter& key(const std::string& key);
+
+  /**
+   * @param value String value, escaped if needed.
+   */
+  JsonWriter& value(const std::string& value);
+  JsonWriter& value(const char* value);
+  JsonWriter& value(int64_t value);
+  JsonWriter& value(int value);
+  JsonWriter& value(bool value);
+
+  /**
+   * Write an array of strings, reserving space for all of them at once.
+   *
+   * @param values The strings.
+   */
+  JsonWriter& value(const std::vector<std::string>& values);
+
+  /**
+   * Write an array of values.
+   *
+   * @param values The values.
+   */
+  template <typename T>
+  JsonWriter& value(const std::vector<T>& values) {
+    startArray();
+    for (const auto& v : values) {
+      value(v);
+    }
+    return endArray();
+  }
+
+public:
+  /**
+   * @return The document written so far.
+   */
+  const std::string& str() const;
+
+  /**
+   * Reserve space for the upcoming data.
+   *
+   * @param size Number of additional bytes.
+   */
+  void reserve(std::size_t size);
+
+private:
+  /**
+   * Insert a comma if the value is not the first of its container.
+   */
+  void separate();
+
+  /**
+   * Write a quoted, escaped string.
+   *
+   * @param str The string.
+   */
+  void writeString(const std::string& str);
+
+private:
+  /**
+   * The document.
+   */
+  std::string out_;
+
+  /**
+   * Whether the next value of each opened container is the first one.
+   */
+  std::vector<bool> first_;
+
+  /**
+   * Whether a key was just written.
+   */
+  bool afterKey_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -25,47 +25,69 @@
 
 #pragma once
 
-#include <atomic>
-#include <future>
+#include <exception>
+#include <thread>
 #include <vector>
 
+#include <iota/utils/task_scheduler.hpp>
+
 namespace IOTA {
 
 namespace Utils {
 
+/**
+ * Run fn(i) for each i in [begin, end) on the default task scheduler.
+ */
 template <typename F>
 void
 parallel_for(std::size_t begin, std::size_t end, F fn) {
-  std::atomic<std::size_t>       idx(begin);
-  int                            num_cpus = std::thread::hardware_concurrency();
-  std::vector<std::future<void>> futures(num_cpus);
-
-  for (int cpu = 0; cpu != num_cpus; ++cpu) {
-    futures[cpu] = std::async(std::launch::async, [&idx, end, &fn]() {
-      for (;;) {
-        std::size_t i = idx++;
-        if (i >= end)
-          break;
-        fn(i);
-      }
-    });
-  }
-  for (int cpu = 0; cpu != num_cpus; ++cpu) {
-    futures[cpu].get();
+  if (end <= begin) {
+    return;
   }
+
+  TaskScheduler::getDefault().parallelFor(end - begin,
+                                          [&fn, begin](std::size_t i) { fn(begin + i); });
 }
 
+/**
+ * Run fn(cpu, num_cpus) for each cpu in [0, threads), all of them concurrently: on the calling
+ * thread and on threads started for the call.
+ * Meant for long searches such as PoW, which must neither hold the threads of the default task
+ * scheduler nor wait for them. The first exception thrown by a call, if any, is rethrown.
+ *
+ * @param threads Number of calls, 0 for the number of cores.
+ */
 template <typename F>
 void
 parallel_for(int threads, F fn) {
-  int num_cpus = threads == 0 ? std::thread::hardware_concurrency() : threads;
-  std::vector<std::future<void>> futures(num_cpus);
+  std::size_t num_cpus =
+      threads > 0 ? threads : std::max(1U, std::thread::hardware_concurrency());
+
+  std::vector<std::exception_ptr> errors(num_cpus);
+  std::vector<std::thread>        helpers;
+
+  auto call = [&fn, &errors, num_cpus](std::size_t cpu) {
+    try {
+      fn(cpu, num_cpus);
+    } catch (...) {
+      errors[cpu] = std::current_exception();
+    }
+  };
 
-  for (int cpu = 0; cpu != num_cpus; ++cpu) {
-    futures[cpu] = std::async(std::launch::async, fn, cpu, num_cpus);
+  for (std::size_t cpu = 1; cpu < num_cpus; ++cpu) {
+    helpers.emplace_back(call, cpu);
   }
-  for (int cpu = 0; cpu != num_cpus; ++cpu) {
-    futures[cpu].get();
+
+  call(0);
+
+  for (auto& helper : helpers) {
+    helper.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error) {
+      std::rethrow_exception(error);
+    }
   }
 }
 
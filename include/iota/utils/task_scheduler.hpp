@@ -0,0 +1,237 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <deque>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Work-stealing pool of threads for short cpu-bound work: address generation, bundle traversal and
+ * verification. Long searches such as PoW run on their own threads (see parallel_for).
+ * Each thread owns a queue: tasks spawned from a pool thread go to its own queue and are run in
+ * LIFO order, idle threads steal the oldest tasks of the other queues. Threads waiting for a task
+ * group run the pending tasks of that group instead of blocking, so parallel calls can be nested
+ * without a short wait picking up unrelated long work.
+ * Threads are only started when the first task is submitted.
+ */
+class TaskScheduler {
+public:
+  /**
+   * Ctor.
+   *
+   * @param size Number of threads, 0 for the number of cores.
+   */
+  explicit TaskScheduler(std::size_t size = 0);
+
+  /**
+   * Dtor: runs pending tasks and joins the threads.
+   */
+  ~TaskScheduler();
+
+  TaskScheduler(const TaskScheduler&) = delete;
+  TaskScheduler& operator=(const TaskScheduler&) = delete;
+
+public:
+  /**
+   * Queue a task. Exceptions thrown by the task are ignored: use a TaskGroup to get them.
+   *
+   * @param task The task.
+   */
+  void spawn(std::function<void()> task);
+
+  /**
+   * Run one pending task on the calling thread, stealing it from any queue.
+   *
+   * @return false if there was no pending task.
+   */
+  bool runPending();
+
+  /**
+   * Run fn(i) for each i in [0, count), concurrently on the pool and on the calling thread.
+   * Indexes are handed out one by one, so slow calls do not hold back the others.
+   * If calls throw, the remaining ones are skipped and the first exception is rethrown.
+   *
+   * @param count Number of calls.
+   * @param fn The function to call.
+   */
+  void parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn);
+
+public:
+  /**
+   * @return Number of threads.
+   */
+  std::size_t getSize() const;
+
+  /**
+   * Set the number of threads.
+   * Throws an IllegalState exception once the threads are started.
+   *
+   * @param size Number of threads, 0 for the number of cores.
+   */
+  void setSize(std::size_t size);
+
+  /**
+   * @return The scheduler used by the library for its parallel work.
+   */
+  static TaskScheduler& getDefault();
+
+private:
+  /**
+   * Queue of a thread, plus the one receiving the tasks spawned from outside of the pool.
+   */
+  struct Queue {
+    std::mutex                        mutex;
+    std::deque<std::function<void()>> tasks;
+  };
+
+  /**
+   * Start the threads if needed.
+   */
+  void start();
+
+  /**
+   * Pop a task from the queue of the calling thread or steal one from another queue.
+   *
+   * @param task Set with the task.
+   *
+   * @return false if there was no pending task.
+   */
+  bool take(std::function<void()>& task);
+
+  /**
+   * Thread loop.
+   *
+   * @param index Index of the thread.
+   */
+  void run(std::size_t index);
+
+  /**
+   * @return Index of the queue of the calling thread, or the shared queue.
+   */
+  std::size_t currentQueue() const;
+
+private:
+  //! number of threads, protected by mutex_
+  std::size_t size_;
+
+  //! one queue per thread, then the shared queue. Created when starting.
+  std::vector<std::unique_ptr<Queue>> queues_;
+
+  //! running threads
+  std::vector<std::thread> threads_;
+
+  //! number of queued tasks, protected by mutex_
+  std::size_t pending_;
+
+  //! set when destroying, protected by mutex_
+  bool stopping_;
+
+  //! whether the threads are started
+  std::atomic<bool> started_;
+
+  mutable std::mutex      mutex_;
+  std::condition_variable cv_;
+};
+
+/**
+ * Set of tasks run on a scheduler, that can be waited for together.
+ */
+class TaskGroup {
+public:
+  /**
+   * Ctor.
+   *
+   * @param scheduler Scheduler running the tasks.
+   */
+  explicit TaskGroup(TaskScheduler& scheduler = TaskScheduler::getDefault());
+
+  /**
+   * Dtor: waits for the tasks, ignoring their exceptions.
+   */
+  ~TaskGroup();
+
+  TaskGroup(const TaskGroup&) = delete;
+  TaskGroup& operator=(const TaskGroup&) = delete;
+
+public:
+  /**
+   * Run a task of the group.
+   *
+   * @param task The task.
+   */
+  void run(std::function<void()> task);
+
+  /**
+   * Wait for all the tasks of the group, running the pending tasks of the group meanwhile.
+   * Rethrows the first exception thrown by a task, if any.
+   */
+  void wait();
+
+private:
+  /**
+   * State shared with the tasks.
+   * Tasks of the group are queued here: each one is run either by a thread of the scheduler or by
+   * the thread waiting for the group, whichever takes it first.
+   */
+  struct State {
+    std::mutex                        mutex;
+    std::condition_variable           cv;
+    std::deque<std::function<void()>> tasks;
+    std::size_t                       pending = 0;
+    std::exception_ptr                error;
+  };
+
+  /**
+   * Run a queued task of the group, if any is left.
+   *
+   * @param state The state of the group.
+   * @param lock Lock on the state mutex, released while the task runs.
+   * @param newest Whether to take the newest queued task rather than the oldest.
+   *
+   * @return false if no task was queued.
+   */
+  static bool runQueued(State& state, std::unique_lock<std::mutex>& lock, bool newest);
+
+  TaskScheduler&         scheduler_;
+  std::shared_ptr<State> state_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
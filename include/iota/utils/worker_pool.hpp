@@ -0,0 +1,206 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <exception>
+#include <deque>
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace IOTA {
+
+namespace Utils {
+
+/**
+ * Fixed-size pool of threads running tasks in submission order.
+ * Meant for blocking tasks such as node requests: a given number of requests can be in flight
+ * without spawning one thread per request.
+ * Threads are only started when the first task is submitted.
+ * Pending tasks are still run when the pool is destroyed.
+ */
+class WorkerPool {
+public:
+  /**
+   * Ctor.
+   *
+   * @param size Number of threads.
+   */
+  explicit WorkerPool(std::size_t size = DefaultSize);
+
+  /**
+   * Dtor: waits for pending tasks to be run.
+   */
+  ~WorkerPool();
+
+  WorkerPool(const WorkerPool&) = delete;
+  WorkerPool& operator=(const WorkerPool&) = delete;
+
+public:
+  /**
+   * Run a task on the pool.
+   *
+   * @param fn The task.
+   *
+   * @return Future set with the result of the task, or the exception it threw.
+   */
+  template <typename F>
+  std::future<typename std::result_of<F()>::type> submit(F fn) {
+    using Result = typename std::result_of<F()>::type;
+
+    //! std::function requires a copyable target
+    auto task   = std::make_shared<std::packaged_task<Result()>>(std::move(fn));
+    auto future = task->get_future();
+
+    push([task] { (*task)(); });
+
+    return future;
+  }
+
+  /**
+   * Run fn(i) for each i in [0, count), concurrently on the pool and on the calling thread.
+   * Returns once all calls are done. The calling thread keeps running calls itself instead of only
+   * waiting, so this can safely be used from a task of the same pool.
+   * If calls throw, the remaining ones are skipped and the first exception is rethrown.
+   *
+   * @param count Number of calls.
+   * @param fn The function to call.
+   */
+  template <typename F>
+  void parallelFor(std::size_t count, F fn) {
+    auto loop = std::make_shared<Loop>(count, std::function<void(std::size_t)>(std::move(fn)));
+
+    for (std::size_t helpers = std::min(count, getSize()); helpers > 1; --helpers) {
+      push([loop] { loop->run(); });
+    }
+
+    loop->run();
+    loop->wait();
+  }
+
+public:
+  /**
+   * @return Number of threads.
+   */
+  std::size_t getSize() const;
+
+  /**
+   * Set the number of threads.
+   * Throws an IllegalState exception once the threads are started.
+   *
+   * @param size Number of threads, at least one.
+   */
+  void setSize(std::size_t size);
+
+public:
+  /**
+   * Default number of threads.
+   */
+  static const std::size_t DefaultSize = 4;
+
+private:
+  /**
+   * State shared with the threads.
+   * A task may own the last reference to the pool itself: the threads keep the state alive so that
+   * the pool can be destroyed from one of them.
+   */
+  struct State {
+    std::mutex                        mutex;
+    std::condition_variable           cv;
+    std::deque<std::function<void()>> tasks;
+    bool                              stopping = false;
+  };
+
+  /**
+   * State of a parallelFor call.
+   * Helpers queued on the pool may only start once the call returned: they then find nothing left
+   * to do and never touch the function.
+   */
+  class Loop {
+  public:
+    Loop(std::size_t count, std::function<void(std::size_t)> fn);
+
+    /**
+     * Run calls until none is left.
+     */
+    void run();
+
+    /**
+     * Wait for all the calls to be done, rethrow the first exception if any.
+     */
+    void wait();
+
+  private:
+    std::size_t                      count_;
+    std::function<void(std::size_t)> fn_;
+    std::atomic<std::size_t>         next_;
+    std::size_t                      done_;
+    std::exception_ptr               error_;
+    std::mutex                       mutex_;
+    std::condition_variable          cv_;
+  };
+
+  /**
+   * Queue a task, starting the threads if needed.
+   *
+   * @param task The task.
+   */
+  void push(std::function<void()> task);
+
+  /**
+   * Thread loop.
+   *
+   * @param state The shared state.
+   */
+  static void run(const std::shared_ptr<State>& state);
+
+private:
+  /**
+   * State shared with the threads.
+   */
+  std::shared_ptr<State> state_;
+
+  /**
+   * Running threads, protected by the state mutex.
+   */
+  std::vector<std::thread> threads_;
+
+  /**
+   * Number of threads, protected by the state mutex.
+   */
+  std::size_t size_;
+};
+
+}  // namespace Utils
+
+}  // namespace IOTA
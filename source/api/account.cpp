@@ -0,0 +1,82 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/api/account.hpp>
+#include <iota/api/portfolio.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+Account::Account(const Extended& api, const Models::Seed& seed) : api_(api), seed_(seed) {
+}
+
+Responses::GetAccountData
+Account::refresh() {
+  return Portfolio::sync(api_, { this }).front();
+}
+
+Responses::GetAccountData
+Account::getData() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return buildData(0);
+}
+
+const Models::Seed&
+Account::getSeed() const {
+  return seed_;
+}
+
+std::size_t
+Account::getKnownTransactionsCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return knownTransactions_.size();
+}
+
+Responses::GetAccountData
+Account::buildData(int64_t duration) const {
+  std::vector<Models::Bundle> transfers;
+  int64_t                     balance = 0;
+
+  transfers.reserve(bundles_.size());
+
+  for (const auto& bundle : bundles_) {
+    transfers.push_back(bundle.second);
+  }
+
+  std::sort(transfers.begin(), transfers.end());
+
+  for (const auto& address : addresses_) {
+    balance += address.getBalance();
+  }
+
+  return { addresses_, transfers, balance, duration };
+}
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,79 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <iota/api/archive_trytes_store.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/types/trinary.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+ArchiveTrytesStore::ArchiveTrytesStore(const std::string& path) : archive_(path) {
+}
+
+bool
+ArchiveTrytesStore::load(const Types::Trytes& hash, Types::Trytes& trytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (!Types::isValidHash(hash) || !archive_.contains(hash)) {
+    return false;
+  }
+
+  trytes = archive_.get(hash).toTrytes();
+  return true;
+}
+
+bool
+ArchiveTrytesStore::save(const Types::Trytes&, const Types::Trytes& trytes) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  //! the hash is recomputed by the archive: the transaction is stored under its actual hash
+  try {
+    archive_.append(trytes);
+  } catch (const Errors::IllegalState&) {
+    return false;
+  }
+
+  return true;
+}
+
+void
+ArchiveTrytesStore::flush() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  archive_.flush();
+}
+
+std::size_t
+ArchiveTrytesStore::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return archive_.size();
+}
+
+}  // namespace API
+
+}  // namespace IOTA
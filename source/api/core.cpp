@@ -23,6 +23,9 @@
 //
 //
 
+#include <algorithm>
+#include <unordered_set>
+
 #include <iota/api/core.hpp>
 #include <iota/api/requests/add_neighbors.hpp>
 #include <iota/api/requests/attach_to_tangle.hpp>
@@ -57,14 +60,109 @@
 #include <iota/errors/illegal_state.hpp>
 #include <iota/models/neighbor.hpp>
 #include <iota/models/transaction.hpp>
+#include <iota/utils/json_fields_handler.hpp>
 #include <iota/utils/stop_watch.hpp>
 
 namespace IOTA {
 
 namespace API {
 
+namespace {
+
+/**
+ * @return Whether the given trytes are a valid transaction hash.
+ */
+bool
+isValidHash(const Types::Trytes& hash) {
+  return hash.size() == HashLength && Types::isValidTrytes(hash);
+}
+
+}  // namespace
+
 Core::Core(const std::string& host, const uint16_t& port, bool localPow, int timeout, const std::string& user, const std::string& pass)
-    : service_(host, port, timeout, user, pass), localPow_(localPow) {
+    : service_(host, port, timeout, user, pass),
+      localPow_(localPow),
+      maxItemsPerRequest_(DefaultMaxItemsPerRequest),
+      trytesCoalescer_(std::make_shared<Coalescer<Responses::GetTrytes>>()),
+      balancesCoalescer_(std::make_shared<Coalescer<Responses::GetBalances>>()),
+      nodeInfoCache_(std::make_shared<NodeInfoCache>()) {
+}
+
+Core::Core(const std::vector<Endpoint>& nodes, bool localPow, int timeout, const std::string& user,
+           const std::string& pass)
+    : service_(nodes, timeout, user, pass),
+      localPow_(localPow),
+      maxItemsPerRequest_(DefaultMaxItemsPerRequest),
+      trytesCoalescer_(std::make_shared<Coalescer<Responses::GetTrytes>>()),
+      balancesCoalescer_(std::make_shared<Coalescer<Responses::GetBalances>>()),
+      nodeInfoCache_(std::make_shared<NodeInfoCache>()) {
+}
+
+const std::size_t Core::DefaultMaxItemsPerRequest;
+
+const Service&
+Core::getService() const {
+  return service_;
+}
+
+Service&
+Core::getService() {
+  return service_;
+}
+
+std::size_t
+Core::getMaxItemsPerRequest() const {
+  return maxItemsPerRequest_;
+}
+
+void
+Core::setMaxItemsPerRequest(std::size_t maxItems) {
+  maxItemsPerRequest_ = maxItems;
+}
+
+std::chrono::microseconds
+Core::getCoalescingWindow() const {
+  return trytesCoalescer_->getWindow();
+}
+
+void
+Core::setCoalescingWindow(const std::chrono::microseconds& window) {
+  trytesCoalescer_->setWindow(window);
+  balancesCoalescer_->setWindow(window);
+}
+
+const std::shared_ptr<TrytesCache>&
+Core::getTrytesCache() const {
+  return trytesCache_;
+}
+
+void
+Core::setTrytesCache(const std::shared_ptr<TrytesCache>& cache) {
+  trytesCache_ = cache;
+}
+
+NodeInfoCache&
+Core::getNodeInfoCache() const {
+  return *nodeInfoCache_;
+}
+
+void
+Core::startNodeInfoRefresh() const {
+  //! the refresh thread must not keep the cache alive
+  auto core = *this;
+  core.nodeInfoCache_.reset();
+
+  nodeInfoCache_->startRefresh([core] { return core.getNodeInfo(); });
+}
+
+void
+Core::stopNodeInfoRefresh() const {
+  nodeInfoCache_->stopRefresh();
+}
+
+bool
+Core::mustChunk(std::size_t count) const {
+  return maxItemsPerRequest_ != 0 && count > maxItemsPerRequest_;
 }
 
 Responses::GetNodeInfo
@@ -72,6 +170,11 @@ Core::getNodeInfo() const {
   return service_.request<Requests::GetNodeInfo, Responses::GetNodeInfo>();
 }
 
+Responses::GetNodeInfo
+Core::getCachedNodeInfo() const {
+  return nodeInfoCache_->get([this] { return getNodeInfo(); });
+}
+
 Responses::GetNeighbors
 Core::getNeighbors() const {
   return service_.request<Requests::GetNeighbors, Responses::GetNeighbors>();
@@ -102,13 +205,209 @@ Core::findTransactions(const std::vector<Models::Address>& addresses,
     return Responses::FindTransactions();
   }
 
-  return service_.request<Requests::FindTransactions, Responses::FindTransactions>(
-      addresses, tags, approvees, bundles);
+  auto largest = std::max({ addresses.size(), tags.size(), approvees.size(), bundles.size() });
+
+  if (!mustChunk(largest)) {
+    return service_.requestStreamed<Requests::FindTransactions, Responses::FindTransactions>(
+        addresses, tags, approvees, bundles);
+  }
+
+  //! the node returns the intersection, over the fields, of the matches of any value of a field:
+  //! splitting the largest field only and merging the results is equivalent
+  std::vector<Responses::FindTransactions> responses;
+
+  if (addresses.size() == largest) {
+    responses = requestChunks<Responses::FindTransactions>(
+        addresses, [&](const std::vector<Models::Address>& chunk) {
+          return service_
+              .requestStreamed<Requests::FindTransactions, Responses::FindTransactions>(
+              chunk, tags, approvees, bundles);
+        });
+  } else if (tags.size() == largest) {
+    responses = requestChunks<Responses::FindTransactions>(
+        tags, [&](const std::vector<Models::Tag>& chunk) {
+          return service_
+              .requestStreamed<Requests::FindTransactions, Responses::FindTransactions>(
+              addresses, chunk, approvees, bundles);
+        });
+  } else if (approvees.size() == largest) {
+    responses = requestChunks<Responses::FindTransactions>(
+        approvees, [&](const std::vector<Types::Trytes>& chunk) {
+          return service_
+              .requestStreamed<Requests::FindTransactions, Responses::FindTransactions>(
+              addresses, tags, chunk, bundles);
+        });
+  } else {
+    responses = requestChunks<Responses::FindTransactions>(
+        bundles, [&](const std::vector<Types::Trytes>& chunk) {
+          return service_
+              .requestStreamed<Requests::FindTransactions, Responses::FindTransactions>(
+              addresses, tags, approvees, chunk);
+        });
+  }
+
+  //! a transaction approving two of the approvees may be returned twice
+  std::vector<Types::Trytes>        hashes;
+  std::unordered_set<Types::Trytes> seen;
+  int64_t                           duration = 0;
+
+  for (const auto& res : responses) {
+    for (const auto& hash : res.getHashes()) {
+      if (seen.insert(hash).second) {
+        hashes.push_back(hash);
+      }
+    }
+    duration += res.getDuration();
+  }
+
+  Responses::FindTransactions res{ hashes };
+  res.setDuration(duration);
+  return res;
 }
 
 Responses::GetTrytes
 Core::getTrytes(const std::vector<Types::Trytes>& hashes) const {
-  return service_.request<Requests::GetTrytes, Responses::GetTrytes>(hashes);
+  if (!trytesCache_) {
+    return joinTrytes(hashes);
+  }
+
+  std::vector<Types::Trytes> trytes(hashes.size());
+  std::vector<Types::Trytes> missing;
+  std::vector<std::size_t>   missingIndexes;
+
+  for (std::size_t i = 0; i < hashes.size(); ++i) {
+    if (!isValidHash(hashes[i]) || !trytesCache_->get(hashes[i], trytes[i])) {
+      missing.push_back(hashes[i]);
+      missingIndexes.push_back(i);
+    }
+  }
+
+  if (missing.empty()) {
+    return Responses::GetTrytes{ trytes };
+  }
+
+  auto res = joinTrytes(missing);
+
+  for (std::size_t i = 0; i < missing.size(); ++i) {
+    trytes[missingIndexes[i]] = res.getTrytes().at(i);
+    trytesCache_->put(missing[i], trytes[missingIndexes[i]]);
+  }
+
+  Responses::GetTrytes merged{ trytes };
+  merged.setDuration(res.getDuration());
+  return merged;
+}
+
+Responses::GetTrytes
+Core::joinTrytes(const std::vector<Types::Trytes>& hashes) const {
+  //! invalid hashes must be reported to the caller only, do not merge them
+  if (!trytesCoalescer_->enabled() || !std::all_of(hashes.begin(), hashes.end(), isValidHash)) {
+    return fetchTrytes(hashes);
+  }
+
+  auto res = trytesCoalescer_->join(
+      "", hashes, maxItemsPerRequest_,
+      [this](const std::vector<Types::Trytes>& merged) { return fetchTrytes(merged); });
+
+  std::vector<Types::Trytes> trytes;
+
+  trytes.reserve(res.indexes.size());
+  for (auto index : res.indexes) {
+    trytes.push_back(res.response->getTrytes().at(index));
+  }
+
+  Responses::GetTrytes merged{ trytes };
+  merged.setDuration(res.response->getDuration());
+  return merged;
+}
+
+Responses::GetTrytes
+Core::fetchTrytes(const std::vector<Types::Trytes>& hashes) const {
+  if (!mustChunk(hashes.size())) {
+    return service_.requestStreamed<Requests::GetTrytes, Responses::GetTrytes>(hashes);
+  }
+
+  auto responses = requestChunks<Responses::GetTrytes>(
+      hashes, [this](const std::vector<Types::Trytes>& chunk) {
+        return service_.requestStreamed<Requests::GetTrytes, Responses::GetTrytes>(chunk);
+      });
+
+  std::vector<Types::Trytes> trytes;
+  int64_t                    duration = 0;
+
+  trytes.reserve(hashes.size());
+  for (auto& res : responses) {
+    trytes.insert(trytes.end(), res.getTrytes().begin(), res.getTrytes().end());
+    duration += res.getDuration();
+  }
+
+  Responses::GetTrytes res{ trytes };
+  res.setDuration(duration);
+  return res;
+}
+
+void
+Core::getTrytes(const std::vector<Types::Trytes>&                hashes,
+                const std::function<void(const Types::Trytes&)>& callback) const {
+  if (!trytesCache_) {
+    streamTrytes(hashes, callback);
+    return;
+  }
+
+  std::vector<Types::Trytes> cached(hashes.size());
+  std::vector<bool>          found(hashes.size());
+  std::vector<Types::Trytes> missing;
+
+  for (std::size_t i = 0; i < hashes.size(); ++i) {
+    found[i] = isValidHash(hashes[i]) && trytesCache_->get(hashes[i], cached[i]);
+
+    if (!found[i]) {
+      missing.push_back(hashes[i]);
+    }
+  }
+
+  //! cached transactions are passed to the callback in between the streamed ones, to keep order
+  std::size_t next  = 0;
+  auto        flush = [&] {
+    for (; next < hashes.size() && found[next]; ++next) {
+      callback(cached[next]);
+      Types::Trytes().swap(cached[next]);
+    }
+  };
+
+  if (!missing.empty()) {
+    streamTrytes(missing, [&](const Types::Trytes& trytes) {
+      flush();
+
+      if (next < hashes.size()) {
+        trytesCache_->put(hashes[next++], trytes);
+      }
+
+      callback(trytes);
+    });
+  }
+
+  flush();
+}
+
+void
+Core::streamTrytes(const std::vector<Types::Trytes>&                hashes,
+                   const std::function<void(const Types::Trytes&)>& callback) const {
+  Utils::JsonFieldsHandler handler;
+  handler.bindStrings("trytes", [&callback](std::string& trytes) { callback(trytes); });
+
+  if (!mustChunk(hashes.size())) {
+    service_.stream<Requests::GetTrytes>(handler, hashes);
+    return;
+  }
+
+  //! chunks are streamed one after the other to keep the order without buffering replies
+  for (std::size_t i = 0; i < hashes.size(); i += maxItemsPerRequest_) {
+    auto end = hashes.begin() + std::min(hashes.size(), i + maxItemsPerRequest_);
+
+    service_.stream<Requests::GetTrytes>(handler,
+                                         std::vector<Types::Trytes>(hashes.begin() + i, end));
+  }
 }
 
 Responses::GetInclusionStates
@@ -122,15 +421,105 @@ Core::getInclusionStates(const std::vector<Types::Trytes>& transactions,
     throw Errors::IllegalState("Empty list of tips");
   }
 
-  return service_.request<Requests::GetInclusionStates, Responses::GetInclusionStates>(transactions,
-                                                                                       tips);
+  if (!mustChunk(transactions.size())) {
+    return service_
+        .requestStreamed<Requests::GetInclusionStates, Responses::GetInclusionStates>(transactions,
+                                                                                      tips);
+  }
+
+  auto responses = requestChunks<Responses::GetInclusionStates>(
+      transactions, [&](const std::vector<Types::Trytes>& chunk) {
+        return service_
+            .requestStreamed<Requests::GetInclusionStates, Responses::GetInclusionStates>(chunk,
+                                                                                          tips);
+      });
+
+  std::vector<bool> states;
+  int64_t           duration = 0;
+
+  for (const auto& res : responses) {
+    states.insert(states.end(), res.getStates().begin(), res.getStates().end());
+    duration += res.getDuration();
+  }
+
+  Responses::GetInclusionStates res{ states };
+  res.setDuration(duration);
+  return res;
 }
 
 Responses::GetBalances
 Core::getBalances(const std::vector<Models::Address>& addresses, const int& threshold,
                   const std::vector<Types::Trytes>& tips) const {
-  return service_.request<Requests::GetBalances, Responses::GetBalances>(addresses, threshold,
-                                                                         tips);
+  if (!balancesCoalescer_->enabled()) {
+    return fetchBalances(addresses, threshold, tips);
+  }
+
+  //! only requests with the same threshold and tips can be merged
+  auto group = std::to_string(threshold);
+  for (const auto& tip : tips) {
+    group += "," + tip;
+  }
+
+  std::vector<Types::Trytes> items;
+  items.reserve(addresses.size());
+  for (const auto& address : addresses) {
+    items.push_back(address.toTrytes());
+  }
+
+  auto res = balancesCoalescer_->join(
+      group, items, maxItemsPerRequest_, [&](const std::vector<Types::Trytes>& merged) {
+        return fetchBalances(std::vector<Models::Address>(merged.begin(), merged.end()), threshold,
+                             tips);
+      });
+
+  std::vector<std::string> balances;
+
+  balances.reserve(res.indexes.size());
+  for (auto index : res.indexes) {
+    balances.push_back(res.response->getBalances().at(index));
+  }
+
+  Responses::GetBalances merged{ balances, res.response->getReferences(),
+                                 res.response->getMilestoneIndex() };
+  merged.setDuration(res.response->getDuration());
+  return merged;
+}
+
+Responses::GetBalances
+Core::fetchBalances(const std::vector<Models::Address>& addresses, const int& threshold,
+                    const std::vector<Types::Trytes>& tips) const {
+  if (!mustChunk(addresses.size())) {
+    return service_.requestStreamed<Requests::GetBalances, Responses::GetBalances>(
+        addresses, threshold, tips);
+  }
+
+  //! without tips, the first chunk determines the milestone of reference: the other chunks are
+  //! computed from its point of view so that all balances are consistent
+  std::vector<Models::Address> first(addresses.begin(), addresses.begin() + maxItemsPerRequest_);
+  std::vector<Models::Address> others(addresses.begin() + maxItemsPerRequest_, addresses.end());
+
+  auto firstRes = service_.requestStreamed<Requests::GetBalances, Responses::GetBalances>(
+      first, threshold, tips);
+
+  auto references = tips.empty() ? firstRes.getReferences() : tips;
+
+  auto responses = requestChunks<Responses::GetBalances>(
+      others, [&](const std::vector<Models::Address>& chunk) {
+        return service_.requestStreamed<Requests::GetBalances, Responses::GetBalances>(
+            chunk, threshold, references);
+      });
+
+  std::vector<std::string> balances = firstRes.getBalances();
+  int64_t                  duration = firstRes.getDuration();
+
+  for (const auto& res : responses) {
+    balances.insert(balances.end(), res.getBalances().begin(), res.getBalances().end());
+    duration += res.getDuration();
+  }
+
+  Responses::GetBalances res{ balances, firstRes.getReferences(), firstRes.getMilestoneIndex() };
+  res.setDuration(duration);
+  return res;
 }
 
 Responses::GetTransactionsToApprove
@@ -187,8 +576,30 @@ Core::storeTransactions(const std::vector<Types::Trytes>& trytes) const {
 
 Responses::WereAddressesSpentFrom
 Core::wereAddressesSpentFrom(const std::vector<Models::Address>& addresses) const {
-  return service_.request<Requests::WereAddressesSpentFrom, Responses::WereAddressesSpentFrom>(
-      addresses);
+  if (!mustChunk(addresses.size())) {
+    return service_
+        .requestStreamed<Requests::WereAddressesSpentFrom, Responses::WereAddressesSpentFrom>(
+            addresses);
+  }
+
+  auto responses = requestChunks<Responses::WereAddressesSpentFrom>(
+      addresses, [this](const std::vector<Models::Address>& chunk) {
+        return service_
+            .requestStreamed<Requests::WereAddressesSpentFrom, Responses::WereAddressesSpentFrom>(
+                chunk);
+      });
+
+  std::vector<bool> states;
+  int64_t           duration = 0;
+
+  for (const auto& res : responses) {
+    states.insert(states.end(), res.getStates().begin(), res.getStates().end());
+    duration += res.getDuration();
+  }
+
+  Responses::WereAddressesSpentFrom res{ states };
+  res.setDuration(duration);
+  return res;
 }
 
 Responses::CheckConsistency
@@ -196,6 +607,76 @@ Core::checkConsistency(const std::vector<Types::Trytes>& tails) const {
   return service_.request<Requests::CheckConsistency, Responses::CheckConsistency>(tails);
 }
 
+std::future<Responses::GetNodeInfo>
+Core::getNodeInfoAsync() const {
+  auto core = *this;
+  return service_.async([core] { return core.getNodeInfo(); });
+}
+
+std::future<Responses::FindTransactions>
+Core::findTransactionsAsync(const std::vector<Models::Address>& addresses,
+                            const std::vector<Models::Tag>&     tags,
+                            const std::vector<Types::Trytes>&   approvees,
+                            const std::vector<Types::Trytes>&   bundles) const {
+  auto core = *this;
+  return service_.async([core, addresses, tags, approvees, bundles] {
+    return core.findTransactions(addresses, tags, approvees, bundles);
+  });
+}
+
+std::future<Responses::GetTrytes>
+Core::getTrytesAsync(const std::vector<Types::Trytes>& hashes) const {
+  auto core = *this;
+  return service_.async([core, hashes] { return core.getTrytes(hashes); });
+}
+
+std::future<Responses::GetInclusionStates>
+Core::getInclusionStatesAsync(const std::vector<Types::Trytes>& transactions,
+                              const std::vector<Types::Trytes>& tips) const {
+  auto core = *this;
+  return service_.async(
+      [core, transactions, tips] { return core.getInclusionStates(transactions, tips); });
+}
+
+std::future<Responses::GetBalances>
+Core::getBalancesAsync(const std::vector<Models::Address>& addresses, const int& threshold,
+                       const std::vector<Types::Trytes>& tips) const {
+  auto core = *this;
+  return service_.async(
+      [core, addresses, threshold, tips] { return core.getBalances(addresses, threshold, tips); });
+}
+
+std::future<Responses::GetTransactionsToApprove>
+Core::getTransactionsToApproveAsync(const int& depth, const Types::Trytes& reference) const {
+  auto core = *this;
+  return service_.async(
+      [core, depth, reference] { return core.getTransactionsToApprove(depth, reference); });
+}
+
+std::future<Responses::Base>
+Core::broadcastTransactionsAsync(const std::vector<Types::Trytes>& trytes) const {
+  auto core = *this;
+  return service_.async([core, trytes] { return core.broadcastTransactions(trytes); });
+}
+
+std::future<Responses::Base>
+Core::storeTransactionsAsync(const std::vector<Types::Trytes>& trytes) const {
+  auto core = *this;
+  return service_.async([core, trytes] { return core.storeTransactions(trytes); });
+}
+
+std::future<Responses::WereAddressesSpentFrom>
+Core::wereAddressesSpentFromAsync(const std::vector<Models::Address>& addresses) const {
+  auto core = *this;
+  return service_.async([core, addresses] { return core.wereAddressesSpentFrom(addresses); });
+}
+
+std::future<Responses::CheckConsistency>
+Core::checkConsistencyAsync(const std::vector<Types::Trytes>& tails) const {
+  auto core = *this;
+  return service_.async([core, tails] { return core.checkConsistency(tails); });
+}
+
 }  // namespace API
 
 }  // namespace IOTA
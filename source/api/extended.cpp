@@ -23,7 +23,12 @@
 //
 //
 
+#include <functional>
+#include <future>
 #include <iostream>
+#include <numeric>
+#include <unordered_map>
+#include <unordered_set>
 
 #include <iota/api/extended.hpp>
 #include <iota/api/responses/attach_to_tangle.hpp>
@@ -34,17 +39,20 @@
 #include <iota/api/responses/get_balances_and_format.hpp>
 #include <iota/api/responses/get_bundle.hpp>
 #include <iota/api/responses/get_inclusion_states.hpp>
+#include <iota/api/responses/get_inputs_snapshot.hpp>
 #include <iota/api/responses/get_new_addresses.hpp>
 #include <iota/api/responses/get_node_info.hpp>
 #include <iota/api/responses/get_transactions_to_approve.hpp>
 #include <iota/api/responses/get_transfers.hpp>
 #include <iota/api/responses/get_trytes.hpp>
 #include <iota/api/responses/replay_bundle.hpp>
+#include <iota/api/responses/select_inputs.hpp>
 #include <iota/api/responses/send_transfer.hpp>
 #include <iota/api/responses/were_addresses_spent_from.hpp>
 #include <iota/crypto/curl.hpp>
 #include <iota/crypto/kerl.hpp>
 #include <iota/crypto/signing.hpp>
+#include <iota/errors/bad_request.hpp>
 #include <iota/errors/illegal_state.hpp>
 #include <iota/models/bundle.hpp>
 #include <iota/models/seed.hpp>
@@ -53,16 +61,158 @@
 #include <iota/models/transfer.hpp>
 #include <iota/types/trinary.hpp>
 #include <iota/types/utils.hpp>
-#include <iota/utils/parallel_for.hpp>
+#include <iota/utils/task_scheduler.hpp>
 
 namespace IOTA {
 
 namespace API {
 
+namespace {
+
+//! number of addresses derived at once when looking for the addresses of a seed
+const int32_t InputsDiscoveryWindow = 10;
+
+//! maximum number of subsets explored when minimizing the remainder of a selection
+const std::size_t MaxSelectionTries = 100000;
+
+//! bundles are prefetched by hash only when more transactions than this remain to be walked: the
+//! prefetch takes two round trips, walking the trunks takes one per transaction
+const int64_t MinPrefetchDepth = 2;
+
+//! the prefetch is given up, and trunks are walked, when the bundles have been reattached so much
+//! that they have more than this number of times the expected transactions
+const std::size_t MaxPrefetchRatio = 2;
+
+/**
+ * @return Indexes of the balances, largest first.
+ */
+std::vector<std::size_t>
+largestFirst(const std::vector<int64_t>& balances) {
+  std::vector<std::size_t> order(balances.size());
+
+  std::iota(order.begin(), order.end(), 0);
+  std::stable_sort(order.begin(), order.end(),
+                   [&](std::size_t lhs, std::size_t rhs) { return balances[lhs] > balances[rhs]; });
+
+  return order;
+}
+
+/**
+ * @return Indexes of the first balances, in order, reaching the value.
+ */
+std::vector<std::size_t>
+selectOldestFirst(const std::vector<int64_t>& balances, const int64_t& value) {
+  std::vector<std::size_t> selected;
+  int64_t                  total = 0;
+
+  for (std::size_t i = 0; i < balances.size() && total < value; ++i) {
+    selected.push_back(i);
+    total += balances[i];
+  }
+
+  return selected;
+}
+
+/**
+ * @return Indexes of the fewest balances reaching the value, with the lowest total for that count.
+ */
+std::vector<std::size_t>
+selectFewestInputs(const std::vector<int64_t>& balances, const int64_t& value) {
+  const auto               order = largestFirst(balances);
+  std::vector<std::size_t> selected;
+  int64_t                  total = 0;
+  std::size_t              k     = 0;
+
+  while (total < value) {
+    total += balances[order[k]];
+    selected.push_back(order[k++]);
+  }
+
+  //! the last input can be swapped for any smaller one still reaching the value
+  const int64_t missing = value - (total - balances[selected.back()]);
+
+  for (std::size_t j = k; j < order.size() && balances[order[j]] >= missing; ++j) {
+    selected.back() = order[j];
+  }
+
+  return selected;
+}
+
+/**
+ * Branch and bound over the balances, largest first, bounded by MaxSelectionTries.
+ *
+ * @return Indexes of the balances reaching the value with the lowest total, and then the fewest.
+ */
+std::vector<std::size_t>
+selectMinimizeRemainder(const std::vector<int64_t>& balances, const int64_t& value) {
+  const auto order = largestFirst(balances);
+
+  //! start from the fewest inputs selection, so that running out of tries still gives a good one
+  auto    best      = selectFewestInputs(balances, value);
+  int64_t bestTotal = 0;
+
+  for (const auto& i : best) {
+    bestTotal += balances[i];
+  }
+
+  //! sum of the balances not yet considered, to cut the branches that can not reach the value
+  std::vector<int64_t> remaining(order.size() + 1, 0);
+
+  for (std::size_t j = order.size(); j > 0; --j) {
+    remaining[j - 1] = remaining[j] + balances[order[j - 1]];
+  }
+
+  std::vector<std::size_t> current;
+  int64_t                  total = 0;
+  std::size_t              tries = 0;
+
+  std::function<void(std::size_t)> explore = [&](std::size_t j) {
+    if (bestTotal == value || ++tries > MaxSelectionTries) {
+      return;
+    }
+
+    if (total >= value) {
+      if (total < bestTotal || (total == bestTotal && current.size() < best.size())) {
+        best      = current;
+        bestTotal = total;
+      }
+
+      return;
+    }
+
+    if (j == order.size() || total + remaining[j] < value) {
+      return;
+    }
+
+    //! with this input, unless it already makes the total worse than the best one
+    if (total + balances[order[j]] <= bestTotal) {
+      current.push_back(order[j]);
+      total += balances[order[j]];
+      explore(j + 1);
+      total -= balances[order[j]];
+      current.pop_back();
+    }
+
+    //! without this input
+    explore(j + 1);
+  };
+
+  explore(0);
+
+  return best;
+}
+
+}  // namespace
+
 Extended::Extended(const std::string& host, const uint16_t& port, bool localPow, int timeout, const std::string& user, const std::string& pass)
     : Core(host, port, localPow, timeout, user, pass) {
 }
 
+Extended::Extended(const std::vector<Endpoint>& nodes, bool localPow, int timeout,
+                   const std::string& user, const std::string& pass)
+    : Core(nodes, localPow, timeout, user, pass) {
+}
+
 /*
  * Public methods.
  */
@@ -87,6 +237,149 @@ Extended::getInputs(const Models::Seed& seed, const int32_t& start, const int32_
   return res;
 }
 
+Responses::GetInputsSnapshot
+Extended::getInputsSnapshot(const Models::Seed& seed, const int32_t& start,
+                            const int32_t& end) const {
+  const Utils::StopWatch stopWatch;
+
+  if (start < 0 || (end != 0 && start > end)) {
+    throw Errors::IllegalState("Invalid inputs provided");
+  }
+
+  std::vector<Models::Address> addresses;
+  Models::Address              remainderAddress;
+
+  if (end != 0) {
+    addresses = getNewAddresses(seed, start, end - start, true).getAddresses();
+  } else {
+    //! derive addresses by windows, with a single request per window for each check
+    for (int32_t index = start; remainderAddress.empty(); index += InputsDiscoveryWindow) {
+      std::vector<Models::Address> window(InputsDiscoveryWindow);
+
+      Utils::TaskScheduler::getDefault().parallelFor(window.size(), [&](std::size_t i) {
+        window[i] = seed.newAddress(index + i);
+      });
+
+      const auto        spent = wereAddressesSpentFrom(window).getStates();
+      std::vector<char> used(window.size(), false);
+
+      //! only when some addresses of the window are used, find which ones, without their trytes
+      if (!findTransactions(window, {}, {}, {}).getHashes().empty()) {
+        std::vector<std::future<Responses::FindTransactions>> found(window.size());
+
+        for (std::size_t i = 0; i < window.size(); ++i) {
+          if (!spent[i]) {
+            found[i] = findTransactionsAsync({ window[i] }, {}, {}, {});
+          }
+        }
+
+        for (std::size_t i = 0; i < window.size(); ++i) {
+          used[i] = found[i].valid() && !found[i].get().getHashes().empty();
+        }
+      }
+
+      for (std::size_t i = 0; i < window.size(); ++i) {
+        //! the first address neither spent from nor used ends the addresses of the seed
+        if (!spent[i] && !used[i]) {
+          remainderAddress = window[i];
+          break;
+        }
+
+        addresses.push_back(std::move(window[i]));
+      }
+    }
+  }
+
+  std::vector<Models::Address> inputs;
+  int64_t                      totalBalance = 0;
+  std::vector<Types::Trytes>   references;
+  int64_t                      milestoneIndex = 0;
+
+  if (!addresses.empty()) {
+    //! a single request for all the addresses, so that all balances are read at the same milestone
+    const auto  res      = getBalances(addresses, GetBalancesRecommandedConfirmationThreshold);
+    const auto& balances = res.getBalances();
+
+    for (std::size_t i = 0; i < addresses.size(); ++i) {
+      int64_t balance = std::stoll(balances[i]);
+
+      if (balance <= 0) {
+        continue;
+      }
+
+      Models::Address input = addresses[i];
+      input.setBalance(balance);
+
+      inputs.push_back(std::move(input));
+      totalBalance += balance;
+    }
+
+    references     = res.getReferences();
+    milestoneIndex = res.getMilestoneIndex();
+  }
+
+  return { inputs,     totalBalance,   remainderAddress,
+           references, milestoneIndex, stopWatch.getElapsedTime().count() };
+}
+
+Responses::SelectInputs
+Extended::selectInputs(const Responses::GetInputsSnapshot& snapshot, const int64_t& value,
+                       InputStrategy strategy) {
+  const Utils::StopWatch stopWatch;
+
+  if (value > snapshot.getTotalBalance()) {
+    throw Errors::IllegalState("Not enough balance");
+  }
+
+  const auto&          funded = snapshot.getInputs();
+  std::vector<int64_t> balances;
+
+  for (const auto& input : funded) {
+    balances.push_back(input.getBalance());
+  }
+
+  std::vector<std::size_t> selected;
+
+  if (value > 0) {
+    switch (strategy) {
+      case InputStrategy::FewestInputs:
+        selected = selectFewestInputs(balances, value);
+        break;
+      case InputStrategy::MinimizeRemainder:
+        selected = selectMinimizeRemainder(balances, value);
+        break;
+      case InputStrategy::OldestFirst:
+        selected = selectOldestFirst(balances, value);
+        break;
+    }
+  }
+
+  //! keep the key index order of the snapshot
+  std::sort(selected.begin(), selected.end());
+
+  std::vector<Models::Address> inputs;
+  int64_t                      totalBalance = 0;
+
+  for (const auto& i : selected) {
+    inputs.push_back(funded[i]);
+    totalBalance += balances[i];
+  }
+
+  return { inputs,
+           totalBalance,
+           value,
+           snapshot.getRemainderAddress(),
+           snapshot.getReferences(),
+           snapshot.getMilestoneIndex(),
+           snapshot.getDuration() + stopWatch.getElapsedTime().count() };
+}
+
+Responses::SelectInputs
+Extended::selectInputs(const Models::Seed& seed, const int64_t& value,
+                       InputStrategy strategy) const {
+  return selectInputs(getInputsSnapshot(seed), value, strategy);
+}
+
 Responses::GetBalancesAndFormat
 Extended::getBalancesAndFormat(const std::vector<Models::Address>& addresses,
                                const int64_t&                      threshold) const {
@@ -143,9 +436,11 @@ Extended::getNewAddresses(const Models::Seed& seed, const uint32_t& index, const
   // Case 1 : total number of addresses to generate is supplied.
   // Simply generate and return the list of all addresses.
   if (total) {
-    for (uint32_t i = index; i < index + total; ++i) {
-      allAddresses.emplace_back(seed.newAddress(i));
-    }
+    allAddresses.resize(std::max(total, 0));
+
+    Utils::TaskScheduler::getDefault().parallelFor(allAddresses.size(), [&](std::size_t i) {
+      allAddresses[i] = seed.newAddress(index + i);
+    });
   }
   // Case 2 : no total provided.
   // Continue calling wereAddressesSpentFrom & findTransactions to see if address was already
@@ -193,84 +488,143 @@ Extended::traverseBundles(const std::vector<Types::Trytes>& trunkTrxs, bool thro
   //! init bundles to return
   std::vector<Models::Bundle> bundles(trunkTrxs.size(), Models::Bundle{});
 
-  //! convert to vector<ref_wrapper<bundle>>
-  std::vector<std::reference_wrapper<Models::Bundle>> bundlesRefs;
-  for (auto& bundle : bundles) {
-    bundlesRefs.push_back(std::ref(bundle));
-  }
-
-  traverseBundles(trunkTrxs, bundlesRefs, throwOnFail);
+  //! transactions fetched so far, by hash
+  std::unordered_map<Types::Trytes, Models::Transaction> fetched;
 
-  return bundles;
-}
+  //! next transaction to add to each bundle still being traversed: bundle index and trx hash
+  std::vector<std::pair<std::size_t, Types::Trytes>> frontier;
+  frontier.reserve(trunkTrxs.size());
 
-void
-Extended::traverseBundles(const std::vector<Types::Trytes>&                          trxs,
-                          const std::vector<std::reference_wrapper<Models::Bundle>>& bundles,
-                          bool throwOnFail) const {
-  //! nothing to fetch
-  if (trxs.empty()) {
-    return;
+  for (std::size_t i = 0; i < trunkTrxs.size(); ++i) {
+    frontier.emplace_back(i, trunkTrxs[i]);
   }
 
-  //! get trytes for non-empty transactions
-  const auto gtr = getTrytes(trxs);
+  bool prefetched = false;
 
-  //! If fail to get trytes, return error
-  if (gtr.getTrytes().empty()) {
-    throw Errors::IllegalState("Invalid transaction supplied.");
-  }
+  while (!frontier.empty()) {
+    //! get trytes of the frontier transactions that are not known yet, in a single request
+    std::vector<Types::Trytes>        missing;
+    std::unordered_set<Types::Trytes> missingSet;
 
-  //! keep track of which bundles need to be filled recursively
-  std::vector<Types::Trytes>                          trunkTrxs;
-  std::vector<std::reference_wrapper<Models::Bundle>> partialBundles;
+    for (const auto& next : frontier) {
+      if (!fetched.count(next.second) && missingSet.insert(next.second).second) {
+        missing.push_back(next.second);
+      }
+    }
 
-  //! process each tryte
-  for (std::size_t i = 0; i < gtr.getTrytes().size(); ++i) {
-    //! get transaction itself
-    const auto trx = Models::Transaction{ gtr.getTrytes()[i] };
+    if (!missing.empty()) {
+      const auto gtr = getTrytes(missing);
 
-    //! get bundle
-    auto& bundle = bundles[i].get();
+      //! If fail to get trytes, return error
+      if (gtr.getTrytes().size() != missing.size()) {
+        throw Errors::IllegalState("Invalid transaction supplied.");
+      }
 
-    //! If first transaction to search is not a tail, return error
-    if (bundle.getHash().empty() && !trx.isTailTransaction()) {
-      if (throwOnFail) {
-        throw Errors::IllegalState("Invalid tail transaction supplied.");
+      for (std::size_t i = 0; i < missing.size(); ++i) {
+        fetched.emplace(missing[i], Models::Transaction{ gtr.getTrytes()[i] });
       }
-      //! if we are in silent mode, we clear the bundle and continue
-      bundle = {};
-      continue;
     }
 
-    //! Detect infinite recursion
-    if (trx.getTrunkTransaction() == trx.getHash()) {
-      if (throwOnFail) {
-        throw Errors::IllegalState("Invalid transaction supplied.");
+    std::vector<std::pair<std::size_t, Types::Trytes>> nextFrontier;
+    std::vector<Types::Trytes>                         bundleHashes;
+    std::unordered_set<Types::Trytes>                  bundleHashesSet;
+    std::size_t                                        expected = 0;
+
+    //! process each transaction
+    for (const auto& next : frontier) {
+      const auto& trx    = fetched.at(next.second);
+      auto&       bundle = bundles[next.first];
+
+      //! If first transaction to search is not a tail, return error
+      if (bundle.getHash().empty() && !trx.isTailTransaction()) {
+        if (throwOnFail) {
+          throw Errors::IllegalState("Invalid tail transaction supplied.");
+        }
+        //! if we are in silent mode, we clear the bundle and continue
+        bundle = {};
+        continue;
       }
-      //! if we are in silent mode, we clear the bundle and continue
-      bundle = {};
-      continue;
-    }
 
-    //! If no bundle hash, define it
-    if (bundle.getHash().empty()) {
-      bundle.setHash(trx.getBundle());
-    }
+      //! Detect infinite loop
+      if (trx.getTrunkTransaction() == trx.getHash()) {
+        if (throwOnFail) {
+          throw Errors::IllegalState("Invalid transaction supplied.");
+        }
+        //! if we are in silent mode, we clear the bundle and continue
+        bundle = {};
+        continue;
+      }
+
+      //! If no bundle hash, define it
+      if (bundle.getHash().empty()) {
+        bundle.setHash(trx.getBundle());
+      }
+
+      //! transaction from another bundle, traversal is over
+      if (bundle.getHash() != trx.getBundle()) {
+        continue;
+      }
 
-    if (bundle.getHash() == trx.getBundle()) {
       //! Add transaction object to bundle
       bundle.addTransaction(trx);
 
-      //! keep track of which bundles need to be filled recursively
-      trunkTrxs.push_back(trx.getTrunkTransaction());
-      partialBundles.push_back(bundle);
-      continue;
+      //! last transaction of the bundle, its trunk belongs to another bundle
+      if (trx.getCurrentIndex() >= trx.getLastIndex()) {
+        continue;
+      }
+
+      //! keep track of which bundles need to be filled
+      nextFrontier.emplace_back(next.first, trx.getTrunkTransaction());
+
+      //! short bundles are cheaper to walk
+      if (!prefetched && trx.getLastIndex() - trx.getCurrentIndex() > MinPrefetchDepth &&
+          bundleHashesSet.insert(trx.getBundle()).second) {
+        bundleHashes.push_back(trx.getBundle());
+        expected += static_cast<std::size_t>(trx.getLastIndex() + 1);
+      }
+    }
+
+    //! once the tails are known, fetch all the members of the long bundles at once:
+    //! their remaining traversal is then done locally whatever their length
+    if (!prefetched && !bundleHashes.empty()) {
+      prefetchBundles(bundleHashes, expected, fetched);
     }
+
+    prefetched = true;
+    frontier.swap(nextFrontier);
   }
 
-  //! Continue traversing with new trunkTx
-  traverseBundles(trunkTrxs, partialBundles, throwOnFail);
+  return bundles;
+}
+
+void
+Extended::prefetchBundles(const std::vector<Types::Trytes>&                       bundleHashes,
+                          std::size_t                                             expected,
+                          std::unordered_map<Types::Trytes, Models::Transaction>& fetched) const {
+  const auto res = findTransactions({}, {}, {}, bundleHashes);
+
+  //! reattachments are found too: fetching all of them would cost more than walking the trunks
+  if (res.getHashes().size() > expected * MaxPrefetchRatio) {
+    return;
+  }
+
+  std::vector<Types::Trytes> hashes;
+
+  for (const auto& hash : res.getHashes()) {
+    if (!fetched.count(hash)) {
+      hashes.push_back(hash);
+    }
+  }
+
+  if (hashes.empty()) {
+    return;
+  }
+
+  const auto gtr = getTrytes(hashes);
+
+  for (std::size_t i = 0; i < hashes.size() && i < gtr.getTrytes().size(); ++i) {
+    fetched.emplace(hashes[i], Models::Transaction{ gtr.getTrytes()[i], hashes[i] });
+  }
 }
 
 std::vector<Models::Transaction>
@@ -279,6 +633,14 @@ Extended::findTransactionObjects(const std::vector<Models::Address>& addresses)
   return getTransactionsObjects(findTransactions(addresses, {}, {}, {}).getHashes());
 }
 
+void
+Extended::findTransactionObjects(
+    const std::vector<Models::Address>&                    addresses,
+    const std::function<void(const Models::Transaction&)>& callback) const {
+  //! stream the transaction objects of the transactions
+  getTransactionsObjects(findTransactions(addresses, {}, {}, {}).getHashes(), callback);
+}
+
 std::vector<Models::Transaction>
 Extended::findTransactionObjectsByBundle(const std::vector<Types::Trytes>& input) const {
   // check hashes format
@@ -299,76 +661,99 @@ Extended::getTransactionsObjects(const std::vector<Types::Trytes>& hashes) const
     throw Errors::IllegalState("getTransactionsObjects parameter is not a valid array of hashes");
   }
 
-  //! get trytes forhashes
-  const auto trytesResponse = getTrytes(hashes);
-
-  //! build response
+  //! build response while the reply is parsed
   std::vector<Models::Transaction> trxs;
+  trxs.reserve(hashes.size());
 
-  for (const auto& tryte : trytesResponse.getTrytes()) {
-    trxs.emplace_back(tryte);
-  }
+  getTrytes(hashes, [&trxs](const Types::Trytes& trytes) { trxs.emplace_back(trytes); });
 
   return trxs;
 }
 
+void
+Extended::getTransactionsObjects(
+    const std::vector<Types::Trytes>&                      hashes,
+    const std::function<void(const Models::Transaction&)>& callback) const {
+  if (!Types::isArrayOfHashes(hashes)) {
+    throw Errors::IllegalState("getTransactionsObjects parameter is not a valid array of hashes");
+  }
+
+  getTrytes(hashes, [&callback](const Types::Trytes& trytes) {
+    Models::Transaction trx{ trytes };
+    callback(trx);
+  });
+}
+
 std::vector<Models::Bundle>
 Extended::bundlesFromAddresses(const std::vector<Models::Address>& addresses,
                                bool                                withInclusionStates) const {
   //! find transactions for addresses
-  const auto trxs = findTransactionObjects(addresses);
+  return bundlesFromTransactions(findTransactionObjects(addresses), withInclusionStates);
+}
+
+std::vector<Models::Bundle>
+Extended::bundlesFromTransactions(const std::vector<Models::Transaction>& trxs,
+                                  bool withInclusionStates) const {
+  std::vector<Models::Bundle> rejected;
+
+  return bundlesFromTransactions(trxs, withInclusionStates, rejected);
+}
+
+std::vector<Models::Bundle>
+Extended::bundlesFromTransactions(const std::vector<Models::Transaction>& trxs,
+                                  bool                                    withInclusionStates,
+                                  std::vector<Models::Bundle>&            rejected) const {
+  rejected.clear();
+
   if (trxs.empty())
     return {};
 
-  //! filter tail/non tail transactions
-  std::vector<Models::Transaction> tailTrxs;
-  std::vector<Models::Transaction> nonTailTrxs;
+  //! group the transactions by bundle hash, only keeping the indexes of their distinct tails
+  std::unordered_map<Types::Trytes, std::vector<std::size_t>> tailsByBundle;
+  std::unordered_set<Types::Trytes>                           tailsHashes;
+  std::vector<Types::Trytes>                                  bundlesHashes;
 
-  for (const auto& trx : trxs) {
-    if (trx.isTailTransaction()) {
-      tailTrxs.emplace_back(trx);
-    } else {
-      nonTailTrxs.emplace_back(trx);
+  for (std::size_t i = 0; i < trxs.size(); ++i) {
+    const auto& trx   = trxs[i];
+    auto        group = tailsByBundle.find(trx.getBundle());
+
+    if (group == tailsByBundle.end()) {
+      group = tailsByBundle.emplace(trx.getBundle(), std::vector<std::size_t>{}).first;
+      bundlesHashes.push_back(trx.getBundle());
+    }
+
+    if (trx.isTailTransaction() && tailsHashes.insert(trx.getHash()).second) {
+      group->second.push_back(i);
     }
   }
 
-  //! filter out non-tail transactions for which we already got the bundle tail transaction
-  //! only keep bundle hash to pass that as argument of findTransactionObjectsByBundle
+  //! tail transactions hashes, in order of appearance of their bundle
+  //! bundles for which we only got non-tail transactions are fetched with
+  //! findTransactionObjectsByBundle
+  std::vector<Types::Trytes> tailTrxsHashes;
   std::vector<Types::Trytes> nonTailTrxsBundleHashes;
+  tailTrxsHashes.reserve(tailsHashes.size());
 
-  for (const auto& trx : nonTailTrxs) {
-    //! skip if we already filtered a non-tail transaction belonging to the same bundle
-    auto nonTailDuplicateBundle =
-        std::find(nonTailTrxsBundleHashes.begin(), nonTailTrxsBundleHashes.end(), trx.getBundle());
+  for (const auto& bundleHash : bundlesHashes) {
+    const auto& tails = tailsByBundle[bundleHash];
 
-    if (nonTailDuplicateBundle != nonTailTrxsBundleHashes.end()) {
-      continue;
+    if (tails.empty()) {
+      nonTailTrxsBundleHashes.push_back(bundleHash);
     }
 
-    //! skip if we already got a tail transaction fro that bundle
-    auto tailDuplicateBundle = std::find_if(
-        tailTrxs.begin(), tailTrxs.end(),
-        [&](const Models::Transaction& lhs) { return lhs.getBundle() == trx.getBundle(); });
-
-    if (tailDuplicateBundle != tailTrxs.end()) {
-      continue;
+    for (const auto& i : tails) {
+      tailTrxsHashes.push_back(trxs[i].getHash());
     }
-
-    //! otherwise keep track to fetch bundle with findTransactionObjectsByBundle
-    nonTailTrxsBundleHashes.push_back(trx.getBundle());
   }
 
   //! find transactions for bundles of non tail transactions
-  //! add these transactions to the list of tail transactions
-  const auto trxFromBundle = findTransactionObjectsByBundle(nonTailTrxsBundleHashes);
-  tailTrxs.insert(tailTrxs.end(), trxFromBundle.begin(), trxFromBundle.end());
-
-  //! keep only hash
-  std::vector<Types::Trytes> tailTrxsHashes;
-  tailTrxsHashes.reserve(tailTrxs.size());
-
-  for (const auto& trx : tailTrxs) {
-    tailTrxsHashes.emplace_back(trx.getHash());
+  //! add their tails to the list of tail transactions
+  if (!nonTailTrxsBundleHashes.empty()) {
+    for (const auto& trx : findTransactionObjectsByBundle(nonTailTrxsBundleHashes)) {
+      if (trx.isTailTransaction() && tailsHashes.insert(trx.getHash()).second) {
+        tailTrxsHashes.push_back(trx.getHash());
+      }
+    }
   }
 
   //! If inclusionStates, get the confirmation status
@@ -382,49 +767,43 @@ Extended::bundlesFromAddresses(const std::vector<Models::Address>& addresses,
     }
   }
 
-  std::mutex                  allBundlesMtx;
-  std::vector<Models::Bundle> allBundles;
-
-  std::size_t nb_cores   = std::thread::hardware_concurrency();
-  std::size_t nb_threads = std::min(nb_cores, tailTrxsHashes.size());
+  //! traverse all the bundles at once: the number of requests does not depend on their count
+  auto bundles = traverseBundles(tailTrxsHashes, false);
 
-  Utils::parallel_for(nb_threads, [&](int cpu, int num_cpus) {
-    int start = tailTrxsHashes.size() * cpu / num_cpus;
-    int end   = tailTrxsHashes.size() * (cpu + 1) / num_cpus;
+  if (withInclusionStates) {
+    for (std::size_t i = 0; i < bundles.size(); ++i) {
+      bool inclusion = inclusionStates.getStates()[i];
 
-    //! for last cpu, ensure we got all remaining of the list
-    if (cpu == num_cpus - 1) {
-      end = tailTrxsHashes.size();
+      for (auto& trx : bundles[i].getTransactions()) {
+        trx.setPersistence(inclusion);
+      }
     }
+  }
 
-    auto startIt = tailTrxsHashes.begin() + start;
-    auto endIt   = tailTrxsHashes.begin() + end;
-    auto bundles = traverseBundles({ startIt, endIt }, false);
+  //! only keep valid non-empty bundles, verified in parallel
+  std::vector<char> valid(bundles.size(), false);
 
-    if (withInclusionStates) {
-      for (std::size_t i = 0; i < bundles.size(); ++i) {
-        auto& trxs      = bundles[i].getTransactions();
-        bool  inclusion = inclusionStates.getStates()[start + i];
+  Utils::TaskScheduler::getDefault().parallelFor(bundles.size(), [&](std::size_t i) {
+    if (bundles[i].getTransactions().empty()) {
+      return;
+    }
 
-        for (auto& t : trxs) {
-          t.setPersistence(inclusion);
-        }
-      }
+    try {
+      verifyBundle(bundles[i]);
+      valid[i] = true;
+    } catch (const std::runtime_error&) {
     }
+  });
 
-    std::lock_guard<std::mutex> lock(allBundlesMtx);
+  std::vector<Models::Bundle> allBundles;
 
-    //! only keep valid non-empty bundles
-    for (auto& bundle : bundles) {
-      if (!bundle.getTransactions().empty()) {
-        try {
-          verifyBundle(bundle);
-          allBundles.push_back(std::move(bundle));
-        } catch (std::runtime_error&) {
-        }
-      }
+  for (std::size_t i = 0; i < bundles.size(); ++i) {
+    if (valid[i]) {
+      allBundles.push_back(std::move(bundles[i]));
+    } else if (!bundles[i].getTransactions().empty()) {
+      rejected.push_back(std::move(bundles[i]));
     }
-  });
+  }
 
   std::sort(allBundles.begin(), allBundles.end());
 
@@ -433,7 +812,7 @@ Extended::bundlesFromAddresses(const std::vector<Models::Address>& addresses,
 
 Responses::GetInclusionStates
 Extended::getLatestInclusion(const std::vector<Types::Trytes>& hashes) const {
-  return getInclusionStates(hashes, { getNodeInfo().getLatestSolidSubtangleMilestone() });
+  return getInclusionStates(hashes, { getCachedNodeInfo().getLatestSolidSubtangleMilestone() });
 }
 
 std::vector<Types::Trytes>
@@ -459,19 +838,12 @@ Extended::prepareTransfers(const Models::Seed& seed, const std::vector<Models::T
       // Get total length, message / maxLength (2187 trytes)
       signatureMessageLength += (int)std::floor(transfer.getMessage().length() / MaxTrxMsgLength);
 
-      Types::Trytes msgCopy = transfer.getMessage();
-
-      // While there is still a message, copy it
-      while (!msgCopy.empty()) {
-        Types::Trytes fragment = msgCopy.substr(0, MaxTrxMsgLength);
-
-        if (msgCopy.length() > MaxTrxMsgLength) {
-          msgCopy = msgCopy.substr(MaxTrxMsgLength, msgCopy.length());
-        } else {
-          msgCopy = "";
-        }
+      const auto& message = transfer.getMessage();
 
-        signatureFragments.push_back(Types::Utils::rightPad(fragment, MaxTrxMsgLength, '9'));
+      // Copy the message fragment by fragment
+      for (std::size_t offset = 0; offset < message.length(); offset += MaxTrxMsgLength) {
+        signatureFragments.push_back(
+            Types::Utils::rightPad(message.substr(offset, MaxTrxMsgLength), MaxTrxMsgLength, '9'));
       }
     } else {
       // Else, get single fragment with 2187 of 9's trytes
@@ -560,6 +932,27 @@ Extended::prepareTransfers(const Models::Seed& seed, const std::vector<Models::T
   }
 }
 
+std::vector<Types::Trytes>
+Extended::prepareTransfers(const Models::Seed&                  seed,
+                           const std::vector<Models::Transfer>& transfers,
+                           const Responses::SelectInputs&       selection,
+                           const Models::Address&               remainder) const {
+  int64_t totalValue = 0;
+
+  for (const auto& transfer : transfers) {
+    totalValue += transfer.getValue();
+  }
+
+  if (totalValue > selection.getTotalBalance()) {
+    throw Errors::IllegalState("Not enough balance");
+  }
+
+  //! balances of the selection were already read: no need to request them again
+  return prepareTransfers(seed, transfers,
+                          remainder.empty() ? selection.getRemainderAddress() : remainder,
+                          selection.getInputs(), false);
+}
+
 Responses::GetBundle
 Extended::getBundle(const Types::Trytes& transaction) const {
   const Utils::StopWatch stopWatch;
@@ -640,14 +1033,14 @@ Extended::verifyBundle(const Models::Bundle& bundle) {
     throw Errors::IllegalState("Invalid Bundle");
 
   //! Validate the signatures
-  for (const auto& signature : signaturesToValidate) {
-    const auto& addr  = signature.getAddress();
-    const auto& frags = signature.getSignatureFragments();
+  Utils::TaskScheduler::getDefault().parallelFor(signaturesToValidate.size(), [&](std::size_t i) {
+    const auto& addr  = signaturesToValidate[i].getAddress();
+    const auto& frags = signaturesToValidate[i].getSignatureFragments();
 
     if (!Crypto::Signing::validateSignatures(addr, frags, bundleHash)) {
       throw Errors::IllegalState("Invalid Signature");
     }
-  }
+  });
 }
 
 Responses::GetTransfers
@@ -857,21 +1250,12 @@ Extended::initiateTransfer(const Models::Address&               inputAddress,
       //! Get total length, message / maxLength (MaxTrxMsgLength trytes)
       signatureMessageLength += (int)std::floor(transfer.getMessage().length() / MaxTrxMsgLength);
 
-      //! copy msg
-      Types::Trytes msgCopy = transfer.getMessage();
-
-      //! While there is still a message, copy it
-      while (!msgCopy.empty()) {
-        Types::Trytes fragment = msgCopy.substr(0, MaxTrxMsgLength);
+      const auto& message = transfer.getMessage();
 
-        if (msgCopy.length() > MaxTrxMsgLength) {
-          msgCopy = msgCopy.substr(MaxTrxMsgLength, msgCopy.length());
-        } else {
-          msgCopy = "";
-        }
-
-        // Pad remainder of fragment
-        signatureFragments.push_back(Types::Utils::rightPad(fragment, MaxTrxMsgLength, '9'));
+      //! Copy the message fragment by fragment, padding the last one
+      for (std::size_t offset = 0; offset < message.length(); offset += MaxTrxMsgLength) {
+        signatureFragments.push_back(
+            Types::Utils::rightPad(message.substr(offset, MaxTrxMsgLength), MaxTrxMsgLength, '9'));
       }
     } else {
       //! Else, get single fragment with MaxTrxMsgLength of 9's trytes
@@ -954,6 +1338,86 @@ Extended::isPromotable(const Types::Trytes& tail) const {
   return false;
 }
 
+std::vector<bool>
+Extended::isPromotable(const std::vector<Types::Trytes>& tails) const {
+  //! invalid hashes are not promotable, the others are checked once
+  std::unordered_map<Types::Trytes, std::size_t> indexes;
+  std::vector<Types::Trytes>                     distinctTails;
+
+  for (const auto& tail : tails) {
+    if (Types::isValidHash(tail) && indexes.emplace(tail, distinctTails.size()).second) {
+      distinctTails.push_back(tail);
+    }
+  }
+
+  std::vector<char> promotable(distinctTails.size(), true);
+
+  auto chunkSize = getMaxItemsPerRequest();
+  if (chunkSize == 0 || chunkSize > distinctTails.size()) {
+    chunkSize = std::max<std::size_t>(distinctTails.size(), 1);
+  }
+
+  const auto chunks = (distinctTails.size() + chunkSize - 1) / chunkSize;
+
+  //! requests, not cpu-bound work: run them on the workers of the service, like chunked requests
+  getService().getWorkerPool().parallelFor(chunks, [&](std::size_t i) {
+    checkConsistencyBisect(distinctTails, i * chunkSize,
+                           std::min(distinctTails.size(), (i + 1) * chunkSize), promotable);
+  });
+
+  std::vector<bool> results;
+  results.reserve(tails.size());
+
+  for (const auto& tail : tails) {
+    auto index = indexes.find(tail);
+    results.push_back(index != indexes.end() && promotable[index->second]);
+  }
+
+  return results;
+}
+
+std::vector<Extended::TailState>
+Extended::getTailStates(const std::vector<Types::Trytes>& tails) const {
+  if (tails.empty()) {
+    return {};
+  }
+
+  if (!Types::isArrayOfHashes(tails)) {
+    throw Errors::IllegalState("Invalid tail transaction");
+  }
+
+  const auto  inclusionStates = getLatestInclusion(tails);
+  const auto& states          = inclusionStates.getStates();
+
+  if (states.size() != tails.size()) {
+    throw Errors::IllegalState("No inclusion states");
+  }
+
+  //! only check the consistency of the tails which are not confirmed
+  std::vector<Types::Trytes> pending;
+
+  for (std::size_t i = 0; i < tails.size(); ++i) {
+    if (!states[i]) {
+      pending.push_back(tails[i]);
+    }
+  }
+
+  const auto promotable = isPromotable(pending);
+
+  std::vector<TailState> results;
+  results.reserve(tails.size());
+
+  for (std::size_t i = 0, j = 0; i < tails.size(); ++i) {
+    if (states[i]) {
+      results.push_back(TailState::Confirmed);
+    } else {
+      results.push_back(promotable[j++] ? TailState::Promotable : TailState::Reattachable);
+    }
+  }
+
+  return results;
+}
+
 Responses::SendTransfer
 Extended::promoteTransaction(const Types::Trytes& tail, int depth, int minWeightMagnitude,
                              std::vector<Models::Transfer>& transfers, int delay,
@@ -981,57 +1445,125 @@ Extended::promoteTransaction(const Types::Trytes& tail, int depth, int minWeight
 
 std::vector<bool>
 Extended::isReattachable(const std::vector<Models::Address>& addresses) {
-  std::map<Types::Trytes, std::vector<Types::Trytes>> addressTxsMap;
-  std::vector<Types::Trytes>                          valueTransactions;
+  return isReattachable(std::vector<std::vector<Models::Address>>{ addresses }).front();
+}
 
-  auto trxs = findTransactionObjects(addresses);
-  for (const auto& trx : trxs) {
-    if (trx.getValue() < 0) {
-      addressTxsMap[trx.getAddress().toTrytes()].push_back(trx.getHash());
-      valueTransactions.push_back(trx.getHash());
+std::vector<std::vector<bool>>
+Extended::isReattachable(const std::vector<std::vector<Models::Address>>& addresses) const {
+  //! distinct addresses of all the sets, indexed by their trytes
+  std::unordered_map<Types::Trytes, std::size_t> addressesIndexes;
+  std::vector<Models::Address>                   distinctAddresses;
+
+  for (const auto& set : addresses) {
+    for (const auto& address : set) {
+      if (addressesIndexes.emplace(address.toTrytes(), distinctAddresses.size()).second) {
+        distinctAddresses.push_back(address);
+      }
     }
   }
 
-  if (!valueTransactions.empty()) {
-    //! get the includion states of all the transactions
-    auto inclusionStates = getLatestInclusion(valueTransactions);
-    auto results         = std::vector<bool>{};
+  //! an address is reattachable until one of its spending transactions is confirmed
+  std::vector<char> reattachable(distinctAddresses.size(), true);
 
-    for (const auto& address : addresses) {
-      const auto& trxs = addressTxsMap[address.toTrytes()];
+  if (!distinctAddresses.empty()) {
+    const auto hashes = findTransactions(distinctAddresses, {}, {}, {}).getHashes();
 
-      if (trxs.empty()) {
-        results.push_back(true);
-        continue;
-      }
+    //! only keep the spending transactions, reading nothing else than their address and value
+    std::vector<Types::Trytes> spendingTrxs;
+    std::vector<std::size_t>   spendingAddresses;
+    std::size_t                i = 0;
 
-      bool shouldReattach = true;
-      for (const auto& trx : trxs) {
-        auto txIndex =
-            std::distance(valueTransactions.begin(),
-                          std::find(valueTransactions.begin(), valueTransactions.end(), trx));
-        auto isConfirmed = inclusionStates.getStates()[txIndex];
+    if (!hashes.empty()) {
+      getTrytes(hashes, [&](const Types::Trytes& trytes) {
+        if (i == hashes.size()) {
+          return;
+        }
 
-        //! if tx confirmed, break
-        if (isConfirmed) {
-          shouldReattach = false;
-          break;
+        const auto& hash = hashes[i++];
+
+        if (Models::Transaction::valueFromTrytes(trytes) >= 0) {
+          return;
+        }
+
+        auto address = addressesIndexes.find(Models::Transaction::addressFromTrytes(trytes));
+
+        if (address != addressesIndexes.end()) {
+          spendingTrxs.push_back(hash);
+          spendingAddresses.push_back(address->second);
         }
+      });
+    }
+
+    if (!spendingTrxs.empty()) {
+      //! get the inclusion states of all the spending transactions at once
+      const auto  inclusionStates = getLatestInclusion(spendingTrxs);
+      const auto& states          = inclusionStates.getStates();
+
+      if (states.size() != spendingTrxs.size()) {
+        throw Errors::IllegalState("No inclusion states");
       }
 
-      results.push_back(shouldReattach);
+      for (std::size_t j = 0; j < spendingTrxs.size(); ++j) {
+        if (states[j]) {
+          reattachable[spendingAddresses[j]] = false;
+        }
+      }
     }
+  }
 
-    return results;
-  } else {
-    return std::vector<bool>(addresses.size(), true);
+  //! dispatch the results back to each set
+  std::vector<std::vector<bool>> results;
+  results.reserve(addresses.size());
+
+  for (const auto& set : addresses) {
+    std::vector<bool> setResults;
+    setResults.reserve(set.size());
+
+    for (const auto& address : set) {
+      setResults.push_back(reattachable[addressesIndexes[address.toTrytes()]]);
+    }
+
+    results.push_back(std::move(setResults));
   }
+
+  return results;
 }
 
 /*
  * Private methods.
  */
 
+void
+Extended::checkConsistencyBisect(const std::vector<Types::Trytes>& tails, std::size_t first,
+                                 std::size_t last, std::vector<char>& promotable) const {
+  if (first == last) {
+    return;
+  }
+
+  bool consistent = false;
+
+  try {
+    consistent =
+        checkConsistency(std::vector<Types::Trytes>(tails.begin() + first, tails.begin() + last))
+            .getState();
+  } catch (const IOTA::Errors::BadRequest&) {
+    //! one of the tails is rejected (not a tail, unknown...)
+  }
+
+  if (consistent) {
+    return;
+  }
+
+  if (last - first == 1) {
+    promotable[first] = false;
+    return;
+  }
+
+  const auto middle = first + (last - first) / 2;
+  checkConsistencyBisect(tails, first, middle, promotable);
+  checkConsistencyBisect(tails, middle, last, promotable);
+}
+
 bool
 Extended::isTransfersCollectionValid(const std::vector<Models::Transfer>& transfers) {
   for (const auto& transfer : transfers) {
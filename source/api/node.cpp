@@ -0,0 +1,154 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/api/node.hpp>
+#include <iota/constants.hpp>
+#include <iota/errors/network.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+constexpr double Node::Smoothing;
+
+const std::chrono::microseconds Node::PriorLatency = std::chrono::milliseconds(200);
+
+Node::Node(const Endpoint& endpoint, int timeout, const std::string& user, const std::string& pass)
+    : url_(endpoint.host + ":" + std::to_string(endpoint.port)),
+      sessions_([this, timeout, user, pass] {
+        std::unique_ptr<cpr::Session> session(new cpr::Session);
+
+        session->SetUrl(cpr::Url{ url_ });
+        session->SetTimeout(cpr::Timeout{ timeout * 1000 });
+        if (!user.empty() && !pass.empty() && url_.compare(0, 5, "https") == 0) {
+          session->SetAuth(cpr::Authentication{ user, pass });
+        }
+
+        return session;
+      }),
+      failureLatency_(std::max(timeout, 0) * 1000000.0),
+      latency_(PriorLatency.count()),
+      measured_(false),
+      errorRate_(0),
+      inFlight_(0) {
+}
+
+cpr::Response
+Node::post(const std::string& body, const cpr::Header& headers) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    ++inFlight_;
+  }
+
+  auto start   = std::chrono::steady_clock::now();
+  auto session = sessions_.acquire();
+
+  auto header = headers;
+  header["Content-Type"]       = "application/json";
+  header["Content-Length"]     = std::to_string(body.size());
+  header["X-IOTA-API-Version"] = APIVersion;
+
+  session->SetHeader(header);
+  session->SetBody(cpr::Body{ body });
+
+  auto res     = session->Post();
+  auto latency = std::chrono::duration_cast<std::chrono::microseconds>(
+      std::chrono::steady_clock::now() - start);
+  bool failed  = res.error.code != cpr::ErrorCode::OK;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    --inFlight_;
+    record(latency.count(), failed);
+  }
+
+  if (failed) {
+    //! do not reuse a session whose connection may be broken
+    session.discard();
+    throw Errors::Network(res.error.message);
+  }
+
+  return res;
+}
+
+void
+Node::recordFailure() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  record(0, true);
+}
+
+void
+Node::record(double latency, bool failed) {
+  //! a failure costs the caller the time to fail over, at least the timeout
+  if (failed) {
+    latency = std::max(latency, failureLatency_);
+  }
+
+  latency_   = measured_ ? (1 - Smoothing) * latency_ + Smoothing * latency : latency;
+  measured_  = true;
+  errorRate_ = (1 - Smoothing) * errorRate_ + (failed ? Smoothing : 0);
+}
+
+double
+Node::getScore() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  //! an error rate of 10% doubles the cost of a node
+  return latency_ * (inFlight_ + 1) * (1 + 10 * errorRate_);
+}
+
+std::chrono::microseconds
+Node::getLatency() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return std::chrono::microseconds(static_cast<int64_t>(latency_));
+}
+
+double
+Node::getErrorRate() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return errorRate_;
+}
+
+int
+Node::getInFlight() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return inFlight_;
+}
+
+const std::string&
+Node::getUrl() const {
+  return url_;
+}
+
+SessionPool&
+Node::getSessionPool() {
+  return sessions_;
+}
+
+}  // namespace API
+
+}  // namespace IOTA
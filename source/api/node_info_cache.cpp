@@ -0,0 +1,160 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/api/node_info_cache.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+const std::chrono::milliseconds NodeInfoCache::DefaultTtl = std::chrono::milliseconds(1000);
+
+NodeInfoCache::NodeInfoCache(const std::chrono::milliseconds& ttl)
+    : ttl_(ttl), stopping_(false) {
+}
+
+NodeInfoCache::~NodeInfoCache() {
+  stopRefresh();
+}
+
+Responses::GetNodeInfo
+NodeInfoCache::get(const Fetch& fetch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  if (info_ && std::chrono::steady_clock::now() - updated_ < ttl_) {
+    return *info_;
+  }
+
+  //! a request is already running: use its response
+  std::shared_ptr<const Fetched> fetched = fetching_;
+
+  if (fetched) {
+    cv_.wait(lock, [&] { return fetched->done; });
+  } else {
+    fetched = this->fetch(lock, fetch);
+  }
+
+  if (fetched->error) {
+    std::rethrow_exception(fetched->error);
+  }
+
+  return *fetched->info;
+}
+
+void
+NodeInfoCache::invalidate() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  info_ = nullptr;
+}
+
+void
+NodeInfoCache::startRefresh(const Fetch& fetch) {
+  stopRefresh();
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  stopping_  = false;
+  refresher_ = std::thread(&NodeInfoCache::refresh, this, fetch);
+}
+
+void
+NodeInfoCache::stopRefresh() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+
+  cv_.notify_all();
+
+  if (refresher_.joinable()) {
+    refresher_.join();
+  }
+}
+
+std::chrono::milliseconds
+NodeInfoCache::getTtl() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return ttl_;
+}
+
+void
+NodeInfoCache::setTtl(const std::chrono::milliseconds& ttl) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  ttl_ = ttl;
+}
+
+std::shared_ptr<const NodeInfoCache::Fetched>
+NodeInfoCache::fetch(std::unique_lock<std::mutex>& lock, const Fetch& fetch) {
+  auto fetched = std::make_shared<Fetched>();
+  fetching_    = fetched;
+  lock.unlock();
+
+  std::shared_ptr<const Responses::GetNodeInfo> info;
+  std::exception_ptr                            error;
+
+  try {
+    info = std::make_shared<const Responses::GetNodeInfo>(fetch());
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  lock.lock();
+
+  //! a failed fetch keeps the previous node info, which is still expired
+  if (info) {
+    info_    = info;
+    updated_ = std::chrono::steady_clock::now();
+  }
+
+  //! waiters read this result, whatever happens to the cached node info in the meantime
+  fetched->info  = info;
+  fetched->error = error;
+  fetched->done  = true;
+  fetching_      = nullptr;
+  cv_.notify_all();
+
+  return fetched;
+}
+
+void
+NodeInfoCache::refresh(Fetch fetch) {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  while (!stopping_) {
+    if (!fetching_) {
+      this->fetch(lock, fetch);
+    }
+
+    //! refresh twice per ttl, so that the node info never expires
+    auto period = std::max(ttl_ / 2, std::chrono::milliseconds(1));
+
+    cv_.wait_for(lock, period, [this] { return stopping_; });
+  }
+}
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,415 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+#include <set>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/portfolio.hpp>
+#include <iota/api/responses/find_transactions.hpp>
+#include <iota/api/responses/get_balances.hpp>
+#include <iota/api/responses/get_inclusion_states.hpp>
+#include <iota/api/responses/were_addresses_spent_from.hpp>
+#include <iota/constants.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/bundle.hpp>
+#include <iota/utils/stop_watch.hpp>
+#include <iota/utils/task_scheduler.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+const std::size_t Portfolio::DefaultDiscoveryWindow;
+
+Portfolio::Portfolio(const Extended& api) : api_(api), discoveryWindow_(DefaultDiscoveryWindow) {
+}
+
+std::shared_ptr<Account>
+Portfolio::addAccount(const Models::Seed& seed) {
+  accounts_.push_back(std::make_shared<Account>(api_, seed));
+  return accounts_.back();
+}
+
+const std::vector<std::shared_ptr<Account>>&
+Portfolio::getAccounts() const {
+  return accounts_;
+}
+
+std::vector<Responses::GetAccountData>
+Portfolio::refresh() {
+  std::vector<Account*> accounts;
+
+  for (const auto& account : accounts_) {
+    accounts.push_back(account.get());
+  }
+
+  return sync(api_, accounts, discoveryWindow_);
+}
+
+std::size_t
+Portfolio::getDiscoveryWindow() const {
+  return discoveryWindow_;
+}
+
+void
+Portfolio::setDiscoveryWindow(std::size_t window) {
+  if (window == 0) {
+    throw Errors::IllegalState("Discovery window can not be empty");
+  }
+
+  discoveryWindow_ = window;
+}
+
+std::vector<Responses::GetAccountData>
+Portfolio::sync(const Extended& api, const std::vector<Account*>& accounts,
+                std::size_t discoveryWindow) {
+  const Utils::StopWatch stopWatch;
+
+  //! serialize with the other refreshes of the same accounts, locking in a fixed order
+  std::vector<Account*> ordered(accounts);
+  std::sort(ordered.begin(), ordered.end());
+  ordered.erase(std::unique(ordered.begin(), ordered.end()), ordered.end());
+
+  std::vector<std::unique_lock<std::mutex>> refreshLocks;
+  std::vector<Sync>                         syncs;
+  Owners                                    owners;
+
+  for (std::size_t i = 0; i < ordered.size(); ++i) {
+    auto account = ordered[i];
+
+    refreshLocks.emplace_back(account->refreshMutex_);
+
+    std::lock_guard<std::mutex> lock(account->mutex_);
+    syncs.push_back({ account, account->addresses_.empty(), {} });
+
+    for (const auto& address : account->addresses_) {
+      owners[address.toTrytes()].push_back(i);
+    }
+  }
+
+  Transactions fetched;
+
+  //! bundles known so far: new ones get their inclusion state when fetched
+  updateInclusionStates(api, syncs);
+  scanAddresses(api, syncs, owners, fetched);
+  discoverAddresses(api, syncs, owners, fetched, std::max<std::size_t>(discoveryWindow, 1));
+  updateBundles(api, syncs, owners, fetched);
+  updateBalances(api, syncs);
+
+  std::vector<Responses::GetAccountData> res;
+  res.reserve(accounts.size());
+
+  for (auto account : accounts) {
+    std::lock_guard<std::mutex> lock(account->mutex_);
+    res.push_back(account->buildData(stopWatch.getElapsedTime().count()));
+  }
+
+  return res;
+}
+
+void
+Portfolio::updateInclusionStates(const Extended& api, std::vector<Sync>& syncs) {
+  std::vector<Types::Trytes>                                  tails;
+  std::unordered_map<Types::Trytes, std::vector<std::size_t>> pending;
+
+  for (std::size_t i = 0; i < syncs.size(); ++i) {
+    std::lock_guard<std::mutex> lock(syncs[i].account->mutex_);
+
+    for (const auto& bundle : syncs[i].account->bundles_) {
+      if (bundle.second[0].getPersistence()) {
+        continue;
+      }
+
+      auto& accounts = pending[bundle.first];
+
+      if (accounts.empty()) {
+        tails.push_back(bundle.first);
+      }
+
+      accounts.push_back(i);
+    }
+  }
+
+  if (tails.empty()) {
+    return;
+  }
+
+  const auto res = api.getLatestInclusion(tails);
+
+  for (std::size_t i = 0; i < tails.size() && i < res.getStates().size(); ++i) {
+    if (!res.getStates()[i]) {
+      continue;
+    }
+
+    for (auto index : pending[tails[i]]) {
+      auto&                       sync = syncs[index];
+      std::lock_guard<std::mutex> lock(sync.account->mutex_);
+
+      for (auto& trx : sync.account->bundles_[tails[i]].getTransactions()) {
+        trx.setPersistence(true);
+        sync.touched.insert(trx.getAddress().toTrytes());
+      }
+    }
+  }
+}
+
+void
+Portfolio::scanAddresses(const Extended& api, std::vector<Sync>& syncs, const Owners& owners,
+                         Transactions& fetched) {
+  std::vector<Models::Address> addresses;
+
+  for (const auto& sync : syncs) {
+    std::lock_guard<std::mutex> lock(sync.account->mutex_);
+    addresses.insert(addresses.end(), sync.account->addresses_.begin(),
+                     sync.account->addresses_.end());
+  }
+
+  if (addresses.empty()) {
+    return;
+  }
+
+  const auto                        res = api.findTransactions(addresses, {}, {}, {});
+  std::unordered_set<Types::Trytes> candidates(res.getHashes().begin(), res.getHashes().end());
+
+  //! walk the known transactions rather than copying them
+  for (const auto& sync : syncs) {
+    std::lock_guard<std::mutex> lock(sync.account->mutex_);
+
+    for (const auto& hash : sync.account->knownTransactions_) {
+      candidates.erase(hash);
+    }
+  }
+
+  fetch(api, { candidates.begin(), candidates.end() }, fetched);
+
+  //! accounts whose last address got transactions need new addresses
+  for (const auto& trx : fetched) {
+    auto it = owners.find(trx.second.getAddress().toTrytes());
+
+    if (it == owners.end()) {
+      continue;
+    }
+
+    for (auto index : it->second) {
+      auto&                       sync = syncs[index];
+      std::lock_guard<std::mutex> lock(sync.account->mutex_);
+
+      sync.discover |= sync.account->addresses_.back() == trx.second.getAddress();
+    }
+  }
+}
+
+void
+Portfolio::discoverAddresses(const Extended& api, std::vector<Sync>& syncs, Owners& owners,
+                             Transactions& fetched, std::size_t window) {
+  for (;;) {
+    std::vector<std::size_t> discovering;
+    std::vector<std::size_t> first;
+
+    for (std::size_t i = 0; i < syncs.size(); ++i) {
+      if (syncs[i].discover) {
+        std::lock_guard<std::mutex> lock(syncs[i].account->mutex_);
+
+        discovering.push_back(i);
+        first.push_back(syncs[i].account->addresses_.size());
+      }
+    }
+
+    if (discovering.empty()) {
+      return;
+    }
+
+    //! next addresses of all the accounts, derived in parallel
+    std::vector<Models::Address> addresses(discovering.size() * window);
+
+    Utils::TaskScheduler::getDefault().parallelFor(addresses.size(), [&](std::size_t i) {
+      const auto& seed = syncs[discovering[i / window]].account->seed_;
+      addresses[i]     = seed.newAddress(first[i / window] + i % window);
+    });
+
+    const auto spent  = api.wereAddressesSpentFrom(addresses).getStates();
+    const auto hashes = api.findTransactions(addresses, {}, {}, {}).getHashes();
+
+    std::vector<Types::Trytes> missing;
+
+    for (const auto& hash : hashes) {
+      if (!fetched.count(hash)) {
+        missing.push_back(hash);
+      }
+    }
+
+    fetch(api, missing, fetched);
+
+    std::unordered_set<Types::Trytes> used;
+
+    for (const auto& hash : hashes) {
+      auto it = fetched.find(hash);
+
+      if (it != fetched.end()) {
+        used.insert(it->second.getAddress().toTrytes());
+      }
+    }
+
+    //! keep the addresses up to the first one neither spent nor with transactions
+    for (std::size_t k = 0; k < discovering.size(); ++k) {
+      auto&                       sync = syncs[discovering[k]];
+      std::lock_guard<std::mutex> lock(sync.account->mutex_);
+
+      for (std::size_t i = k * window; i < (k + 1) * window; ++i) {
+        const auto& address = addresses[i].toTrytes();
+
+        sync.account->addresses_.push_back(addresses[i]);
+        sync.touched.insert(address);
+        owners[address].push_back(discovering[k]);
+
+        if ((i >= spent.size() || !spent[i]) && !used.count(address)) {
+          sync.discover = false;
+          break;
+        }
+      }
+    }
+  }
+}
+
+void
+Portfolio::updateBundles(const Extended& api, std::vector<Sync>& syncs, const Owners& owners,
+                         const Transactions& fetched) {
+  if (fetched.empty()) {
+    return;
+  }
+
+  std::vector<Models::Transaction> trxs;
+  trxs.reserve(fetched.size());
+
+  for (const auto& trx : fetched) {
+    trxs.push_back(trx.second);
+  }
+
+  //! bundles shared by several accounts are only built once
+  std::vector<Models::Bundle> rejected;
+  auto                        bundles = api.bundlesFromTransactions(trxs, true, rejected);
+
+  std::unordered_set<Types::Trytes> bundleHashes;
+
+  for (const auto& bundle : bundles) {
+    std::set<std::size_t> accounts;
+
+    bundleHashes.insert(bundle.getHash());
+
+    for (const auto& trx : bundle.getTransactions()) {
+      auto it = owners.find(trx.getAddress().toTrytes());
+
+      if (it != owners.end()) {
+        accounts.insert(it->second.begin(), it->second.end());
+      }
+    }
+
+    for (auto index : accounts) {
+      auto&                       sync = syncs[index];
+      std::lock_guard<std::mutex> lock(sync.account->mutex_);
+
+      if (bundle[0].getPersistence()) {
+        for (const auto& trx : bundle.getTransactions()) {
+          sync.touched.insert(trx.getAddress().toTrytes());
+        }
+      }
+
+      sync.account->bundles_[bundle[0].getHash()] = bundle;
+    }
+  }
+
+  //! a transaction of an invalid bundle is invalid for good: never fetch it again
+  std::unordered_set<Types::Trytes> rejectedTrxs;
+
+  for (const auto& bundle : rejected) {
+    for (const auto& trx : bundle.getTransactions()) {
+      rejectedTrxs.insert(trx.getHash());
+    }
+  }
+
+  //! transactions of bundles that could not be read are looked at again on the next refresh
+  for (const auto& trx : trxs) {
+    auto it = owners.find(trx.getAddress().toTrytes());
+
+    if (it == owners.end() ||
+        (!bundleHashes.count(trx.getBundle()) && !rejectedTrxs.count(trx.getHash()))) {
+      continue;
+    }
+
+    for (auto index : it->second) {
+      std::lock_guard<std::mutex> lock(syncs[index].account->mutex_);
+      syncs[index].account->knownTransactions_.insert(trx.getHash());
+    }
+  }
+}
+
+void
+Portfolio::updateBalances(const Extended& api, std::vector<Sync>& syncs) {
+  std::vector<Models::Address>                     addresses;
+  std::vector<std::pair<std::size_t, std::size_t>> targets;
+
+  for (std::size_t i = 0; i < syncs.size(); ++i) {
+    std::lock_guard<std::mutex> lock(syncs[i].account->mutex_);
+    const auto&                 accountAddresses = syncs[i].account->addresses_;
+
+    for (std::size_t j = 0; j < accountAddresses.size(); ++j) {
+      if (syncs[i].touched.count(accountAddresses[j].toTrytes())) {
+        addresses.push_back(accountAddresses[j]);
+        targets.emplace_back(i, j);
+      }
+    }
+  }
+
+  if (addresses.empty()) {
+    return;
+  }
+
+  const auto balances =
+      api.getBalances(addresses, GetBalancesRecommandedConfirmationThreshold).getBalances();
+
+  for (std::size_t i = 0; i < targets.size() && i < balances.size(); ++i) {
+    auto&                       account = *syncs[targets[i].first].account;
+    std::lock_guard<std::mutex> lock(account.mutex_);
+
+    account.addresses_[targets[i].second].setBalance(std::stoll(balances[i]));
+  }
+}
+
+void
+Portfolio::fetch(const Extended& api, const std::vector<Types::Trytes>& hashes,
+                 Transactions& fetched) {
+  if (hashes.empty()) {
+    return;
+  }
+
+  api.getTransactionsObjects(hashes, [&fetched](const Models::Transaction& trx) {
+    fetched.emplace(trx.getHash(), trx);
+  });
+}
+
+}  // namespace API
+
+}  // namespace IOTA
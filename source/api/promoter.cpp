@@ -0,0 +1,392 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/promoter.hpp>
+#include <iota/api/responses/get_bundle.hpp>
+#include <iota/api/responses/get_inclusion_states.hpp>
+#include <iota/constants.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/seed.hpp>
+#include <iota/models/transaction.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+const std::chrono::milliseconds Promoter::DefaultInterval   = std::chrono::milliseconds(30000);
+const std::chrono::milliseconds Promoter::DefaultResolution = std::chrono::milliseconds(1000);
+const std::size_t               Promoter::DefaultPowCapacity;
+const std::size_t               Promoter::WheelSize;
+
+Promoter::Promoter(const Extended& api, int depth, int minWeightMagnitude)
+    : api_(api),
+      depth_(depth),
+      minWeightMagnitude_(minWeightMagnitude),
+      wheel_(WheelSize),
+      now_(0),
+      interval_(DefaultInterval),
+      resolution_(DefaultResolution),
+      promotionTransfer_(Models::Address(EmptyHash), 0, "", Models::Tag{}),
+      pool_(DefaultPowCapacity),
+      stopping_(false) {
+}
+
+Promoter::~Promoter() {
+  stop();
+}
+
+void
+Promoter::track(const Types::Trytes& tail, const Callback& callback) {
+  if (!Types::isValidHash(tail)) {
+    throw Errors::IllegalState("Invalid tail transaction");
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (entries_.count(tail)) {
+    return;
+  }
+
+  auto newEntry = std::make_shared<Entry>(Entry{ { tail }, callback, 0, true });
+  entries_.emplace(tail, newEntry);
+  schedule(newEntry, 1);
+}
+
+bool
+Promoter::untrack(const Types::Trytes& tail) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto entry = entries_.find(tail);
+
+  if (entry == entries_.end()) {
+    return false;
+  }
+
+  //! the wheel drops untracked bundles when their slot comes
+  entry->second->tracked = false;
+  entries_.erase(entry);
+
+  return true;
+}
+
+std::size_t
+Promoter::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return entries_.size();
+}
+
+void
+Promoter::start() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (thread_.joinable()) {
+    return;
+  }
+
+  stopping_ = false;
+  thread_   = std::thread(&Promoter::run, this);
+}
+
+void
+Promoter::stop() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+
+  cv_.notify_all();
+
+  if (thread_.joinable()) {
+    thread_.join();
+  }
+}
+
+void
+Promoter::tick() {
+  std::lock_guard<std::mutex> tickLock(tickMutex_);
+
+  //! take the bundles which are due, the others of the slot wait for the next rounds
+  std::vector<std::shared_ptr<Entry>> due;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto& slot = wheel_[++now_ % WheelSize];
+    auto  it   = std::partition(slot.begin(), slot.end(), [&](const std::shared_ptr<Entry>& entry) {
+      return entry->tracked && entry->due > now_;
+    });
+
+    for (auto dueEntry = it; dueEntry != slot.end(); ++dueEntry) {
+      if ((*dueEntry)->tracked) {
+        due.push_back(std::move(*dueEntry));
+      }
+    }
+
+    slot.erase(it, slot.end());
+  }
+
+  if (due.empty()) {
+    return;
+  }
+
+  //! check the inclusion of all the tails of all the bundles at once
+  std::vector<Types::Trytes> tails;
+
+  for (const auto& entry : due) {
+    tails.insert(tails.end(), entry->tails.begin(), entry->tails.end());
+  }
+
+  std::vector<bool> states;
+
+  try {
+    states = api_.getLatestInclusion(tails).getStates();
+
+    if (states.size() != tails.size()) {
+      throw Errors::IllegalState("No inclusion states");
+    }
+  } catch (const std::exception&) {
+    fail(due, std::current_exception());
+    return;
+  }
+
+  //! report confirmed bundles, keep the others
+  std::vector<std::shared_ptr<Entry>> pending;
+  std::size_t                         offset = 0;
+
+  for (const auto& entry : due) {
+    auto first = states.begin() + offset;
+    auto last  = first + entry->tails.size();
+    auto state = std::find(first, last, true);
+    offset += entry->tails.size();
+
+    if (state == last) {
+      pending.push_back(entry);
+      continue;
+    }
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      if (entry->tracked) {
+        entry->tracked = false;
+        entries_.erase(entry->tails.front());
+      }
+    }
+
+    entry->callback(entry->tails.front(), Event::Confirmed, entry->tails[state - first], nullptr);
+  }
+
+  //! check the consistency of the latest tail of the others at once
+  std::vector<Types::Trytes> latestTails;
+  std::vector<bool>          promotable;
+
+  for (const auto& entry : pending) {
+    latestTails.push_back(entry->tails.back());
+  }
+
+  try {
+    promotable = api_.isPromotable(latestTails);
+  } catch (const std::exception&) {
+    fail(pending, std::current_exception());
+    return;
+  }
+
+  //! promote or reattach them, sharing the pow capacity
+  pool_.parallelFor(pending.size(), [&](std::size_t i) { step(*pending[i], promotable[i]); });
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (const auto& entry : pending) {
+    schedule(entry, getIntervalTicks());
+  }
+}
+
+void
+Promoter::step(Entry& entry, bool promotable) {
+  const auto& tail = entry.tails.back();
+
+  try {
+    std::vector<Models::Transaction> trxs;
+    Event                            event;
+
+    if (promotable) {
+      //! promote: send the promotion transfer on top of the tail
+      std::vector<Models::Transfer> transfers;
+
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        transfers.push_back(promotionTransfer_);
+      }
+
+      //! no input is needed for a zero-value transfer: the seed is not used
+      const auto trytes = api_.prepareTransfers(Models::Seed{ EmptyHash }, transfers,
+                                                Models::Address{}, {}, false);
+
+      trxs  = api_.sendTrytes(trytes, depth_, minWeightMagnitude_, tail);
+      event = Event::Promoted;
+    } else {
+      //! reattach: send the bundle again, the new tail is tracked along the previous ones
+      std::vector<Types::Trytes> trytes;
+
+      const auto  bundle     = api_.getBundle(tail);
+      const auto& bundleTrxs = bundle.getTransactions();
+
+      //! attachToTangle expects the last transaction of the bundle first
+      for (auto trx = bundleTrxs.rbegin(); trx != bundleTrxs.rend(); ++trx) {
+        trytes.emplace_back(trx->toTrytes());
+      }
+
+      trxs  = api_.sendTrytes(trytes, depth_, minWeightMagnitude_);
+      event = Event::Reattached;
+    }
+
+    auto newTail = std::find_if(trxs.begin(), trxs.end(), [](const Models::Transaction& trx) {
+      return trx.isTailTransaction();
+    });
+
+    if (newTail == trxs.end()) {
+      throw Errors::IllegalState("Invalid tail transaction");
+    }
+
+    if (event == Event::Reattached) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      entry.tails.push_back(newTail->getHash());
+    }
+
+    entry.callback(entry.tails.front(), event, newTail->getHash(), nullptr);
+  } catch (const std::exception&) {
+    entry.callback(entry.tails.front(), Event::Failed, "", std::current_exception());
+  }
+}
+
+void
+Promoter::fail(const std::vector<std::shared_ptr<Entry>>& entries,
+               const std::exception_ptr&                  error) {
+  for (const auto& entry : entries) {
+    entry->callback(entry->tails.front(), Event::Failed, "", error);
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  for (const auto& entry : entries) {
+    schedule(entry, getIntervalTicks());
+  }
+}
+
+void
+Promoter::schedule(const std::shared_ptr<Entry>& entry, std::size_t ticks) {
+  if (!entry->tracked) {
+    return;
+  }
+
+  entry->due = now_ + std::max<std::size_t>(ticks, 1);
+  wheel_[entry->due % WheelSize].push_back(entry);
+}
+
+std::size_t
+Promoter::getIntervalTicks() const {
+  return (interval_.count() + resolution_.count() - 1) / resolution_.count();
+}
+
+void
+Promoter::run() {
+  std::unique_lock<std::mutex> lock(mutex_);
+  auto                         next = std::chrono::steady_clock::now();
+
+  while (!stopping_) {
+    //! ticks late because of a long tick are caught up right away
+    next += resolution_;
+
+    if (cv_.wait_until(lock, next, [this] { return stopping_; })) {
+      break;
+    }
+
+    lock.unlock();
+    tick();
+    lock.lock();
+  }
+}
+
+std::chrono::milliseconds
+Promoter::getInterval() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return interval_;
+}
+
+void
+Promoter::setInterval(const std::chrono::milliseconds& interval) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  interval_ = interval;
+}
+
+std::chrono::milliseconds
+Promoter::getResolution() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return resolution_;
+}
+
+void
+Promoter::setResolution(const std::chrono::milliseconds& resolution) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (thread_.joinable()) {
+    throw Errors::IllegalState("Promoter already started");
+  }
+
+  if (resolution.count() <= 0) {
+    throw Errors::IllegalState("Promoter resolution can not be null");
+  }
+
+  resolution_ = resolution;
+}
+
+std::size_t
+Promoter::getPowCapacity() const {
+  return pool_.getSize();
+}
+
+void
+Promoter::setPowCapacity(std::size_t capacity) {
+  pool_.setSize(capacity);
+}
+
+Models::Transfer
+Promoter::getPromotionTransfer() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return promotionTransfer_;
+}
+
+void
+Promoter::setPromotionTransfer(const Models::Transfer& transfer) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  promotionTransfer_ = transfer;
+}
+
+}  // namespace API
+
+}  // namespace IOTA
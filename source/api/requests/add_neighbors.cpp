@@ -43,6 +43,12 @@ AddNeighbors::serialize(json& data) const {
   data["uris"] = uris_;
 }
 
+void
+AddNeighbors::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.key("uris").value(uris_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
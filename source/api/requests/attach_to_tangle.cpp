@@ -53,6 +53,15 @@ AttachToTangle::serialize(json& data) const {
   data["trytes"]             = trytes_;
 }
 
+void
+AttachToTangle::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.key("trunkTransaction").value(trunkTransaction_);
+  writer.key("branchTransaction").value(branchTransaction_);
+  writer.key("minWeightMagnitude").value(minWeightMagnitude_);
+  writer.key("trytes").value(trytes_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -43,6 +43,12 @@ BroadcastTransactions::serialize(json& data) const {
   data["trytes"] = trytes_;
 }
 
+void
+BroadcastTransactions::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.key("trytes").value(trytes_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -43,6 +43,12 @@ CheckConsistency::serialize(json& data) const {
   data["tails"] = tails_;
 }
 
+void
+CheckConsistency::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.key("tails").value(tails_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
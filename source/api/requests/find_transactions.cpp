@@ -69,6 +69,34 @@ FindTransactions::serialize(json& data) const {
   }
 }
 
+void
+FindTransactions::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  if (!addresses_.empty()) {
+    writer.key("addresses").startArray();
+    for (const auto& address : addresses_) {
+      writer.value(address.toTrytes());
+    }
+    writer.endArray();
+  }
+
+  if (!tags_.empty()) {
+    writer.key("tags").startArray();
+    for (const auto& tag : tags_) {
+      writer.value(tag.toTrytesWithPadding());
+    }
+    writer.endArray();
+  }
+
+  if (!approvees_.empty()) {
+    writer.key("approvees").value(approvees_);
+  }
+
+  if (!bundles_.empty()) {
+    writer.key("bundles").value(bundles_);
+  }
+}
+
 }  // namespace Requests
 
 }  // namespace API
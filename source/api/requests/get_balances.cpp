@@ -51,6 +51,22 @@ GetBalances::serialize(json& data) const {
   }
 }
 
+void
+GetBalances::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  if (!addresses_.empty()) {
+    writer.key("addresses").startArray();
+    for (const auto& address : addresses_) {
+      writer.value(address.toTrytes());
+    }
+    writer.endArray();
+  }
+  writer.key("threshold").value(threshold_);
+  if (!tips_.empty()) {
+    writer.key("tips").value(tips_);
+  }
+}
+
 }  // namespace Requests
 
 }  // namespace API
@@ -46,6 +46,13 @@ GetInclusionStates::serialize(json& data) const {
   data["tips"]         = tips_;
 }
 
+void
+GetInclusionStates::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.key("transactions").value(transactions_);
+  writer.key("tips").value(tips_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
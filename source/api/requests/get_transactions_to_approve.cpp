@@ -45,6 +45,14 @@ GetTransactionsToApprove::serialize(json& data) const {
     data["reference"] = reference_;
 }
 
+void
+GetTransactionsToApprove::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.key("depth").value(depth_);
+  if (!reference_.empty())
+    writer.key("reference").value(reference_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
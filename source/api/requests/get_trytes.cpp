@@ -43,6 +43,12 @@ GetTrytes::serialize(json& data) const {
   data["hashes"] = hashes_;
 }
 
+void
+GetTrytes::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.key("hashes").value(hashes_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
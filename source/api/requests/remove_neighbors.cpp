@@ -43,6 +43,12 @@ RemoveNeighbors::serialize(json& data) const {
   data["uris"] = uris_;
 }
 
+void
+RemoveNeighbors::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.key("uris").value(uris_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
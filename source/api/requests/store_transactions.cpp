@@ -43,6 +43,12 @@ StoreTransactions::serialize(json& data) const {
   data["trytes"] = trytes_;
 }
 
+void
+StoreTransactions::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  writer.key("trytes").value(trytes_);
+}
+
 }  // namespace Requests
 
 }  // namespace API
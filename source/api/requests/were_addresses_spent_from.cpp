@@ -46,6 +46,18 @@ WereAddressesSpentFrom::serialize(json& data) const {
   }
 }
 
+void
+WereAddressesSpentFrom::serialize(Utils::JsonWriter& writer) const {
+  Base::serialize(writer);
+  if (!addresses_.empty()) {
+    writer.key("addresses").startArray();
+    for (const auto& address : addresses_) {
+      writer.value(address.toTrytes());
+    }
+    writer.endArray();
+  }
+}
+
 }  // namespace Requests
 
 }  // namespace API
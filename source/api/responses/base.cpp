@@ -47,6 +47,11 @@ Base::deserialize(const json& res) {
   }
 }
 
+void
+Base::bind(Utils::JsonFieldsHandler& handler) {
+  handler.bindInteger("duration", [this](int64_t duration) { duration_ = duration; });
+}
+
 const int64_t&
 Base::getDuration() const {
   return duration_;
@@ -49,6 +49,14 @@ FindTransactions::deserialize(const json& res) {
   }
 }
 
+void
+FindTransactions::bind(Utils::JsonFieldsHandler& handler) {
+  Base::bind(handler);
+  handler.bindStrings("hashes", [this](std::string& hash) {
+    hashes_.emplace_back(std::move(hash));
+  });
+}
+
 const std::vector<Types::Trytes>&
 FindTransactions::getHashes() const {
   return hashes_;
@@ -69,6 +69,19 @@ GetBalances::deserialize(const json& res) {
   }
 }
 
+void
+GetBalances::bind(Utils::JsonFieldsHandler& handler) {
+  Base::bind(handler);
+  handler.bindStrings("balances", [this](std::string& balance) {
+    balances_.emplace_back(std::move(balance));
+  });
+  handler.bindStrings("references", [this](std::string& reference) {
+    references_.emplace_back(std::move(reference));
+  });
+  handler.bindString("milestone", [this](std::string& milestone) { milestone_.swap(milestone); });
+  handler.bindInteger("milestoneIndex", [this](int64_t index) { milestoneIndex_ = index; });
+}
+
 const std::vector<std::string>&
 GetBalances::getBalances() const {
   return balances_;
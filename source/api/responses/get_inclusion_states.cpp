@@ -49,6 +49,12 @@ GetInclusionStates::deserialize(const json& res) {
   }
 }
 
+void
+GetInclusionStates::bind(Utils::JsonFieldsHandler& handler) {
+  Base::bind(handler);
+  handler.bindBools("states", [this](bool state) { states_.push_back(state); });
+}
+
 const std::vector<bool>&
 GetInclusionStates::getStates() const {
   return states_;
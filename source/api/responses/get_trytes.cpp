@@ -49,6 +49,14 @@ GetTrytes::deserialize(const json& res) {
   }
 }
 
+void
+GetTrytes::bind(Utils::JsonFieldsHandler& handler) {
+  Base::bind(handler);
+  handler.bindStrings("trytes", [this](std::string& trytes) {
+    trytes_.emplace_back(std::move(trytes));
+  });
+}
+
 const std::vector<Types::Trytes>&
 GetTrytes::getTrytes() const {
   return trytes_;
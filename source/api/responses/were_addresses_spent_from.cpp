@@ -49,6 +49,12 @@ WereAddressesSpentFrom::deserialize(const json& res) {
   }
 }
 
+void
+WereAddressesSpentFrom::bind(Utils::JsonFieldsHandler& handler) {
+  Base::bind(handler);
+  handler.bindBools("states", [this](bool state) { states_.push_back(state); });
+}
+
 const std::vector<bool>&
 WereAddressesSpentFrom::getStates() const {
   return states_;
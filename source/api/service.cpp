@@ -23,14 +23,378 @@
 //
 //
 
+#include <algorithm>
+#include <condition_variable>
+#include <random>
+#include <set>
+#include <string>
+
 #include <iota/api/service.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/utils/compression.hpp>
 
 namespace IOTA {
 
 namespace API {
 
+const std::size_t Service::DefaultMaxAttempts;
+const std::size_t Service::DefaultHedgeWorkers;
+
 Service::Service(const std::string& host, const uint16_t& port, int timeout, const std::string& user, const std::string& pass)
-    : host_(host), port_(port), timeout_(timeout), user_(user), pass_(pass) {
+    : Service(std::vector<Endpoint>{ { host, port } }, timeout, user, pass) {
+}
+
+Service::Service(const std::vector<Endpoint>& nodes, int timeout, const std::string& user,
+                 const std::string& pass)
+    : timeout_(timeout),
+      maxAttempts_(DefaultMaxAttempts),
+      hedgeDelay_(0),
+      acceptCompression_(Utils::isCompressionSupported()),
+      compressRequestsAbove_(0),
+      workers_(std::make_shared<Utils::WorkerPool>()),
+      hedgeWorkers_(std::make_shared<Utils::WorkerPool>(DefaultHedgeWorkers)),
+      metrics_(std::make_shared<ServiceMetrics>()) {
+  if (nodes.empty()) {
+    throw Errors::IllegalState("No node provided");
+  }
+
+  for (const auto& node : nodes) {
+    nodes_.push_back(std::make_shared<Node>(node, timeout, user, pass));
+  }
+}
+
+const std::vector<std::shared_ptr<Node>>&
+Service::getNodes() const {
+  return nodes_;
+}
+
+std::size_t
+Service::getMaxAttempts() const {
+  return maxAttempts_;
+}
+
+void
+Service::setMaxAttempts(std::size_t maxAttempts) {
+  maxAttempts_ = std::max<std::size_t>(maxAttempts, 1);
+}
+
+std::chrono::milliseconds
+Service::getHedgeDelay() const {
+  return hedgeDelay_;
+}
+
+void
+Service::setHedgeDelay(const std::chrono::milliseconds& hedgeDelay) {
+  hedgeDelay_ = hedgeDelay;
+}
+
+bool
+Service::getAcceptCompression() const {
+  return acceptCompression_;
+}
+
+void
+Service::setAcceptCompression(bool accept) {
+  if (accept && !Utils::isCompressionSupported()) {
+    throw Errors::IllegalState("Compression is not supported: built without zlib");
+  }
+
+  acceptCompression_ = accept;
+}
+
+std::size_t
+Service::getCompressRequestsAbove() const {
+  return compressRequestsAbove_;
+}
+
+void
+Service::setCompressRequestsAbove(std::size_t size) {
+  if (size && !Utils::isCompressionSupported()) {
+    throw Errors::IllegalState("Compression is not supported: built without zlib");
+  }
+
+  compressRequestsAbove_ = size;
+}
+
+Utils::WorkerPool&
+Service::getWorkerPool() const {
+  return *workers_;
+}
+
+Utils::WorkerPool&
+Service::getHedgeWorkerPool() const {
+  return *hedgeWorkers_;
+}
+
+ServiceMetrics&
+Service::getMetrics() const {
+  return *metrics_;
+}
+
+std::string
+Service::serialize(const Requests::Base& request) {
+  Utils::JsonWriter writer;
+
+  writer.startObject();
+  request.serialize(writer);
+  writer.endObject();
+
+  return writer.str();
+}
+
+bool
+Service::isIdempotent(const std::string& command) {
+  static const std::set<std::string> commands = { "getNodeInfo",
+                                                  "getNeighbors",
+                                                  "getTips",
+                                                  "findTransactions",
+                                                  "getTrytes",
+                                                  "getInclusionStates",
+                                                  "getBalances",
+                                                  "getTransactionsToApprove",
+                                                  "wereAddressesSpentFrom",
+                                                  "checkConsistency" };
+
+  return commands.count(command);
+}
+
+std::shared_ptr<Node>
+Service::pick(const std::vector<std::shared_ptr<Node>>& tried) const {
+  std::vector<std::shared_ptr<Node>> candidates;
+
+  for (const auto& node : nodes_) {
+    if (std::find(tried.begin(), tried.end(), node) == tried.end()) {
+      candidates.push_back(node);
+    }
+  }
+
+  if (candidates.size() <= 1) {
+    return candidates.empty() ? nullptr : candidates.front();
+  }
+
+  //! power of two choices: almost as good as picking the best node, without herding on it
+  static thread_local std::minstd_rand generator{ std::random_device{}() };
+  std::uniform_int_distribution<std::size_t> distribution(0, candidates.size() - 1);
+
+  auto first  = distribution(generator);
+  auto second = distribution(generator);
+  while (second == first) {
+    second = distribution(generator);
+  }
+
+  return candidates[first]->getScore() <= candidates[second]->getScore() ? candidates[first]
+                                                                          : candidates[second];
+}
+
+cpr::Response
+Service::send(const Requests::Base& request, ServiceMetrics::Sample& sample) const {
+  using std::chrono::duration_cast;
+  using std::chrono::microseconds;
+  using std::chrono::steady_clock;
+
+  cpr::Header headers;
+  auto        start = steady_clock::now();
+  auto        body  = serialize(request);
+
+  if (compressRequestsAbove_ && body.size() > compressRequestsAbove_) {
+    body                        = Utils::gzip(body);
+    headers["Content-Encoding"] = "gzip";
+  }
+
+  if (acceptCompression_) {
+    headers["Accept-Encoding"] = "gzip, deflate";
+  }
+
+  auto sent = steady_clock::now();
+
+  sample.serializeTime = duration_cast<microseconds>(sent - start);
+  sample.requestBytes  = body.size();
+
+  cpr::Response res;
+
+  try {
+    res = post(body, headers, isIdempotent(request.getCommand()), sample.attempts);
+  } catch (...) {
+    sample.networkTime = duration_cast<microseconds>(steady_clock::now() - sent);
+    throw;
+  }
+
+  auto received = steady_clock::now();
+
+  sample.networkTime   = duration_cast<microseconds>(received - sent);
+  sample.responseBytes = res.text.size();
+
+  auto encoding   = res.header.find("Content-Encoding");
+  auto first      = res.text.find_first_not_of(" \t\r\n");
+  bool compressed = encoding != res.header.end() &&
+                    (encoding->second == "gzip" || encoding->second == "deflate");
+
+  //! the body may already have been decoded by curl: json starts with '{' or '['
+  if (compressed && first != std::string::npos && res.text[first] != '{' &&
+      res.text[first] != '[') {
+    res.text         = Utils::inflate(res.text);
+    sample.parseTime = duration_cast<microseconds>(steady_clock::now() - received);
+  }
+
+  return res;
+}
+
+cpr::Response
+Service::post(const std::string& body, const cpr::Header& headers, bool idempotent,
+              std::size_t& attempts) const {
+  std::vector<std::shared_ptr<Node>> tried;
+  std::exception_ptr                 error;
+  auto maxAttempts = idempotent ? std::min(maxAttempts_, nodes_.size()) : 1;
+
+  while (tried.size() < maxAttempts) {
+    auto node = pick(tried);
+    tried.push_back(node);
+
+    try {
+      auto res = idempotent && hedgeDelay_.count() > 0 && tried.size() < maxAttempts
+                     ? hedge(node, body, headers, tried)
+                     : node->post(body, headers);
+      attempts = tried.size();
+
+      //! unavailable node, or gateway in front of it
+      bool unavailable =
+          res.status_code == 502 || res.status_code == 503 || res.status_code == 504;
+
+      if (!unavailable || tried.size() >= maxAttempts) {
+        return res;
+      }
+
+      node->recordFailure();
+    } catch (const Errors::Network&) {
+      attempts = tried.size();
+      error    = std::current_exception();
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+
+  throw Errors::Network("No node available");
+}
+
+cpr::Response
+Service::hedge(const std::shared_ptr<Node>& node, const std::string& body,
+               const cpr::Header& headers, std::vector<std::shared_ptr<Node>>& tried) const {
+  //! shared with the tasks sending the requests, which may outlive this call
+  struct Race {
+    std::mutex              mutex;
+    std::condition_variable cv;
+    int                     pending = 0;
+    bool                    done    = false;
+    cpr::Response           res;
+    std::exception_ptr      error;
+  };
+
+  auto race = std::make_shared<Race>();
+  auto send = [this, &race, &body, &headers](const std::shared_ptr<Node>& target) {
+    ++race->pending;
+
+    //! the pool waits for the requests in flight when the last copy of the service is destroyed
+    hedgeWorkers_->submit([race, body, headers, target] {
+      cpr::Response      res;
+      std::exception_ptr error;
+
+      try {
+        res = target->post(body, headers);
+      } catch (...) {
+        error = std::current_exception();
+      }
+
+      std::lock_guard<std::mutex> lock(race->mutex);
+
+      --race->pending;
+      if (!error && !race->done) {
+        race->done = true;
+        race->res  = std::move(res);
+      } else if (error) {
+        race->error = error;
+      }
+
+      race->cv.notify_all();
+    });
+  };
+
+  std::unique_lock<std::mutex> lock(race->mutex);
+  auto finished = [&race] { return race->done || race->pending == 0; };
+
+  send(node);
+
+  if (!race->cv.wait_for(lock, hedgeDelay_, finished)) {
+    auto other = pick(tried);
+
+    if (other) {
+      tried.push_back(other);
+      send(other);
+    }
+  }
+
+  race->cv.wait(lock, finished);
+
+  if (!race->done) {
+    std::rethrow_exception(race->error);
+  }
+
+  return race->res;
+}
+
+json
+Service::parse(const cpr::Response& res) const {
+  try {
+    return json::parse(res.text);
+  } catch (const std::runtime_error&) {
+    if (res.elapsed >= timeout_) {
+      throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
+    }
+
+    throw Errors::Unrecognized("Invalid reply from node (unrecognized format): " + res.text);
+  }
+}
+
+void
+Service::parse(const cpr::Response& res, Utils::JsonStreamParser::Handler& handler) const {
+  Utils::JsonStreamParser parser(handler);
+
+  try {
+    parser.feed(res.text.data(), res.text.size());
+    parser.finish();
+  } catch (const Errors::Unrecognized&) {
+    if (res.elapsed >= timeout_) {
+      throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
+    }
+
+    //! the reply can be huge, do not copy it in the error message
+    throw Errors::Unrecognized("Invalid reply from node (unrecognized format)");
+  }
+}
+
+void
+Service::throwError(const cpr::Response& res, const json& resJson) const {
+  std::string error;
+
+  if (resJson.count("error")) {
+    error = resJson["error"].get<decltype(error)>();
+  }
+
+  switch (res.status_code) {
+    case 400:
+      throw Errors::BadRequest(error);
+    case 401:
+      throw Errors::Unauthorized(error);
+    case 500:
+      throw Errors::InternalServerError(error);
+    default:
+      if (res.elapsed >= timeout_) {
+        throw Errors::Network("Time out after " + std::to_string(timeout_) + "s");
+      }
+
+      throw Errors::Unrecognized(error);
+  }
 }
 
 }  // namespace API
@@ -0,0 +1,215 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+#include <sstream>
+
+#include <iota/api/service_metrics.hpp>
+#include <iota/errors/bad_request.hpp>
+#include <iota/errors/internal_server_error.hpp>
+#include <iota/errors/network.hpp>
+#include <iota/errors/unauthorized.hpp>
+#include <iota/errors/unrecognized.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+std::chrono::microseconds
+ServiceMetrics::Sample::getLatency() const {
+  return serializeTime + networkTime + parseTime;
+}
+
+void
+ServiceMetrics::record(const Sample& sample) {
+  const auto& bounds  = getLatencyBounds();
+  auto        latency = sample.getLatency();
+  Callback    callback;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto&                       command = commands_[sample.command];
+
+    if (command.latencyBuckets.empty()) {
+      command.latencyBuckets.resize(bounds.size() + 1);
+    }
+
+    ++command.requests;
+    command.retries += sample.attempts > 1 ? sample.attempts - 1 : 0;
+    command.requestBytes += sample.requestBytes;
+    command.responseBytes += sample.responseBytes;
+    command.serializeTime += sample.serializeTime;
+    command.networkTime += sample.networkTime;
+    command.parseTime += sample.parseTime;
+    ++command.latencyBuckets[std::lower_bound(bounds.begin(), bounds.end(), latency) -
+                             bounds.begin()];
+
+    if (!sample.error.empty()) {
+      ++command.errors[sample.error];
+    }
+
+    callback = callback_;
+  }
+
+  //! do not hold the lock while running user code
+  if (callback) {
+    callback(sample);
+  }
+}
+
+std::map<std::string, ServiceMetrics::Command>
+ServiceMetrics::getCommands() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return commands_;
+}
+
+void
+ServiceMetrics::setCallback(const Callback& callback) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  callback_ = callback;
+}
+
+void
+ServiceMetrics::reset() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  commands_.clear();
+}
+
+std::string
+ServiceMetrics::toPrometheus() const {
+  const auto& bounds   = getLatencyBounds();
+  auto        commands = getCommands();
+  auto seconds = [](const std::chrono::microseconds& us) { return us.count() / 1000000.0; };
+
+  std::ostringstream out;
+
+  out << "# HELP iota_api_request_duration_seconds Latency of the api requests.\n"
+      << "# TYPE iota_api_request_duration_seconds histogram\n";
+  for (const auto& command : commands) {
+    auto     label = "command=\"" + command.first + "\"";
+    uint64_t count = 0;
+
+    for (std::size_t i = 0; i < command.second.latencyBuckets.size(); ++i) {
+      count += command.second.latencyBuckets[i];
+      out << "iota_api_request_duration_seconds_bucket{" << label << ",le=\"";
+      if (i < bounds.size()) {
+        out << seconds(bounds[i]);
+      } else {
+        out << "+Inf";
+      }
+      out << "\"} " << count << "\n";
+    }
+
+    auto latency =
+        command.second.serializeTime + command.second.networkTime + command.second.parseTime;
+    out << "iota_api_request_duration_seconds_sum{" << label << "} " << seconds(latency) << "\n"
+        << "iota_api_request_duration_seconds_count{" << label << "} " << count << "\n";
+  }
+
+  out << "# HELP iota_api_request_phase_seconds_total Time spent in each phase of the requests.\n"
+      << "# TYPE iota_api_request_phase_seconds_total counter\n";
+  for (const auto& command : commands) {
+    auto label = "command=\"" + command.first + "\",phase=";
+
+    out << "iota_api_request_phase_seconds_total{" << label << "\"serialize\"} "
+        << seconds(command.second.serializeTime) << "\n"
+        << "iota_api_request_phase_seconds_total{" << label << "\"network\"} "
+        << seconds(command.second.networkTime) << "\n"
+        << "iota_api_request_phase_seconds_total{" << label << "\"parse\"} "
+        << seconds(command.second.parseTime) << "\n";
+  }
+
+  out << "# HELP iota_api_request_bytes_total Size of the request bodies.\n"
+      << "# TYPE iota_api_request_bytes_total counter\n";
+  for (const auto& command : commands) {
+    out << "iota_api_request_bytes_total{command=\"" << command.first << "\"} "
+        << command.second.requestBytes << "\n";
+  }
+
+  out << "# HELP iota_api_response_bytes_total Size of the reply bodies.\n"
+      << "# TYPE iota_api_response_bytes_total counter\n";
+  for (const auto& command : commands) {
+    out << "iota_api_response_bytes_total{command=\"" << command.first << "\"} "
+        << command.second.responseBytes << "\n";
+  }
+
+  out << "# HELP iota_api_retries_total Additional attempts on other nodes.\n"
+      << "# TYPE iota_api_retries_total counter\n";
+  for (const auto& command : commands) {
+    out << "iota_api_retries_total{command=\"" << command.first << "\"} "
+        << command.second.retries << "\n";
+  }
+
+  out << "# HELP iota_api_errors_total Failed requests, by error class.\n"
+      << "# TYPE iota_api_errors_total counter\n";
+  for (const auto& command : commands) {
+    for (const auto& error : command.second.errors) {
+      out << "iota_api_errors_total{command=\"" << command.first << "\",class=\"" << error.first
+          << "\"} " << error.second << "\n";
+    }
+  }
+
+  return out.str();
+}
+
+const std::vector<std::chrono::microseconds>&
+ServiceMetrics::getLatencyBounds() {
+  static const std::vector<std::chrono::microseconds> bounds = {
+    std::chrono::milliseconds(5),    std::chrono::milliseconds(10),
+    std::chrono::milliseconds(25),   std::chrono::milliseconds(50),
+    std::chrono::milliseconds(100),  std::chrono::milliseconds(250),
+    std::chrono::milliseconds(500),  std::chrono::milliseconds(1000),
+    std::chrono::milliseconds(2500), std::chrono::milliseconds(5000),
+    std::chrono::milliseconds(10000)
+  };
+
+  return bounds;
+}
+
+std::string
+ServiceMetrics::classify(const std::exception_ptr& error) {
+  try {
+    std::rethrow_exception(error);
+  } catch (const Errors::Network&) {
+    return "network";
+  } catch (const Errors::BadRequest&) {
+    return "bad_request";
+  } catch (const Errors::Unauthorized&) {
+    return "unauthorized";
+  } catch (const Errors::InternalServerError&) {
+    return "internal_server_error";
+  } catch (const Errors::Unrecognized&) {
+    return "unrecognized";
+  } catch (...) {
+    return "other";
+  }
+}
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -0,0 +1,163 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#include <iota/api/session_pool.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+const std::size_t          SessionPool::DefaultMaxIdle;
+const std::chrono::seconds SessionPool::DefaultIdleTimeout = std::chrono::seconds(30);
+
+SessionPool::Lease::Lease(SessionPool* pool, std::unique_ptr<cpr::Session> session)
+    : pool_(pool), session_(std::move(session)) {
+}
+
+SessionPool::Lease::Lease(Lease&& rhs) : pool_(rhs.pool_), session_(std::move(rhs.session_)) {
+}
+
+SessionPool::Lease::~Lease() {
+  if (session_) {
+    pool_->release(std::move(session_));
+  }
+}
+
+cpr::Session&
+SessionPool::Lease::operator*() const {
+  return *session_;
+}
+
+cpr::Session*
+SessionPool::Lease::operator->() const {
+  return session_.get();
+}
+
+void
+SessionPool::Lease::discard() {
+  session_.reset();
+}
+
+SessionPool::SessionPool(const Factory& factory, std::size_t maxIdle,
+                         const std::chrono::seconds& idleTimeout)
+    : factory_(factory), maxIdle_(maxIdle), idleTimeout_(idleTimeout) {
+}
+
+SessionPool::Lease
+SessionPool::acquire() {
+  std::unique_ptr<cpr::Session> session;
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    evict(std::chrono::steady_clock::now());
+
+    if (!idle_.empty()) {
+      session = std::move(idle_.back().session);
+      idle_.pop_back();
+    }
+  }
+
+  //! building a session sets up a curl handle: do it outside of the lock
+  if (!session) {
+    session = factory_();
+  }
+
+  return Lease{ this, std::move(session) };
+}
+
+void
+SessionPool::release(std::unique_ptr<cpr::Session> session) {
+  std::unique_ptr<cpr::Session> dropped;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  auto now = std::chrono::steady_clock::now();
+  evict(now);
+
+  if (idle_.size() < maxIdle_) {
+    idle_.push_back({ std::move(session), now });
+  } else {
+    //! closed once the lock is released
+    dropped = std::move(session);
+  }
+}
+
+void
+SessionPool::evict(const std::chrono::steady_clock::time_point& now) {
+  //! idle_ is sorted by last use: expired sessions are at the front
+  auto expired = std::find_if(idle_.begin(), idle_.end(), [&](const IdleSession& idle) {
+    return now - idle.lastUsed <= idleTimeout_;
+  });
+
+  idle_.erase(idle_.begin(), expired);
+}
+
+std::size_t
+SessionPool::idleCount() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idle_.size();
+}
+
+void
+SessionPool::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  idle_.clear();
+}
+
+std::size_t
+SessionPool::getMaxIdle() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return maxIdle_;
+}
+
+void
+SessionPool::setMaxIdle(std::size_t maxIdle) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  maxIdle_ = maxIdle;
+  if (idle_.size() > maxIdle_) {
+    //! keep the most recently used sessions
+    idle_.erase(idle_.begin(), idle_.end() - maxIdle_);
+  }
+}
+
+std::chrono::seconds
+SessionPool::getIdleTimeout() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return idleTimeout_;
+}
+
+void
+SessionPool::setIdleTimeout(const std::chrono::seconds& idleTimeout) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  idleTimeout_ = idleTimeout;
+}
+
+}  // namespace API
+
+}  // namespace IOTA
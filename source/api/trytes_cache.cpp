@@ -0,0 +1,198 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <iota/api/trytes_cache.hpp>
+#include <iota/constants.hpp>
+#include <iota/crypto/curl.hpp>
+#include <iota/types/packed_trits.hpp>
+#include <iota/types/trinary.hpp>
+
+namespace IOTA {
+
+namespace API {
+
+const std::size_t TrytesCache::DefaultCapacity;
+
+TrytesCache::TrytesCache(std::size_t capacity, const std::shared_ptr<TrytesStore>& store)
+    : capacity_(capacity), store_(store), hits_(0), storeHits_(0), misses_(0) {
+}
+
+bool
+TrytesCache::get(const Types::Trytes& hash, Types::Trytes& trytes) {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    auto                        it = index_.find(hash);
+
+    if (it != index_.end()) {
+      //! move to front: most recently used
+      entries_.splice(entries_.begin(), entries_, it->second);
+      trytes = it->second->second;
+      ++hits_;
+      return true;
+    }
+  }
+
+  //! the store may be slow: do not hold the lock while reading it
+  if (store_ && store_->load(hash, trytes)) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    insert(hash, trytes);
+    ++hits_;
+    ++storeHits_;
+    return true;
+  }
+
+  ++misses_;
+  return false;
+}
+
+void
+TrytesCache::put(const Types::Trytes& hash, const Types::Trytes& trytes) {
+  //! the node returns all-9 trytes for transactions it does not know (yet)
+  if (trytes.size() != TrxTrytesLength || trytes.find_first_not_of('9') == std::string::npos) {
+    return;
+  }
+
+  //! a bad reply of any node would otherwise be served to every caller until evicted
+  if (!Types::isValidTrytes(trytes)) {
+    return;
+  }
+
+  auto               trits = Types::PackedTrits::fromTrytes(trytes);
+  Types::PackedTrits actual(TritHashLength);
+  Crypto::Curl       curl;
+
+  curl.absorb(trits);
+  curl.squeeze(actual);
+
+  if (actual.toTrytes() != hash) {
+    return;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (index_.count(hash)) {
+      return;
+    }
+
+    insert(hash, trytes);
+  }
+
+  if (store_) {
+    store_->save(hash, trytes);
+  }
+}
+
+void
+TrytesCache::clear() {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  index_.clear();
+  entries_.clear();
+}
+
+std::size_t
+TrytesCache::size() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return entries_.size();
+}
+
+std::size_t
+TrytesCache::getCapacity() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  return capacity_;
+}
+
+void
+TrytesCache::setCapacity(std::size_t capacity) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  capacity_ = capacity;
+  evict();
+}
+
+const std::shared_ptr<TrytesStore>&
+TrytesCache::getStore() const {
+  return store_;
+}
+
+uint64_t
+TrytesCache::getHits() const {
+  return hits_;
+}
+
+uint64_t
+TrytesCache::getStoreHits() const {
+  return storeHits_;
+}
+
+uint64_t
+TrytesCache::getMisses() const {
+  return misses_;
+}
+
+double
+TrytesCache::getHitRate() const {
+  uint64_t hits  = hits_;
+  uint64_t total = hits + misses_;
+
+  return total ? static_cast<double>(hits) / total : 0;
+}
+
+void
+TrytesCache::resetStatistics() {
+  hits_      = 0;
+  storeHits_ = 0;
+  misses_    = 0;
+}
+
+void
+TrytesCache::insert(const Types::Trytes& hash, const Types::Trytes& trytes) {
+  auto it = index_.find(hash);
+
+  if (it != index_.end()) {
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return;
+  }
+
+  entries_.emplace_front(hash, trytes);
+  index_.emplace(hash, entries_.begin());
+  evict();
+}
+
+void
+TrytesCache::evict() {
+  while (entries_.size() > capacity_) {
+    index_.erase(entries_.back().first);
+    entries_.pop_back();
+  }
+}
+
+}  // namespace API
+
+}  // namespace IOTA
@@ -80,6 +80,53 @@ Curl::squeeze(Types::Trits& trits, std::size_t offset, std::size_t length) {
   } while ((length -= TritHashLength) > 0);
 }
 
+template <unsigned int TritsPerByte>
+void
+Curl::absorb(const Types::BasicPackedTrits<TritsPerByte>& trits, std::size_t offset,
+             std::size_t length) {
+  if (length == 0) {
+    length = trits.size() - offset;
+  }
+
+  if (length % TritHashLength != 0) {
+    throw Errors::Crypto("Curl::absorb failed: illegal length");
+  }
+
+  do {
+    trits.unpack(state_.data(), offset, TritHashLength);
+
+    transform();
+
+    offset += TritHashLength;
+  } while ((length -= TritHashLength) > 0);
+}
+
+template <unsigned int TritsPerByte>
+void
+Curl::squeeze(Types::BasicPackedTrits<TritsPerByte>& trits, std::size_t offset,
+              std::size_t length) {
+  if (length == 0) {
+    length = trits.size() - offset;
+  }
+
+  if (length % TritHashLength != 0) {
+    throw Errors::Crypto("Curl::squeeze failed: illegal length");
+  }
+
+  do {
+    trits.assign(state_.data(), offset, TritHashLength);
+
+    transform();
+
+    offset += TritHashLength;
+  } while ((length -= TritHashLength) > 0);
+}
+
+template void Curl::absorb(const Types::BasicPackedTrits<3>&, std::size_t, std::size_t);
+template void Curl::absorb(const Types::BasicPackedTrits<5>&, std::size_t, std::size_t);
+template void Curl::squeeze(Types::BasicPackedTrits<3>&, std::size_t, std::size_t);
+template void Curl::squeeze(Types::BasicPackedTrits<5>&, std::size_t, std::size_t);
+
 void
 Curl::transform() {
   std::size_t scratchpadIndex      = 0;
@@ -80,14 +80,31 @@ Pow::operator()(const Types::Trytes& trytes, int minWeightMagnitude, int threads
   IOTA::Types::Trits    trits = IOTA::Types::trytesToTrits(trytes);
   std::vector<uint64_t> stateLow(stateSize);
   std::vector<uint64_t> stateHigh(stateSize);
-  IOTA::Types::Trytes   result;
 
-  stop_ = false;
+  initialize(stateLow.data(), stateHigh.data(), trits);
+
+  return search(stateLow, stateHigh, minWeightMagnitude, threads);
+}
+
+Types::Trytes
+Pow::operator()(const Types::PackedTrits& trits, int minWeightMagnitude, int threads) {
+  std::vector<uint64_t> stateLow(stateSize);
+  std::vector<uint64_t> stateHigh(stateSize);
 
   initialize(stateLow.data(), stateHigh.data(), trits);
 
+  return search(stateLow, stateHigh, minWeightMagnitude, threads);
+}
+
+Types::Trytes
+Pow::search(const std::vector<uint64_t>& stateLow, const std::vector<uint64_t>& stateHigh,
+            int minWeightMagnitude, int threads) {
+  IOTA::Types::Trytes result;
+
+  stop_ = false;
+
   Utils::parallel_for(
-      threads, [this, stateLow, stateHigh, minWeightMagnitude, &result](uint32_t i, uint32_t) {
+      threads, [this, &stateLow, &stateHigh, minWeightMagnitude, &result](uint32_t i, uint32_t) {
         uint64_t stateLowCpy[stateSize];
         uint64_t stateHighCpy[stateSize];
 
@@ -117,31 +134,46 @@ Pow::initialize(uint64_t* stateLow, uint64_t* stateHigh, const IOTA::Types::Trit
   uint64_t scratchpadLow[stateSize];
   uint64_t scratchpadHigh[stateSize];
   for (unsigned int i = (TxLength - TritHashLength) / TritHashLength; i > 0; --i) {
-    for (unsigned int j = 0; j < TritHashLength; j++) {
-      switch (trits[offset++]) {
-        case 0: {
-          stateLow[j]  = hBits;
-          stateHigh[j] = hBits;
-          break;
-        }
-        case 1: {
-          stateLow[j]  = lBits;
-          stateHigh[j] = hBits;
-          break;
-        }
-        case -1: {
-          stateLow[j]  = hBits;
-          stateHigh[j] = lBits;
-          break;
-        }
-      }
-    }
+    copyToState(stateLow, stateHigh, &trits[offset], TritHashLength);
+    offset += TritHashLength;
 
     transform(stateLow, stateHigh, scratchpadLow, scratchpadHigh);
   }
 
-  for (unsigned int i = 0; i < nonceOffset; ++i) {
-    switch (trits[offset++]) {
+  copyToState(stateLow, stateHigh, &trits[offset], nonceOffset);
+  initializeNonce(stateLow, stateHigh);
+}
+
+void
+Pow::initialize(uint64_t* stateLow, uint64_t* stateHigh, const IOTA::Types::PackedTrits& trits) {
+  for (int i = TritHashLength; i < stateSize; ++i) {
+    stateLow[i]  = hBits;
+    stateHigh[i] = hBits;
+  }
+
+  //! only one hash is unpacked at a time
+  int8_t   chunk[TritHashLength];
+  int      offset = 0;
+  uint64_t scratchpadLow[stateSize];
+  uint64_t scratchpadHigh[stateSize];
+  for (unsigned int i = (TxLength - TritHashLength) / TritHashLength; i > 0; --i) {
+    trits.unpack(chunk, offset, TritHashLength);
+    copyToState(stateLow, stateHigh, chunk, TritHashLength);
+    offset += TritHashLength;
+
+    transform(stateLow, stateHigh, scratchpadLow, scratchpadHigh);
+  }
+
+  trits.unpack(chunk, offset, nonceOffset);
+  copyToState(stateLow, stateHigh, chunk, nonceOffset);
+  initializeNonce(stateLow, stateHigh);
+}
+
+void
+Pow::copyToState(uint64_t* stateLow, uint64_t* stateHigh, const int8_t* trits,
+                 std::size_t length) {
+  for (std::size_t i = 0; i < length; ++i) {
+    switch (trits[i]) {
       case 0: {
         stateLow[i]  = hBits;
         stateHigh[i] = hBits;
@@ -155,10 +187,14 @@ Pow::initialize(uint64_t* stateLow, uint64_t* stateHigh, const IOTA::Types::Trit
       case -1: {
         stateLow[i]  = hBits;
         stateHigh[i] = lBits;
+        break;
       }
     }
   }
+}
 
+void
+Pow::initializeNonce(uint64_t* stateLow, uint64_t* stateHigh) {
   stateLow[nonceOffset + 0]  = low0;
   stateHigh[nonceOffset + 0] = high0;
   stateLow[nonceOffset + 1]  = low1;
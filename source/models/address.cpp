@@ -29,6 +29,7 @@
 #include <iota/crypto/kerl.hpp>
 #include <iota/errors/illegal_state.hpp>
 #include <iota/models/address.hpp>
+#include <iota/models/multisig_address_builder.hpp>
 
 namespace IOTA {
 
@@ -36,7 +37,7 @@ namespace Models {
 
 Address::Address(const Types::Trytes& address, const int64_t& balance, const int32_t& keyIndex,
                  const int32_t& security, const Type& type)
-    : balance_(balance), keyIndex_(keyIndex), type_(type), k_(std::make_shared<Crypto::Kerl>()) {
+    : balance_(balance), keyIndex_(keyIndex), type_(type) {
   setAddress(address);
   setSecurity(security);
 }
@@ -68,22 +69,30 @@ void
 Address::absorbDigests(const std::vector<uint8_t>& digests) {
   if (type_ != MULTISIG)
     return;
+
+  if (!builder_) {
+    builder_ = std::make_shared<MultisigAddressBuilder>();
+  }
+
   security_ += digests.size() / ByteHashLength;
-  k_->absorb(digests);
+  builder_->absorbDigests(digests);
 }
 
 void
 Address::finalize() {
   if (type_ != MULTISIG)
     return;
-  std::vector<uint8_t> addressBytes(ByteHashLength);
 
-  k_->squeeze(addressBytes);
-  setAddress(IOTA::Types::bytesToTrytes(addressBytes));
+  if (!builder_) {
+    builder_ = std::make_shared<MultisigAddressBuilder>();
+  }
+
+  setAddress(builder_->finalize().toTrytes());
+  builder_ = nullptr;
 }
 
 bool
-Address::validate(const std::vector<std::vector<uint8_t>>& digests) {
+Address::validate(const std::vector<std::vector<uint8_t>>& digests) const {
   if (type_ != MULTISIG)
     return false;
   Crypto::Kerl k;
@@ -180,12 +189,17 @@ Address::operator!=(const Address& rhs) const {
 
 bool
 Address::operator==(const Types::Trytes& rhs) const {
-  return operator==(Address{ rhs });
+  //! compare in place rather than building a temporary Address: checksum is ignored
+  if (rhs.length() != AddressLength && rhs.length() != AddressLengthWithChecksum) {
+    return rhs.empty() && address_.empty();
+  }
+
+  return rhs.compare(0, AddressLength, address_) == 0;
 }
 
 bool
 Address::operator!=(const Types::Trytes& rhs) const {
-  return operator!=(Address{ rhs });
+  return !operator==(rhs);
 }
 
 std::ostream&
@@ -0,0 +1,62 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <iota/constants.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/multisig_address_builder.hpp>
+
+namespace IOTA {
+
+namespace Models {
+
+MultisigAddressBuilder::MultisigAddressBuilder() : k_(new Crypto::Kerl) {
+}
+
+void
+MultisigAddressBuilder::absorbDigests(const std::vector<uint8_t>& digests) {
+  if (!k_) {
+    throw Errors::IllegalState("multisig address has already been finalized");
+  }
+
+  security_ += digests.size() / ByteHashLength;
+  k_->absorb(digests);
+}
+
+Address
+MultisigAddressBuilder::finalize() {
+  if (!k_) {
+    throw Errors::IllegalState("multisig address has already been finalized");
+  }
+
+  std::vector<uint8_t> addressBytes(ByteHashLength);
+  k_->squeeze(addressBytes);
+  k_.reset();
+
+  return { Types::bytesToTrytes(addressBytes), 0, 0, security_, Address::MULTISIG };
+}
+
+}  // namespace Models
+
+}  // namespace IOTA
@@ -56,6 +56,10 @@ Transaction::Transaction(const Types::Trytes& trytes) {
   initFromTrytes(trytes);
 }
 
+Transaction::Transaction(const Types::Trytes& trytes, const Types::Trytes& hash) {
+  initFromTrytes(trytes, hash);
+}
+
 Transaction::Transaction(const Types::Trytes& signatureFragments, int64_t currentIndex,
                          int64_t lastIndex, const Types::Trytes& nonce, const Types::Trytes& hash,
                          int64_t timestamp, const Types::Trytes& trunkTransaction,
@@ -306,8 +310,28 @@ Transaction::toTrytes() const {
          getNonce();
 }
 
+Types::Trytes
+Transaction::addressFromTrytes(const Types::Trytes& trytes) {
+  if (trytes.size() != TrxTrytesLength) {
+    throw Errors::IllegalState("Invalid transaction trytes");
+  }
+
+  return trytes.substr(AddressOffset.first, AddressOffset.second - AddressOffset.first);
+}
+
+int64_t
+Transaction::valueFromTrytes(const Types::Trytes& trytes) {
+  if (trytes.size() != TrxTrytesLength) {
+    throw Errors::IllegalState("Invalid transaction trytes");
+  }
+
+  //! value offsets are expressed in trits, 3 per tryte: only convert the trytes holding them
+  return Types::tritsToInt<int64_t>(Types::trytesToTrits(
+      trytes.substr(ValueOffset.first / 3, (ValueOffset.second - ValueOffset.first) / 3)));
+}
+
 void
-Transaction::initFromTrytes(const Types::Trytes& trytes) {
+Transaction::initFromTrytes(const Types::Trytes& trytes, const Types::Trytes& hash) {
   if (trytes.size() != TrxTrytesLength) {
     throw Errors::IllegalState("Invalid transaction trytes");
   }
@@ -320,15 +344,19 @@ Transaction::initFromTrytes(const Types::Trytes& trytes) {
   }
 
   auto transactionTrits = Types::trytesToTrits(trytes);
-  auto hash             = Types::Trits(TritHashLength);
-
-  // generate the correct transaction hash
-  Crypto::Curl curl;
-  curl.absorb(transactionTrits);
-  curl.squeeze(hash);
 
   //! Hash
-  setHash(Types::tritsToTrytes(hash));
+  if (hash.empty()) {
+    // generate the correct transaction hash
+    auto         hashTrits = Types::Trits(TritHashLength);
+    Crypto::Curl curl;
+    curl.absorb(transactionTrits);
+    curl.squeeze(hashTrits);
+
+    setHash(Types::tritsToTrytes(hashTrits));
+  } else {
+    setHash(hash);
+  }
   //! Signature
   setSignatureFragments(
       trytes.substr(SignatureFragmentsOffset.first,
@@ -0,0 +1,503 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstring>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#include <iota/constants.hpp>
+#include <iota/crypto/curl.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/storage/transaction_archive.hpp>
+#include <iota/types/packed_trits.hpp>
+#include <iota/types/trinary.hpp>
+
+namespace IOTA {
+
+namespace Storage {
+
+//! file header: magic (7 bytes), version (1 byte), record size (4 bytes, little endian), padding
+static const char        ArchiveMagic[]    = "IOTATXA";
+static const uint8_t     ArchiveVersion    = 1;
+static const std::size_t ArchiveHeaderSize = 16;
+
+//! record layout, in bytes
+static const std::size_t HashSize = Types::PackedTrits::packedSize(TritHashLength);
+static const std::size_t TrxSize  = Types::PackedTrits::packedSize(TxLength);
+
+//! fields offsets in the transaction trits
+static const std::pair<std::size_t, std::size_t> AddressOffset      = { 6561, 6804 };
+static const std::pair<std::size_t, std::size_t> ValueOffset        = { 6804, 6837 };
+static const std::pair<std::size_t, std::size_t> TimestampOffset    = { 6966, 6993 };
+static const std::pair<std::size_t, std::size_t> CurrentIndexOffset = { 6993, 7020 };
+static const std::pair<std::size_t, std::size_t> LastIndexOffset    = { 7020, 7047 };
+static const std::pair<std::size_t, std::size_t> BundleOffset       = { 7047, 7290 };
+static const std::pair<std::size_t, std::size_t> TrunkOffset        = { 7290, 7533 };
+static const std::pair<std::size_t, std::size_t> BranchOffset       = { 7533, 7776 };
+
+const std::size_t TransactionArchive::RecordSize = HashSize + TrxSize;
+
+/**
+ * @return The key used to index the given hash.
+ */
+static std::string
+hashKey(const Types::Trytes& hash) {
+  if (!Types::isValidHash(hash)) {
+    throw Errors::IllegalState("Invalid hash provided");
+  }
+
+  auto trits = Types::PackedTrits::fromTrytes(hash);
+  return std::string(trits.getBytes().begin(), trits.getBytes().end());
+}
+
+/**
+ * @return The key used to index the hash at the given offset of the transaction trits.
+ */
+static std::string
+hashKey(const uint8_t* trx, const std::pair<std::size_t, std::size_t>& offset) {
+  int8_t trits[TritHashLength];
+  char   key[HashSize];
+
+  Types::PackedTrits::unpack(trx, offset.first, TritHashLength, trits);
+  Types::PackedTrits::pack(trits, TritHashLength, reinterpret_cast<uint8_t*>(key));
+
+  return std::string(key, HashSize);
+}
+
+/**
+ * Throws an IllegalState exception if the trytes are not valid transaction trytes.
+ *
+ * @return The packed record of the given transaction trytes, with its computed hash.
+ */
+static std::string
+packRecord(const Types::Trytes& trytes) {
+  if (trytes.size() != TrxTrytesLength || !Types::isValidTrytes(trytes)) {
+    throw Errors::IllegalState("Invalid transaction trytes");
+  }
+
+  auto               trits = Types::PackedTrits::fromTrytes(trytes);
+  Types::PackedTrits hash(TritHashLength);
+  Crypto::Curl       curl;
+
+  curl.absorb(trits);
+  curl.squeeze(hash);
+
+  std::string record(hash.getBytes().begin(), hash.getBytes().end());
+  record.append(trits.getBytes().begin(), trits.getBytes().end());
+
+  return record;
+}
+
+/**
+ * Truncates the file at the given path to the given size.
+ */
+static void
+truncateFile(const std::string& path, std::size_t size) {
+#if defined(_WIN32)
+  HANDLE file = CreateFileA(path.c_str(), GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                            OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  LARGE_INTEGER offset;
+  offset.QuadPart = static_cast<LONGLONG>(size);
+
+  bool truncated = file != INVALID_HANDLE_VALUE &&
+                   SetFilePointerEx(file, offset, NULL, FILE_BEGIN) && SetEndOfFile(file);
+
+  if (file != INVALID_HANDLE_VALUE) {
+    CloseHandle(file);
+  }
+#else
+  bool truncated = ::truncate(path.c_str(), static_cast<off_t>(size)) == 0;
+#endif
+
+  if (!truncated) {
+    throw Errors::IllegalState("Can not truncate transaction archive " + path);
+  }
+}
+
+/*
+ * Memory-mapped file.
+ */
+
+class TransactionArchive::MappedFile {
+public:
+  explicit MappedFile(const std::string& path) : data_(nullptr), size_(0) {
+#if defined(_WIN32)
+    HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE, NULL,
+                              OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (file == INVALID_HANDLE_VALUE) {
+      throw Errors::IllegalState("Can not open transaction archive " + path);
+    }
+
+    LARGE_INTEGER size;
+    if (!GetFileSizeEx(file, &size)) {
+      CloseHandle(file);
+      throw Errors::IllegalState("Can not open transaction archive " + path);
+    }
+    size_ = static_cast<std::size_t>(size.QuadPart);
+
+    if (size_) {
+      HANDLE mapping = CreateFileMappingA(file, NULL, PAGE_READONLY, 0, 0, NULL);
+      if (mapping) {
+        data_ = static_cast<const uint8_t*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+        CloseHandle(mapping);
+      }
+    }
+    CloseHandle(file);
+#else
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+      throw Errors::IllegalState("Can not open transaction archive " + path);
+    }
+
+    struct stat st;
+    if (::fstat(fd, &st) < 0) {
+      ::close(fd);
+      throw Errors::IllegalState("Can not open transaction archive " + path);
+    }
+    size_ = static_cast<std::size_t>(st.st_size);
+
+    if (size_) {
+      void* data = ::mmap(nullptr, size_, PROT_READ, MAP_SHARED, fd, 0);
+      data_      = data == MAP_FAILED ? nullptr : static_cast<const uint8_t*>(data);
+    }
+    ::close(fd);
+#endif
+
+    if (size_ && !data_) {
+      throw Errors::IllegalState("Can not map transaction archive " + path);
+    }
+  }
+
+  ~MappedFile() {
+    if (data_) {
+#if defined(_WIN32)
+      UnmapViewOfFile(data_);
+#else
+      ::munmap(const_cast<uint8_t*>(data_), size_);
+#endif
+    }
+  }
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+
+public:
+  const uint8_t* data() const { return data_; }
+  std::size_t    size() const { return size_; }
+
+private:
+  const uint8_t* data_;
+  std::size_t    size_;
+};
+
+/*
+ * Archive.
+ */
+
+TransactionArchive::TransactionArchive(const std::string& path) : path_(path), size_(0) {
+  writer_.open(path_, std::ios::binary | std::ios::app);
+  if (!writer_) {
+    throw Errors::IllegalState("Can not open transaction archive " + path_);
+  }
+
+  file_.reset(new MappedFile(path_));
+
+  //! new archive
+  if (file_->size() == 0) {
+    char header[ArchiveHeaderSize] = { 0 };
+
+    std::memcpy(header, ArchiveMagic, sizeof(ArchiveMagic) - 1);
+    header[sizeof(ArchiveMagic) - 1] = static_cast<char>(ArchiveVersion);
+    for (int i = 0; i < 4; ++i) {
+      header[8 + i] = static_cast<char>((RecordSize >> (8 * i)) & 0xFF);
+    }
+
+    writer_.write(header, ArchiveHeaderSize);
+    writer_.flush();
+    file_.reset(new MappedFile(path_));
+  }
+
+  //! existing archive
+  const uint8_t* data = file_->data();
+  if (file_->size() < ArchiveHeaderSize) {
+    throw Errors::IllegalState("Invalid transaction archive " + path_);
+  }
+
+  std::size_t recordSize = 0;
+  for (int i = 0; i < 4; ++i) {
+    recordSize |= static_cast<std::size_t>(data[8 + i]) << (8 * i);
+  }
+
+  if (std::memcmp(data, ArchiveMagic, sizeof(ArchiveMagic) - 1) != 0 ||
+      data[sizeof(ArchiveMagic) - 1] != ArchiveVersion || recordSize != RecordSize) {
+    throw Errors::IllegalState("Invalid transaction archive " + path_);
+  }
+
+  //! an interrupted append left a partial record at the end of the file: drop it
+  std::size_t partial = (file_->size() - ArchiveHeaderSize) % RecordSize;
+  if (partial) {
+    std::size_t size = file_->size() - partial;
+
+    file_.reset();
+    truncateFile(path_, size);
+    file_.reset(new MappedFile(path_));
+    data = file_->data();
+  }
+
+  //! build indexes
+  std::size_t records = (file_->size() - ArchiveHeaderSize) / RecordSize;
+  for (std::size_t i = 0; i < records; ++i) {
+    index(data + ArchiveHeaderSize + i * RecordSize, i);
+  }
+}
+
+TransactionArchive::~TransactionArchive() {
+}
+
+bool
+TransactionArchive::append(const Models::Transaction& trx) {
+  const auto& hash   = trx.getHash();
+  auto        record = packRecord(trx.toTrytes());
+
+  //! never index a transaction under a hash that does not match its trytes
+  if (Types::isValidHash(hash) && record.compare(0, HashSize, hashKey(hash)) != 0) {
+    throw Errors::IllegalState("Invalid transaction hash " + hash);
+  }
+
+  return appendRecord(record);
+}
+
+bool
+TransactionArchive::append(const Types::Trytes& trytes) {
+  return appendRecord(packRecord(trytes));
+}
+
+bool
+TransactionArchive::appendRecord(const std::string& record) {
+  if (hashes_.count(record.substr(0, HashSize))) {
+    return false;
+  }
+
+  //! views are invalidated by appends: previous mappings can be released
+  retired_.clear();
+
+  writer_.write(record.data(), record.size());
+  if (!writer_) {
+    throw Errors::IllegalState("Can not write to transaction archive " + path_);
+  }
+
+  index(reinterpret_cast<const uint8_t*>(record.data()), size_);
+
+  return true;
+}
+
+void
+TransactionArchive::flush() {
+  writer_.flush();
+  retired_.clear();
+}
+
+void
+TransactionArchive::index(const uint8_t* record, std::size_t position) {
+  const uint8_t* trx = record + HashSize;
+
+  hashes_.emplace(std::string(reinterpret_cast<const char*>(record), HashSize), position);
+  bundles_[hashKey(trx, BundleOffset)].push_back(position);
+  addresses_[hashKey(trx, AddressOffset)].push_back(position);
+
+  size_ = position + 1;
+}
+
+const uint8_t*
+TransactionArchive::record(std::size_t position) const {
+  std::size_t end = ArchiveHeaderSize + (position + 1) * RecordSize;
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  //! remap to see the records appended since the last mapping, views on the previous mapping
+  //! handed to other readers stay valid until the next append
+  if (file_->size() < end) {
+    writer_.flush();
+    retired_.push_back(std::move(file_));
+    file_.reset(new MappedFile(path_));
+  }
+
+  return file_->data() + ArchiveHeaderSize + position * RecordSize;
+}
+
+std::size_t
+TransactionArchive::size() const {
+  return size_;
+}
+
+bool
+TransactionArchive::empty() const {
+  return size_ == 0;
+}
+
+TransactionView
+TransactionArchive::at(std::size_t index) const {
+  if (index >= size_) {
+    throw Errors::IllegalState("Index out of range");
+  }
+
+  return TransactionView{ record(index) };
+}
+
+bool
+TransactionArchive::contains(const Types::Trytes& hash) const {
+  return hashes_.count(hashKey(hash)) != 0;
+}
+
+TransactionView
+TransactionArchive::get(const Types::Trytes& hash) const {
+  auto it = hashes_.find(hashKey(hash));
+
+  if (it == hashes_.end()) {
+    throw Errors::IllegalState("Unknown transaction " + hash);
+  }
+
+  return TransactionView{ record(it->second) };
+}
+
+std::vector<TransactionView>
+TransactionArchive::findByBundle(const Types::Trytes& bundle) const {
+  std::vector<TransactionView> res;
+  auto                         it = bundles_.find(hashKey(bundle));
+
+  if (it != bundles_.end()) {
+    for (auto position : it->second) {
+      res.emplace_back(record(position));
+    }
+  }
+
+  return res;
+}
+
+std::vector<TransactionView>
+TransactionArchive::findByAddress(const Models::Address& address) const {
+  std::vector<TransactionView> res;
+  auto                         it = addresses_.find(hashKey(address.toTrytes()));
+
+  if (it != addresses_.end()) {
+    for (auto position : it->second) {
+      res.emplace_back(record(position));
+    }
+  }
+
+  return res;
+}
+
+/*
+ * View.
+ */
+
+TransactionView::TransactionView(const uint8_t* record) : record_(record) {
+}
+
+Types::Trytes
+TransactionView::getHash() const {
+  return Types::PackedTrits::toTrytes(record_, 0, TritHashLength);
+}
+
+Types::Trytes
+TransactionView::getAddress() const {
+  return getTrytes(AddressOffset.first, AddressOffset.second - AddressOffset.first);
+}
+
+Types::Trytes
+TransactionView::getBundle() const {
+  return getTrytes(BundleOffset.first, BundleOffset.second - BundleOffset.first);
+}
+
+Types::Trytes
+TransactionView::getTrunkTransaction() const {
+  return getTrytes(TrunkOffset.first, TrunkOffset.second - TrunkOffset.first);
+}
+
+Types::Trytes
+TransactionView::getBranchTransaction() const {
+  return getTrytes(BranchOffset.first, BranchOffset.second - BranchOffset.first);
+}
+
+int64_t
+TransactionView::getValue() const {
+  return getInt(ValueOffset.first, ValueOffset.second - ValueOffset.first);
+}
+
+int64_t
+TransactionView::getTimestamp() const {
+  return getInt(TimestampOffset.first, TimestampOffset.second - TimestampOffset.first);
+}
+
+int64_t
+TransactionView::getCurrentIndex() const {
+  return getInt(CurrentIndexOffset.first, CurrentIndexOffset.second - CurrentIndexOffset.first);
+}
+
+int64_t
+TransactionView::getLastIndex() const {
+  return getInt(LastIndexOffset.first, LastIndexOffset.second - LastIndexOffset.first);
+}
+
+bool
+TransactionView::isTailTransaction() const {
+  return getCurrentIndex() == 0;
+}
+
+Types::Trytes
+TransactionView::toTrytes() const {
+  return getTrytes(0, TxLength);
+}
+
+Models::Transaction
+TransactionView::toTransaction() const {
+  return Models::Transaction{ toTrytes(), getHash() };
+}
+
+Types::Trytes
+TransactionView::getTrytes(std::size_t offset, std::size_t length) const {
+  return Types::PackedTrits::toTrytes(record_ + HashSize, offset, length);
+}
+
+int64_t
+TransactionView::getInt(std::size_t offset, std::size_t length) const {
+  Types::Trits trits(length);
+
+  Types::PackedTrits::unpack(record_ + HashSize, offset, length, trits.data());
+
+  return Types::tritsToInt<int64_t>(trits);
+}
+
+}  // namespace Storage
+
+}  // namespace IOTA
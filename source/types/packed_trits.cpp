@@ -0,0 +1,523 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+#include <array>
+#include <cstring>
+
+#include <iota/constants.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/types/packed_trits.hpp>
+#include <iota/types/trinary.hpp>
+
+namespace IOTA {
+
+namespace Types {
+
+/**
+ * @return 3^n.
+ */
+static constexpr std::size_t
+pow3(unsigned int n) {
+  return n == 0 ? 1 : 3 * pow3(n - 1);
+}
+
+/**
+ * Lookup tables for a given number of trits per byte.
+ */
+template <unsigned int TritsPerByte>
+struct PackedTritsTables {
+  //! Number of values a byte can take.
+  static constexpr std::size_t ByteValues = pow3(TritsPerByte);
+  //! Offset to apply on a byte value to get its index in the decoding table.
+  static constexpr int Half = (ByteValues - 1) / 2;
+
+  PackedTritsTables() {
+    for (std::size_t i = 0; i < ByteValues; ++i) {
+      int value = static_cast<int>(i) - Half;
+
+      for (unsigned int j = 0; j < TritsPerByte; ++j) {
+        int trit = ((value % 3) + 3) % 3;
+        trit     = trit == 2 ? -1 : trit;
+
+        decode[i][j] = static_cast<int8_t>(trit);
+        value        = (value - trit) / 3;
+      }
+    }
+  }
+
+  /**
+   * @return The trits encoded by the given byte.
+   */
+  const std::array<int8_t, TritsPerByte>& operator[](uint8_t byte) const {
+    return decode[static_cast<int8_t>(byte) + Half];
+  }
+
+  //! byte value -> trits
+  std::array<std::array<int8_t, TritsPerByte>, ByteValues> decode;
+};
+
+template <unsigned int TritsPerByte>
+static const PackedTritsTables<TritsPerByte>&
+tables() {
+  static const PackedTritsTables<TritsPerByte> t;
+  return t;
+}
+
+/**
+ * tryte index -> trits
+ */
+static const std::array<std::array<int8_t, 3>, TryteAlphabetLength>&
+tryteTrits() {
+  static const auto t = []() {
+    std::array<std::array<int8_t, 3>, TryteAlphabetLength> res;
+
+    for (int64_t i = 0; i < TryteAlphabetLength; ++i) {
+      auto trits = intToTrits(i <= TryteAlphabetLength / 2 ? i : i - TryteAlphabetLength, 3);
+      std::copy(std::begin(trits), std::end(trits), std::begin(res[i]));
+    }
+
+    return res;
+  }();
+
+  return t;
+}
+
+/*
+ * Packing / unpacking.
+ */
+
+template <unsigned int TritsPerByte>
+BasicPackedTrits<TritsPerByte>::BasicPackedTrits() : size_(0) {
+}
+
+template <unsigned int TritsPerByte>
+BasicPackedTrits<TritsPerByte>::BasicPackedTrits(std::size_t size)
+    : bytes_(packedSize(size), 0), size_(size) {
+}
+
+template <unsigned int TritsPerByte>
+BasicPackedTrits<TritsPerByte>::BasicPackedTrits(const Trits& trits)
+    : BasicPackedTrits(trits.data(), trits.size()) {
+}
+
+template <unsigned int TritsPerByte>
+BasicPackedTrits<TritsPerByte>::BasicPackedTrits(const int8_t* trits, std::size_t size)
+    : bytes_(packedSize(size), 0), size_(size) {
+  pack(trits, size, bytes_.data());
+}
+
+template <unsigned int TritsPerByte>
+void
+BasicPackedTrits<TritsPerByte>::pack(const int8_t* trits, std::size_t size, uint8_t* bytes) {
+  std::size_t fullBytes = size / TritsPerByte;
+
+  for (std::size_t i = 0; i < fullBytes; ++i, trits += TritsPerByte) {
+    int value = trits[TritsPerByte - 1];
+
+    for (unsigned int j = TritsPerByte - 1; j-- > 0;) {
+      value = value * 3 + trits[j];
+    }
+
+    bytes[i] = static_cast<uint8_t>(static_cast<int8_t>(value));
+  }
+
+  //! zero-pad the last byte
+  if (std::size_t remaining = size % TritsPerByte) {
+    int value = 0;
+
+    for (std::size_t j = remaining; j-- > 0;) {
+      value = value * 3 + trits[j];
+    }
+
+    bytes[fullBytes] = static_cast<uint8_t>(static_cast<int8_t>(value));
+  }
+}
+
+template <unsigned int TritsPerByte>
+BasicPackedTrits<TritsPerByte>
+BasicPackedTrits<TritsPerByte>::fromTrytes(const Types::Trytes& trytes) {
+  BasicPackedTrits res;
+  res.size_ = trytes.size() * 3;
+  res.bytes_.resize(packedSize(res.size_));
+
+  //! TritsPerByte trytes are exactly packed into 3 bytes
+  int8_t      buffer[3 * TritsPerByte];
+  uint8_t*    out = res.bytes_.data();
+  std::size_t i   = 0;
+
+  while (i < trytes.size()) {
+    std::size_t n = std::min<std::size_t>(TritsPerByte, trytes.size() - i);
+
+    for (std::size_t j = 0; j < n; ++j) {
+      auto index = tryteIndex(trytes[i + j]);
+
+      if (index < 0) {
+        throw Errors::IllegalState("Invalid trytes provided");
+      }
+
+      std::memcpy(buffer + 3 * j, tryteTrits()[index].data(), 3);
+    }
+
+    pack(buffer, 3 * n, out);
+
+    out += 3;
+    i += n;
+  }
+
+  return res;
+}
+
+template <unsigned int TritsPerByte>
+BasicPackedTrits<TritsPerByte>
+BasicPackedTrits<TritsPerByte>::fromBytes(const std::vector<uint8_t>& bytes, std::size_t size) {
+  if (bytes.size() != packedSize(size)) {
+    throw Errors::IllegalState("Invalid packed trits size");
+  }
+
+  const int half = PackedTritsTables<TritsPerByte>::Half;
+  for (const auto& byte : bytes) {
+    int value = static_cast<int8_t>(byte);
+
+    if (value < -half || value > half) {
+      throw Errors::IllegalState("Invalid packed trits");
+    }
+  }
+
+  //! padding trits must be 0 so that comparison of bytes is equivalent to comparison of trits
+  if (size % TritsPerByte) {
+    const auto& trits = tables<TritsPerByte>()[bytes.back()];
+
+    for (std::size_t i = size % TritsPerByte; i < TritsPerByte; ++i) {
+      if (trits[i] != 0) {
+        throw Errors::IllegalState("Invalid packed trits");
+      }
+    }
+  }
+
+  BasicPackedTrits res;
+  res.bytes_ = bytes;
+  res.size_  = size;
+
+  return res;
+}
+
+template <unsigned int TritsPerByte>
+std::size_t
+BasicPackedTrits<TritsPerByte>::size() const {
+  return size_;
+}
+
+template <unsigned int TritsPerByte>
+bool
+BasicPackedTrits<TritsPerByte>::empty() const {
+  return size_ == 0;
+}
+
+template <unsigned int TritsPerByte>
+const std::vector<uint8_t>&
+BasicPackedTrits<TritsPerByte>::getBytes() const {
+  return bytes_;
+}
+
+template <unsigned int TritsPerByte>
+int8_t BasicPackedTrits<TritsPerByte>::operator[](std::size_t index) const {
+  return tables<TritsPerByte>()[bytes_[index / TritsPerByte]][index % TritsPerByte];
+}
+
+template <unsigned int TritsPerByte>
+void
+BasicPackedTrits<TritsPerByte>::set(std::size_t index, int8_t trit) {
+  if (index >= size_) {
+    throw Errors::IllegalState("Index out of range");
+  }
+
+  if (!isValidTrit(trit)) {
+    throw Errors::IllegalState("Invalid trit provided");
+  }
+
+  auto&       byte  = bytes_[index / TritsPerByte];
+  std::size_t pos   = index % TritsPerByte;
+  int         delta = trit - tables<TritsPerByte>()[byte][pos];
+  int         value = static_cast<int8_t>(byte) + delta * static_cast<int>(pow3(pos));
+
+  byte = static_cast<uint8_t>(static_cast<int8_t>(value));
+}
+
+template <unsigned int TritsPerByte>
+void
+BasicPackedTrits<TritsPerByte>::assign(const int8_t* trits, std::size_t offset,
+                                       std::size_t length) {
+  if (offset > size_ || length > size_ - offset) {
+    throw Errors::IllegalState("Index out of range");
+  }
+
+  std::size_t end = offset + length;
+
+  //! leading trits sharing their byte with trits that should not be updated
+  for (; offset < end && offset % TritsPerByte; ++offset) {
+    set(offset, *trits++);
+  }
+
+  //! whole bytes
+  std::size_t fullBytes = (end - offset) / TritsPerByte;
+  pack(trits, fullBytes * TritsPerByte, bytes_.data() + offset / TritsPerByte);
+  trits += fullBytes * TritsPerByte;
+  offset += fullBytes * TritsPerByte;
+
+  //! trailing trits
+  for (; offset < end; ++offset) {
+    set(offset, *trits++);
+  }
+}
+
+template <unsigned int TritsPerByte>
+void
+BasicPackedTrits<TritsPerByte>::unpack(int8_t* trits, std::size_t offset,
+                                       std::size_t length) const {
+  if (offset > size_ || length > size_ - offset) {
+    throw Errors::IllegalState("Index out of range");
+  }
+
+  unpack(bytes_.data(), offset, length, trits);
+}
+
+template <unsigned int TritsPerByte>
+void
+BasicPackedTrits<TritsPerByte>::unpack(const uint8_t* bytes, std::size_t offset, std::size_t length,
+                                       int8_t* trits) {
+  const auto& t   = tables<TritsPerByte>();
+  std::size_t end = offset + length;
+
+  //! leading trits, not aligned on a byte
+  for (; offset < end && offset % TritsPerByte; ++offset) {
+    *trits++ = t[bytes[offset / TritsPerByte]][offset % TritsPerByte];
+  }
+
+  //! whole bytes
+  const uint8_t* byte = bytes + offset / TritsPerByte;
+  for (; end - offset >= TritsPerByte; offset += TritsPerByte, trits += TritsPerByte) {
+    std::memcpy(trits, t[*byte++].data(), TritsPerByte);
+  }
+
+  //! trailing trits
+  for (std::size_t i = 0; offset < end; ++offset, ++i) {
+    *trits++ = t[*byte][i];
+  }
+}
+
+template <unsigned int TritsPerByte>
+Trits
+BasicPackedTrits<TritsPerByte>::toTrits() const {
+  Trits trits(size_);
+
+  unpack(trits.data(), 0, size_);
+
+  return trits;
+}
+
+template <unsigned int TritsPerByte>
+Types::Trytes
+BasicPackedTrits<TritsPerByte>::toTrytes() const {
+  return toTrytes(bytes_.data(), 0, size_);
+}
+
+template <unsigned int TritsPerByte>
+Types::Trytes
+BasicPackedTrits<TritsPerByte>::toTrytes(const uint8_t* bytes, std::size_t offset,
+                                         std::size_t length) {
+  if (length % 3 != 0) {
+    throw Errors::IllegalState("Illegal length");
+  }
+
+  Types::Trytes trytes(length / 3, '9');
+
+  //! unpack by blocks aligned on trytes
+  static constexpr std::size_t BlockLength = 3 * TritsPerByte * 16;
+  int8_t                       buffer[BlockLength];
+
+  for (std::size_t i = 0; i < length; i += BlockLength) {
+    std::size_t blockLength = std::min(BlockLength, length - i);
+
+    unpack(bytes, offset + i, blockLength, buffer);
+
+    for (std::size_t j = 0; j < blockLength; j += 3) {
+      int index = buffer[j] + buffer[j + 1] * 3 + buffer[j + 2] * 9;
+
+      trytes[(i + j) / 3] = TryteAlphabet[index < 0 ? index + TryteAlphabetLength : index];
+    }
+  }
+
+  return trytes;
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator
+BasicPackedTrits<TritsPerByte>::begin() const {
+  return const_iterator(this, 0);
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator
+BasicPackedTrits<TritsPerByte>::end() const {
+  return const_iterator(this, size_);
+}
+
+template <unsigned int TritsPerByte>
+bool
+BasicPackedTrits<TritsPerByte>::operator==(const BasicPackedTrits& rhs) const {
+  return size_ == rhs.size_ && bytes_ == rhs.bytes_;
+}
+
+template <unsigned int TritsPerByte>
+bool
+BasicPackedTrits<TritsPerByte>::operator!=(const BasicPackedTrits& rhs) const {
+  return !operator==(rhs);
+}
+
+/*
+ * Iterator.
+ */
+
+template <unsigned int TritsPerByte>
+BasicPackedTrits<TritsPerByte>::const_iterator::const_iterator(const BasicPackedTrits* trits,
+                                                               std::size_t             index)
+    : trits_(trits), index_(index) {
+}
+
+template <unsigned int TritsPerByte>
+int8_t BasicPackedTrits<TritsPerByte>::const_iterator::operator*() const {
+  return (*trits_)[index_];
+}
+
+template <unsigned int TritsPerByte>
+int8_t BasicPackedTrits<TritsPerByte>::const_iterator::operator[](std::ptrdiff_t n) const {
+  return (*trits_)[index_ + n];
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator&
+    BasicPackedTrits<TritsPerByte>::const_iterator::operator++() {
+  ++index_;
+  return *this;
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator
+    BasicPackedTrits<TritsPerByte>::const_iterator::operator++(int) {
+  auto tmp = *this;
+  ++index_;
+  return tmp;
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator&
+    BasicPackedTrits<TritsPerByte>::const_iterator::operator--() {
+  --index_;
+  return *this;
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator
+    BasicPackedTrits<TritsPerByte>::const_iterator::operator--(int) {
+  auto tmp = *this;
+  --index_;
+  return tmp;
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator&
+BasicPackedTrits<TritsPerByte>::const_iterator::operator+=(std::ptrdiff_t n) {
+  index_ += n;
+  return *this;
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator&
+BasicPackedTrits<TritsPerByte>::const_iterator::operator-=(std::ptrdiff_t n) {
+  index_ -= n;
+  return *this;
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator
+BasicPackedTrits<TritsPerByte>::const_iterator::operator+(std::ptrdiff_t n) const {
+  return const_iterator(trits_, index_ + n);
+}
+
+template <unsigned int TritsPerByte>
+typename BasicPackedTrits<TritsPerByte>::const_iterator
+BasicPackedTrits<TritsPerByte>::const_iterator::operator-(std::ptrdiff_t n) const {
+  return const_iterator(trits_, index_ - n);
+}
+
+template <unsigned int TritsPerByte>
+std::ptrdiff_t
+BasicPackedTrits<TritsPerByte>::const_iterator::operator-(const const_iterator& rhs) const {
+  return static_cast<std::ptrdiff_t>(index_) - static_cast<std::ptrdiff_t>(rhs.index_);
+}
+
+template <unsigned int TritsPerByte>
+bool
+BasicPackedTrits<TritsPerByte>::const_iterator::operator==(const const_iterator& rhs) const {
+  return trits_ == rhs.trits_ && index_ == rhs.index_;
+}
+
+template <unsigned int TritsPerByte>
+bool
+BasicPackedTrits<TritsPerByte>::const_iterator::operator!=(const const_iterator& rhs) const {
+  return !operator==(rhs);
+}
+
+template <unsigned int TritsPerByte>
+bool
+BasicPackedTrits<TritsPerByte>::const_iterator::operator<(const const_iterator& rhs) const {
+  return index_ < rhs.index_;
+}
+
+template <unsigned int TritsPerByte>
+bool
+BasicPackedTrits<TritsPerByte>::const_iterator::operator>(const const_iterator& rhs) const {
+  return index_ > rhs.index_;
+}
+
+template <unsigned int TritsPerByte>
+bool
+BasicPackedTrits<TritsPerByte>::const_iterator::operator<=(const const_iterator& rhs) const {
+  return index_ <= rhs.index_;
+}
+
+template <unsigned int TritsPerByte>
+bool
+BasicPackedTrits<TritsPerByte>::const_iterator::operator>=(const const_iterator& rhs) const {
+  return index_ >= rhs.index_;
+}
+
+template class BasicPackedTrits<3>;
+template class BasicPackedTrits<5>;
+
+}  // namespace Types
+
+}  // namespace IOTA
@@ -27,6 +27,7 @@
 #include <array>
 #include <cmath>
 #include <cstdlib>
+#include <cstring>
 #include <functional>
 
 #include <iota/constants.hpp>
@@ -47,15 +48,30 @@ static constexpr std::array<std::array<int8_t, 3>, TryteAlphabetLength> trytesTr
     { { 1, -1, 0 } },  { { -1, 0, 0 } } }
 };
 
+//! index in the tryte alphabet of each char, -1 for invalid chars
+//! spelled out so that it is constant-initialized and usable during static initialization
+static constexpr int8_t tryteIndexes[256] = {
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1,  0, -1, -1, -1, -1, -1, -1,
+  -1,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15,
+  16, 17, 18, 19, 20, 21, 22, 23, 24, 25, 26, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+  -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1
+};
+
 int8_t
 tryteIndex(const char& tryte) {
-  if (tryte == '9') {
-    return 0;
-  }
-  if ('A' <= tryte && tryte <= 'Z') {
-    return tryte - 'A' + 1;
-  }
-  return -1;
+  return tryteIndexes[static_cast<uint8_t>(tryte)];
 }
 
 bool
@@ -63,9 +79,61 @@ isValidTryte(const char& tryte) {
   return tryteIndex(tryte) >= 0;
 }
 
+//! SWAR constants: each one repeats its byte value in the 8 bytes of a word
+static constexpr uint64_t swarOnes  = 0x0101010101010101ULL;
+static constexpr uint64_t swarHigh  = 0x8080808080808080ULL;
+static constexpr uint64_t swarLow   = 0x7F7F7F7F7F7F7F7FULL;
+static constexpr uint64_t swarGeA   = (0x80 - 'A') * swarOnes;
+static constexpr uint64_t swarLeZ   = (0x80 + 'Z') * swarOnes;
+static constexpr uint64_t swarNines = '9' * swarOnes;
+
+/**
+ * Checks 8 chars at a time.
+ * As long as all chars are ASCII (high bit unset), byte-wise additions and subtractions can not
+ * carry over to the next byte, so the high bit of each byte is used as the result of the
+ * comparison for this byte.
+ */
+static inline bool
+isValidTrytesWord(uint64_t word) {
+  uint64_t geA   = word + swarGeA;
+  uint64_t leZ   = swarLeZ - word;
+  uint64_t nines = word ^ swarNines;
+  //! high bit set for non-zero bytes of nines, i.e. chars different from '9'
+  uint64_t notNine = ((nines & swarLow) + swarLow) | nines;
+
+  return ((word & swarHigh) == 0) && ((((geA & leZ) | ~notNine) & swarHigh) == swarHigh);
+}
+
 bool
 isValidTrytes(const Trytes& trytes) {
-  return std::find_if_not(trytes.begin(), trytes.end(), &isValidTryte) == trytes.end();
+  const char* data  = trytes.data();
+  std::size_t size  = trytes.size();
+  std::size_t i     = 0;
+  bool        valid = true;
+  uint64_t    words[4];
+
+  //! 32 chars per iteration, branch only once per block
+  for (; i + sizeof(words) <= size; i += sizeof(words)) {
+    std::memcpy(words, data + i, sizeof(words));
+
+    valid = isValidTrytesWord(words[0]) & isValidTrytesWord(words[1]) &
+            isValidTrytesWord(words[2]) & isValidTrytesWord(words[3]);
+
+    if (!valid) {
+      return false;
+    }
+  }
+
+  for (; i < size; ++i) {
+    valid &= tryteIndexes[static_cast<uint8_t>(data[i])] >= 0;
+  }
+
+  return valid;
+}
+
+bool
+isValidTrit(const int8_t& trit) {
+  return trit >= -1 && trit <= 1;
 }
 
 bool
@@ -90,16 +158,22 @@ isValidHash(const Trytes& s) {
 
 Trytes
 charToTrytes(const char c) {
-  return Trytes{ TryteAlphabet[c % 27], TryteAlphabet[c / 27] };
+  uint8_t value = static_cast<uint8_t>(c);
+
+  return Trytes{ TryteAlphabet[value % 27], TryteAlphabet[value / 27] };
 }
 
 Trytes
 stringToTrytes(const std::string& str) {
-  Trytes t;
-  for (const auto& c : str) {
-    t += charToTrytes(c);
+  Trytes trytes(str.size() * 2, '9');
+
+  for (std::size_t i = 0; i < str.size(); ++i) {
+    uint8_t value     = static_cast<uint8_t>(str[i]);
+    trytes[2 * i]     = TryteAlphabet[value % 27];
+    trytes[2 * i + 1] = TryteAlphabet[value / 27];
   }
-  return t;
+
+  return trytes;
 }
 
 std::string
@@ -107,10 +181,21 @@ trytesToString(const Trytes& trytes) {
   if (trytes.size() % 2 != 0)
     throw Errors::IllegalState("Odd number of trytes provided");
 
-  std::string str;
-  for (size_t i = 0; i < trytes.size(); i += 2) {
-    str += TryteAlphabet.find(trytes[i]) + TryteAlphabet.find(trytes[i + 1]) * 27;
+  std::string str(trytes.size() / 2, '\0');
+  int8_t      invalid = 0;
+
+  for (std::size_t i = 0; i < str.size(); ++i) {
+    int8_t low  = tryteIndexes[static_cast<uint8_t>(trytes[2 * i])];
+    int8_t high = tryteIndexes[static_cast<uint8_t>(trytes[2 * i + 1])];
+
+    //! negative indexes (invalid trytes) have their sign bit set
+    invalid |= low | high;
+    str[i] = static_cast<char>(low + high * 27);
   }
+
+  if (invalid < 0)
+    throw Errors::IllegalState("Invalid trytes provided");
+
   return str;
 }
 
@@ -160,11 +245,10 @@ bytesToTrytes(const std::vector<uint8_t>& bytes) {
 
 Trits
 trytesToTrits(const Trytes& trytes) {
-  Trits trits;
-  trits.reserve(trytes.size() * 3);
+  Trits trits(trytes.size() * 3);
   for (std::size_t i = 0; i < trytes.size(); i++) {
     std::size_t index = tryteIndex(trytes[i]);
-    trits.insert(std::end(trits), std::begin(trytesTrits[index]), std::end(trytesTrits[index]));
+    std::memcpy(&trits[i * 3], trytesTrits[index].data(), 3);
   }
   return trits;
 }
@@ -176,13 +260,13 @@ tritsToTrytes(const Trits& trits) {
 
 Trytes
 tritsToTrytes(const Trits& trits, std::size_t length) {
-  Trytes trytes;
+  Trytes trytes((length + 2) / 3, '9');
   for (std::size_t i = 0; i < length; i += 3) {
     int8_t idx = trits[i] + trits[i + 1] * 3 + trits[i + 2] * 9;
     if (idx < 0) {
       idx += TryteAlphabetLength;
     }
-    trytes += TryteAlphabet[idx];
+    trytes[i / 3] = TryteAlphabet[idx];
   }
   return trytes;
 }
@@ -0,0 +1,160 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <algorithm>
+
+#if defined(IOTA_WITH_ZLIB)
+#include <zlib.h>
+#endif
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/errors/network.hpp>
+#include <iota/errors/unrecognized.hpp>
+#include <iota/utils/compression.hpp>
+
+namespace IOTA {
+
+namespace Utils {
+
+#if defined(IOTA_WITH_ZLIB)
+
+bool
+isCompressionSupported() {
+  return true;
+}
+
+//! zlib window bits: 15 for the maximum window size, +16 for gzip, +32 to detect gzip or zlib
+static const int GzipWindowBits   = 15 + 16;
+static const int DetectWindowBits = 15 + 32;
+static const int RawWindowBits    = -15;
+
+std::string
+gzip(const std::string& data) {
+  z_stream stream{};
+
+  if (deflateInit2(&stream, Z_DEFAULT_COMPRESSION, Z_DEFLATED, GzipWindowBits, 8,
+                   Z_DEFAULT_STRATEGY) != Z_OK) {
+    throw Errors::Unrecognized("Can not initialize compression");
+  }
+
+  std::string out(deflateBound(&stream, data.size()), '\0');
+
+  stream.next_in   = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in  = static_cast<uInt>(data.size());
+  stream.next_out  = reinterpret_cast<Bytef*>(&out[0]);
+  stream.avail_out = static_cast<uInt>(out.size());
+
+  auto status = ::deflate(&stream, Z_FINISH);
+  out.resize(stream.total_out);
+  deflateEnd(&stream);
+
+  if (status != Z_STREAM_END) {
+    throw Errors::Unrecognized("Can not compress data");
+  }
+
+  return out;
+}
+
+/**
+ * Decompress data with the given window bits.
+ * Throws a Network exception if the decompressed data exceeds the given size.
+ *
+ * @return Whether the data could be decompressed.
+ */
+static bool
+inflate(const std::string& data, int windowBits, std::size_t maxSize, std::string& out) {
+  z_stream stream{};
+
+  if (inflateInit2(&stream, windowBits) != Z_OK) {
+    return false;
+  }
+
+  char buffer[16384];
+  int  status = Z_OK;
+
+  out.clear();
+  //! trytes compress well: expect a high ratio
+  out.reserve(std::min(data.size() * 4, maxSize));
+
+  stream.next_in  = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+  stream.avail_in = static_cast<uInt>(data.size());
+
+  while (status == Z_OK) {
+    stream.next_out  = reinterpret_cast<Bytef*>(buffer);
+    stream.avail_out = sizeof(buffer);
+
+    status = ::inflate(&stream, Z_NO_FLUSH);
+    out.append(buffer, sizeof(buffer) - stream.avail_out);
+
+    if (out.size() > maxSize) {
+      inflateEnd(&stream);
+      throw Errors::Network("Decompressed reply exceeds " + std::to_string(maxSize) + " bytes");
+    }
+
+    //! truncated data
+    if (status == Z_BUF_ERROR && stream.avail_in == 0) {
+      break;
+    }
+  }
+
+  inflateEnd(&stream);
+  return status == Z_STREAM_END;
+}
+
+std::string
+inflate(const std::string& data, std::size_t maxSize) {
+  std::string out;
+
+  //! "deflate" is zlib-wrapped per the http spec, but some servers send raw deflate data
+  if (!inflate(data, DetectWindowBits, maxSize, out) &&
+      !inflate(data, RawWindowBits, maxSize, out)) {
+    throw Errors::Unrecognized("Invalid compressed data");
+  }
+
+  return out;
+}
+
+#else
+
+bool
+isCompressionSupported() {
+  return false;
+}
+
+std::string
+gzip(const std::string&) {
+  throw Errors::IllegalState("Compression is not supported: built without zlib");
+}
+
+std::string
+inflate(const std::string&, std::size_t) {
+  throw Errors::IllegalState("Compression is not supported: built without zlib");
+}
+
+#endif
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -0,0 +1,171 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstdlib>
+
+#include <iota/errors/unrecognized.hpp>
+#include <iota/utils/json_fields_handler.hpp>
+
+namespace IOTA {
+
+namespace Utils {
+
+JsonFieldsHandler::JsonFieldsHandler() : depth_(0), field_(nullptr) {
+}
+
+void
+JsonFieldsHandler::bindString(const std::string& key, const std::function<void(std::string&)>& fn) {
+  auto& binding    = bindings_[key];
+  binding.type     = Type::String;
+  binding.onString = fn;
+}
+
+void
+JsonFieldsHandler::bindInteger(const std::string& key, const std::function<void(int64_t)>& fn) {
+  auto& binding     = bindings_[key];
+  binding.type      = Type::Integer;
+  binding.onInteger = fn;
+}
+
+void
+JsonFieldsHandler::bindStrings(const std::string&                       key,
+                               const std::function<void(std::string&)>& fn) {
+  auto& binding    = bindings_[key];
+  binding.type     = Type::Strings;
+  binding.onString = fn;
+}
+
+void
+JsonFieldsHandler::bindBools(const std::string& key, const std::function<void(bool)>& fn) {
+  auto& binding  = bindings_[key];
+  binding.type   = Type::Bools;
+  binding.onBool = fn;
+}
+
+const JsonFieldsHandler::Binding*
+JsonFieldsHandler::current(Type type) const {
+  if (!field_) {
+    return nullptr;
+  }
+
+  //! scalar directly in the root object, or element of an array of the root object
+  bool scalar  = depth_ == 1 && (field_->type == Type::String || field_->type == Type::Integer);
+  bool element = depth_ == 2 && (field_->type == Type::Strings || field_->type == Type::Bools);
+
+  if ((!scalar && !element) || field_->type != type) {
+    unexpected();
+  }
+
+  return field_;
+}
+
+void
+JsonFieldsHandler::unexpected() const {
+  if (field_ && depth_ <= 2) {
+    throw Errors::Unrecognized("Invalid json: unexpected value for '" + key_ + "'");
+  }
+}
+
+void
+JsonFieldsHandler::onStartObject() {
+  if (depth_ > 0) {
+    unexpected();
+  }
+  ++depth_;
+}
+
+void
+JsonFieldsHandler::onEndObject() {
+  --depth_;
+}
+
+void
+JsonFieldsHandler::onStartArray() {
+  //! only arrays of the root object can be bound
+  if (depth_ != 1 || (field_ && field_->type != Type::Strings && field_->type != Type::Bools)) {
+    unexpected();
+  }
+  ++depth_;
+}
+
+void
+JsonFieldsHandler::onEndArray() {
+  --depth_;
+}
+
+void
+JsonFieldsHandler::onKey(std::string& key) {
+  if (depth_ != 1) {
+    return;
+  }
+
+  auto binding = bindings_.find(key);
+  field_       = binding == bindings_.end() ? nullptr : &binding->second;
+  key_.swap(key);
+}
+
+void
+JsonFieldsHandler::onString(std::string& value) {
+  auto binding = current(depth_ == 1 ? Type::String : Type::Strings);
+
+  if (binding) {
+    binding->onString(value);
+  }
+}
+
+void
+JsonFieldsHandler::onNumber(const std::string& value) {
+  auto binding = current(Type::Integer);
+
+  if (binding) {
+    char* end    = nullptr;
+    auto  number = std::strtoll(value.c_str(), &end, 10);
+
+    //! integers may be written with a fraction or an exponent
+    if (*end != '\0') {
+      number = static_cast<int64_t>(std::strtod(value.c_str(), nullptr));
+    }
+
+    binding->onInteger(number);
+  }
+}
+
+void
+JsonFieldsHandler::onBool(bool value) {
+  auto binding = current(Type::Bools);
+
+  if (binding) {
+    binding->onBool(value);
+  }
+}
+
+void
+JsonFieldsHandler::onNull() {
+  //! null fields are ignored, like missing ones
+}
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -0,0 +1,382 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstdlib>
+
+#include <iota/errors/unrecognized.hpp>
+#include <iota/utils/json_stream_parser.hpp>
+
+namespace IOTA {
+
+namespace Utils {
+
+static void
+throwInvalid(const std::string& reason) {
+  throw Errors::Unrecognized("Invalid json: " + reason);
+}
+
+static bool
+isNumberChar(char c) {
+  return ('0' <= c && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E';
+}
+
+static int
+hexValue(char c) {
+  if ('0' <= c && c <= '9')
+    return c - '0';
+  if ('a' <= c && c <= 'f')
+    return c - 'a' + 10;
+  if ('A' <= c && c <= 'F')
+    return c - 'A' + 10;
+  return -1;
+}
+
+JsonStreamParser::JsonStreamParser(Handler& handler)
+    : handler_(handler),
+      expect_(Expect::Value),
+      token_(Token::None),
+      isKey_(false),
+      escape_(false),
+      unicodeDigits_(0),
+      unicode_(0),
+      highSurrogate_(0) {
+}
+
+void
+JsonStreamParser::feed(const char* data, std::size_t size) {
+  std::size_t i = 0;
+
+  while (i < size) {
+    if (token_ == Token::String) {
+      i += readString(data + i, size - i);
+      continue;
+    }
+
+    if (token_ == Token::Number) {
+      if (isNumberChar(data[i])) {
+        buffer_ += data[i++];
+        continue;
+      }
+      endNumber();
+    } else if (token_ == Token::Literal) {
+      if ('a' <= data[i] && data[i] <= 'z') {
+        buffer_ += data[i++];
+        continue;
+      }
+      endLiteral();
+    }
+
+    char c = data[i++];
+    if (c == ' ' || c == '\t' || c == '\n' || c == '\r') {
+      continue;
+    }
+
+    switch (expect_) {
+      case Expect::Value:
+      case Expect::ValueOrArrayEnd:
+        if (c == ']' && expect_ == Expect::ValueOrArrayEnd) {
+          endContainer(c);
+        } else {
+          startValue(c);
+        }
+        break;
+      case Expect::Key:
+      case Expect::KeyOrObjectEnd:
+        if (c == '}' && expect_ == Expect::KeyOrObjectEnd) {
+          endContainer(c);
+        } else if (c == '"') {
+          token_ = Token::String;
+          isKey_ = true;
+        } else {
+          throwInvalid("expecting object key");
+        }
+        break;
+      case Expect::Colon:
+        if (c != ':') {
+          throwInvalid("expecting ':'");
+        }
+        expect_ = Expect::Value;
+        break;
+      case Expect::CommaOrEnd:
+        if (c == ',') {
+          expect_ = containers_.back() == '{' ? Expect::Key : Expect::Value;
+        } else {
+          endContainer(c);
+        }
+        break;
+      case Expect::Done:
+        throwInvalid("unexpected data after the end of the document");
+    }
+  }
+}
+
+void
+JsonStreamParser::finish() {
+  if (token_ == Token::Number) {
+    endNumber();
+  } else if (token_ == Token::Literal) {
+    endLiteral();
+  }
+
+  if (token_ != Token::None || expect_ != Expect::Done) {
+    throwInvalid("unexpected end of data");
+  }
+}
+
+std::size_t
+JsonStreamParser::depth() const {
+  return containers_.size();
+}
+
+std::size_t
+JsonStreamParser::readString(const char* data, std::size_t size) {
+  std::size_t i = 0;
+
+  while (i < size) {
+    if (escape_) {
+      readEscape(data[i++]);
+      continue;
+    }
+
+    //! copy plain chars in one go, strings are mostly trytes
+    std::size_t start = i;
+    while (i < size && data[i] != '"' && data[i] != '\\' &&
+           static_cast<unsigned char>(data[i]) >= 0x20) {
+      ++i;
+    }
+
+    if (i != start && highSurrogate_) {
+      appendCodePoint(highSurrogate_);
+      highSurrogate_ = 0;
+    }
+    buffer_.append(data + start, i - start);
+
+    if (i == size) {
+      break;
+    }
+
+    char c = data[i++];
+    if (c == '\\') {
+      escape_ = true;
+    } else if (c == '"') {
+      if (highSurrogate_) {
+        appendCodePoint(highSurrogate_);
+        highSurrogate_ = 0;
+      }
+
+      token_ = Token::None;
+      if (isKey_) {
+        handler_.onKey(buffer_);
+        expect_ = Expect::Colon;
+      } else {
+        handler_.onString(buffer_);
+        endValue();
+      }
+      buffer_.clear();
+      break;
+    } else {
+      throwInvalid("control character in string");
+    }
+  }
+
+  return i;
+}
+
+void
+JsonStreamParser::readEscape(char c) {
+  if (unicodeDigits_ > 0) {
+    int digit = hexValue(c);
+    if (digit < 0) {
+      throwInvalid("invalid unicode escape");
+    }
+
+    unicode_ = unicode_ * 16 + digit;
+    if (--unicodeDigits_ > 0) {
+      return;
+    }
+
+    escape_ = false;
+    if (0xD800 <= unicode_ && unicode_ < 0xDC00) {
+      if (highSurrogate_) {
+        appendCodePoint(highSurrogate_);
+      }
+      highSurrogate_ = unicode_;
+    } else if (0xDC00 <= unicode_ && unicode_ < 0xE000 && highSurrogate_) {
+      appendCodePoint(0x10000 + ((highSurrogate_ - 0xD800) << 10) + (unicode_ - 0xDC00));
+      highSurrogate_ = 0;
+    } else {
+      if (highSurrogate_) {
+        appendCodePoint(highSurrogate_);
+        highSurrogate_ = 0;
+      }
+      appendCodePoint(unicode_);
+    }
+    return;
+  }
+
+  if (c == 'u') {
+    unicodeDigits_ = 4;
+    unicode_       = 0;
+    return;
+  }
+
+  if (highSurrogate_) {
+    appendCodePoint(highSurrogate_);
+    highSurrogate_ = 0;
+  }
+
+  escape_ = false;
+  switch (c) {
+    case '"':
+    case '\\':
+    case '/':
+      buffer_ += c;
+      break;
+    case 'b':
+      buffer_ += '\b';
+      break;
+    case 'f':
+      buffer_ += '\f';
+      break;
+    case 'n':
+      buffer_ += '\n';
+      break;
+    case 'r':
+      buffer_ += '\r';
+      break;
+    case 't':
+      buffer_ += '\t';
+      break;
+    default:
+      throwInvalid("invalid escape sequence");
+  }
+}
+
+void
+JsonStreamParser::startValue(char c) {
+  switch (c) {
+    case '{':
+      containers_.push_back(c);
+      handler_.onStartObject();
+      expect_ = Expect::KeyOrObjectEnd;
+      break;
+    case '[':
+      containers_.push_back(c);
+      handler_.onStartArray();
+      expect_ = Expect::ValueOrArrayEnd;
+      break;
+    case '"':
+      token_ = Token::String;
+      isKey_ = false;
+      break;
+    case 't':
+    case 'f':
+    case 'n':
+      token_ = Token::Literal;
+      buffer_.assign(1, c);
+      break;
+    default:
+      if (c == '-' || ('0' <= c && c <= '9')) {
+        token_ = Token::Number;
+        buffer_.assign(1, c);
+      } else {
+        throwInvalid("expecting value");
+      }
+  }
+}
+
+void
+JsonStreamParser::endValue() {
+  expect_ = containers_.empty() ? Expect::Done : Expect::CommaOrEnd;
+}
+
+void
+JsonStreamParser::endContainer(char c) {
+  if (containers_.empty() || (c == '}' && containers_.back() != '{') ||
+      (c == ']' && containers_.back() != '[') || (c != '}' && c != ']')) {
+    throwInvalid("unexpected character");
+  }
+
+  containers_.pop_back();
+  if (c == '}') {
+    handler_.onEndObject();
+  } else {
+    handler_.onEndArray();
+  }
+  endValue();
+}
+
+void
+JsonStreamParser::endNumber() {
+  char* end = nullptr;
+  std::strtod(buffer_.c_str(), &end);
+  if (end != buffer_.c_str() + buffer_.size()) {
+    throwInvalid("invalid number");
+  }
+
+  token_ = Token::None;
+  handler_.onNumber(buffer_);
+  buffer_.clear();
+  endValue();
+}
+
+void
+JsonStreamParser::endLiteral() {
+  token_ = Token::None;
+  if (buffer_ == "true") {
+    handler_.onBool(true);
+  } else if (buffer_ == "false") {
+    handler_.onBool(false);
+  } else if (buffer_ == "null") {
+    handler_.onNull();
+  } else {
+    throwInvalid("invalid literal");
+  }
+  buffer_.clear();
+  endValue();
+}
+
+void
+JsonStreamParser::appendCodePoint(unsigned int codePoint) {
+  if (codePoint < 0x80) {
+    buffer_ += static_cast<char>(codePoint);
+  } else if (codePoint < 0x800) {
+    buffer_ += static_cast<char>(0xC0 | (codePoint >> 6));
+    buffer_ += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else if (codePoint < 0x10000) {
+    buffer_ += static_cast<char>(0xE0 | (codePoint >> 12));
+    buffer_ += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    buffer_ += static_cast<char>(0x80 | (codePoint & 0x3F));
+  } else {
+    buffer_ += static_cast<char>(0xF0 | (codePoint >> 18));
+    buffer_ += static_cast<char>(0x80 | ((codePoint >> 12) & 0x3F));
+    buffer_ += static_cast<char>(0x80 | ((codePoint >> 6) & 0x3F));
+    buffer_ += static_cast<char>(0x80 | (codePoint & 0x3F));
+  }
+}
+
+}  // namespace Utils
+
+}  // namespace IOTA
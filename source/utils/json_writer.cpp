@@ -0,0 +1,199 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <iota/utils/json_writer.hpp>
+
+namespace IOTA {
+
+namespace Utils {
+
+JsonWriter::JsonWriter(std::size_t capacity) : afterKey_(false) {
+  out_.reserve(capacity);
+}
+
+JsonWriter&
+JsonWriter::startObject() {
+  separate();
+  out_ += '{';
+  first_.push_back(true);
+  return *this;
+}
+
+JsonWriter&
+JsonWriter::endObject() {
+  out_ += '}';
+  first_.pop_back();
+  return *this;
+}
+
+JsonWriter&
+JsonWriter::startArray() {
+  separate();
+  out_ += '[';
+  first_.push_back(true);
+  return *this;
+}
+
+JsonWriter&
+JsonWriter::endArray() {
+  out_ += ']';
+  first_.pop_back();
+  return *this;
+}
+
+JsonWriter&
+JsonWriter::key(const std::string& key) {
+  separate();
+  writeString(key);
+  out_ += ':';
+  afterKey_ = true;
+  return *this;
+}
+
+JsonWriter&
+JsonWriter::value(const std::string& value) {
+  separate();
+  writeString(value);
+  return *this;
+}
+
+JsonWriter&
+JsonWriter::value(const char* value) {
+  return this->value(std::string(value));
+}
+
+JsonWriter&
+JsonWriter::value(int64_t value) {
+  separate();
+  out_ += std::to_string(value);
+  return *this;
+}
+
+JsonWriter&
+JsonWriter::value(int value) {
+  return this->value(static_cast<int64_t>(value));
+}
+
+JsonWriter&
+JsonWriter::value(bool value) {
+  separate();
+  out_ += value ? "true" : "false";
+  return *this;
+}
+
+JsonWriter&
+JsonWriter::value(const std::vector<std::string>& values) {
+  std::size_t size = 2;
+  for (const auto& v : values) {
+    size += v.size() + 3;
+  }
+  reserve(size);
+
+  startArray();
+  for (const auto& v : values) {
+    value(v);
+  }
+  return endArray();
+}
+
+const std::string&
+JsonWriter::str() const {
+  return out_;
+}
+
+void
+JsonWriter::reserve(std::size_t size) {
+  out_.reserve(out_.size() + size);
+}
+
+void
+JsonWriter::separate() {
+  if (afterKey_) {
+    afterKey_ = false;
+    return;
+  }
+
+  if (!first_.empty()) {
+    if (!first_.back()) {
+      out_ += ',';
+    }
+    first_.back() = false;
+  }
+}
+
+void
+JsonWriter::writeString(const std::string& str) {
+  static const char* hex = "0123456789abcdef";
+
+  out_ += '"';
+
+  //! trytes never need escaping: copy runs of plain chars at once
+  std::size_t plain = 0;
+  for (std::size_t i = 0; i < str.size(); ++i) {
+    auto c = static_cast<unsigned char>(str[i]);
+
+    if (c >= 0x20 && c != '"' && c != '\\') {
+      continue;
+    }
+
+    out_.append(str, plain, i - plain);
+    plain = i + 1;
+
+    switch (c) {
+      case '"':
+        out_ += "\\\"";
+        break;
+      case '\\':
+        out_ += "\\\\";
+        break;
+      case '\n':
+        out_ += "\\n";
+        break;
+      case '\r':
+        out_ += "\\r";
+        break;
+      case '\t':
+        out_ += "\\t";
+        break;
+      case '\b':
+        out_ += "\\b";
+        break;
+      case '\f':
+        out_ += "\\f";
+        break;
+      default:
+        out_ += "\\u00";
+        out_ += hex[c >> 4];
+        out_ += hex[c & 0xF];
+    }
+  }
+
+  out_.append(str, plain, std::string::npos);
+  out_ += '"';
+}
+
+}  // namespace Utils
+
+}  // namespace IOTA
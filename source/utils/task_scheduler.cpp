@@ -0,0 +1,355 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/utils/task_scheduler.hpp>
+
+namespace IOTA {
+
+namespace Utils {
+
+namespace {
+
+//! scheduler owning the calling thread, if any
+thread_local const TaskScheduler* currentScheduler = nullptr;
+
+//! index of the calling thread in its scheduler
+thread_local std::size_t currentIndex = 0;
+
+std::size_t
+defaultSize(std::size_t size) {
+  if (size) {
+    return size;
+  }
+
+  return std::max(1U, std::thread::hardware_concurrency());
+}
+
+}  // namespace
+
+TaskScheduler::TaskScheduler(std::size_t size)
+    : size_(defaultSize(size)), pending_(0), stopping_(false), started_(false) {
+}
+
+TaskScheduler::~TaskScheduler() {
+  {
+    std::lock_guard<std::mutex> lock(mutex_);
+    stopping_ = true;
+  }
+
+  cv_.notify_all();
+
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+void
+TaskScheduler::spawn(std::function<void()> task) {
+  start();
+
+  {
+    //! count the task once it is queued, so that woken threads always find it
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    {
+      auto&                       queue = *queues_[currentQueue()];
+      std::lock_guard<std::mutex> queueLock(queue.mutex);
+      queue.tasks.push_back(std::move(task));
+    }
+
+    ++pending_;
+  }
+
+  cv_.notify_one();
+}
+
+bool
+TaskScheduler::runPending() {
+  std::function<void()> task;
+
+  if (!started_ || !take(task)) {
+    return false;
+  }
+
+  try {
+    task();
+  } catch (...) {
+  }
+
+  return true;
+}
+
+void
+TaskScheduler::parallelFor(std::size_t count, const std::function<void(std::size_t)>& fn) {
+  std::atomic<std::size_t> next(0);
+  std::atomic<bool>        failed(false);
+  std::exception_ptr       error;
+  TaskGroup                group(*this);
+
+  auto loop = [&] {
+    for (std::size_t i = next++; i < count && !failed; i = next++) {
+      try {
+        fn(i);
+      } catch (...) {
+        failed = true;
+        throw;
+      }
+    }
+  };
+
+  for (std::size_t helpers = std::min(count, getSize()); helpers > 1; --helpers) {
+    group.run(loop);
+  }
+
+  //! the calling thread takes its share, the helpers may not even have started yet
+  try {
+    loop();
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  try {
+    group.wait();
+  } catch (...) {
+    if (!error) {
+      error = std::current_exception();
+    }
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+std::size_t
+TaskScheduler::getSize() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return size_;
+}
+
+void
+TaskScheduler::setSize(std::size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (started_) {
+    throw Errors::IllegalState("Task scheduler already started");
+  }
+
+  size_ = defaultSize(size);
+}
+
+TaskScheduler&
+TaskScheduler::getDefault() {
+  static TaskScheduler scheduler;
+  return scheduler;
+}
+
+void
+TaskScheduler::start() {
+  if (started_) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+
+  if (started_) {
+    return;
+  }
+
+  for (std::size_t i = 0; i <= size_; ++i) {
+    queues_.emplace_back(new Queue);
+  }
+
+  for (std::size_t i = 0; i < size_; ++i) {
+    threads_.emplace_back(&TaskScheduler::run, this, i);
+  }
+
+  started_ = true;
+}
+
+bool
+TaskScheduler::take(std::function<void()>& task) {
+  auto own   = currentQueue();
+  auto count = queues_.size();
+
+  //! newest task of our own queue first: it is the most likely to be hot in cache
+  if (own < size_) {
+    auto&                       queue = *queues_[own];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.back());
+      queue.tasks.pop_back();
+    }
+  }
+
+  //! otherwise steal the oldest task of another queue, the shared one included
+  for (std::size_t i = 0; !task && i < count; ++i) {
+    auto&                       queue = *queues_[(own + 1 + i) % count];
+    std::lock_guard<std::mutex> lock(queue.mutex);
+
+    if (!queue.tasks.empty()) {
+      task = std::move(queue.tasks.front());
+      queue.tasks.pop_front();
+    }
+  }
+
+  if (!task) {
+    return false;
+  }
+
+  std::lock_guard<std::mutex> lock(mutex_);
+  --pending_;
+
+  return true;
+}
+
+void
+TaskScheduler::run(std::size_t index) {
+  currentScheduler = this;
+  currentIndex     = index;
+
+  for (;;) {
+    std::function<void()> task;
+
+    if (take(task)) {
+      try {
+        task();
+      } catch (...) {
+      }
+
+      continue;
+    }
+
+    std::unique_lock<std::mutex> lock(mutex_);
+
+    cv_.wait(lock, [this] { return stopping_ || pending_ > 0; });
+
+    //! pending tasks are still run when stopping
+    if (stopping_ && pending_ == 0) {
+      return;
+    }
+  }
+}
+
+std::size_t
+TaskScheduler::currentQueue() const {
+  return currentScheduler == this ? currentIndex : size_;
+}
+
+TaskGroup::TaskGroup(TaskScheduler& scheduler)
+    : scheduler_(scheduler), state_(std::make_shared<State>()) {
+}
+
+TaskGroup::~TaskGroup() {
+  try {
+    wait();
+  } catch (...) {
+  }
+}
+
+void
+TaskGroup::run(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+
+    ++state_->pending;
+    state_->tasks.push_back(std::move(task));
+  }
+
+  //! the waiting thread may take the task itself
+  state_->cv.notify_all();
+
+  auto state = state_;
+
+  scheduler_.spawn([state] {
+    std::unique_lock<std::mutex> lock(state->mutex);
+    runQueued(*state, lock, false);
+  });
+}
+
+void
+TaskGroup::wait() {
+  std::unique_lock<std::mutex> lock(state_->mutex);
+
+  while (state_->pending) {
+    //! help instead of blocking, but only with our own tasks: they may be queued behind us
+    if (!runQueued(*state_, lock, true)) {
+      state_->cv.wait(lock, [this] { return state_->pending == 0 || !state_->tasks.empty(); });
+    }
+  }
+
+  std::exception_ptr error;
+  std::swap(error, state_->error);
+  lock.unlock();
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+bool
+TaskGroup::runQueued(State& state, std::unique_lock<std::mutex>& lock, bool newest) {
+  if (state.tasks.empty()) {
+    return false;
+  }
+
+  std::function<void()> task;
+
+  if (newest) {
+    task = std::move(state.tasks.back());
+    state.tasks.pop_back();
+  } else {
+    task = std::move(state.tasks.front());
+    state.tasks.pop_front();
+  }
+
+  lock.unlock();
+
+  std::exception_ptr error;
+
+  try {
+    task();
+  } catch (...) {
+    error = std::current_exception();
+  }
+
+  lock.lock();
+
+  if (error && !state.error) {
+    state.error = error;
+  }
+
+  if (--state.pending == 0) {
+    state.cv.notify_all();
+  }
+
+  return true;
+}
+
+}  // namespace Utils
+
+}  // namespace IOTA
@@ -0,0 +1,167 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/utils/worker_pool.hpp>
+
+namespace IOTA {
+
+namespace Utils {
+
+const std::size_t WorkerPool::DefaultSize;
+
+WorkerPool::WorkerPool(std::size_t size) : state_(std::make_shared<State>()), size_(size) {
+  if (size_ == 0) {
+    throw Errors::IllegalState("Worker pool needs at least one thread");
+  }
+}
+
+WorkerPool::~WorkerPool() {
+  std::vector<std::thread> threads;
+
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+    state_->stopping = true;
+    threads.swap(threads_);
+  }
+
+  state_->cv.notify_all();
+
+  for (auto& thread : threads) {
+    //! the last reference to the pool was dropped by a task: the thread exits by itself
+    if (thread.get_id() == std::this_thread::get_id()) {
+      thread.detach();
+    } else {
+      thread.join();
+    }
+  }
+}
+
+std::size_t
+WorkerPool::getSize() const {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+  return size_;
+}
+
+void
+WorkerPool::setSize(std::size_t size) {
+  std::lock_guard<std::mutex> lock(state_->mutex);
+
+  if (!threads_.empty()) {
+    throw Errors::IllegalState("Worker pool already started");
+  }
+
+  if (size == 0) {
+    throw Errors::IllegalState("Worker pool needs at least one thread");
+  }
+
+  size_ = size;
+}
+
+void
+WorkerPool::push(std::function<void()> task) {
+  {
+    std::lock_guard<std::mutex> lock(state_->mutex);
+
+    state_->tasks.push_back(std::move(task));
+
+    while (threads_.size() < size_) {
+      threads_.emplace_back(&WorkerPool::run, state_);
+    }
+  }
+
+  state_->cv.notify_one();
+}
+
+void
+WorkerPool::run(const std::shared_ptr<State>& state) {
+  for (;;) {
+    std::function<void()> task;
+
+    {
+      std::unique_lock<std::mutex> lock(state->mutex);
+
+      state->cv.wait(lock, [&] { return state->stopping || !state->tasks.empty(); });
+
+      if (state->tasks.empty()) {
+        return;
+      }
+
+      task = std::move(state->tasks.front());
+      state->tasks.pop_front();
+    }
+
+    task();
+  }
+}
+
+WorkerPool::Loop::Loop(std::size_t count, std::function<void(std::size_t)> fn)
+    : count_(count), fn_(std::move(fn)), next_(0), done_(0) {
+}
+
+void
+WorkerPool::Loop::run() {
+  for (std::size_t i = next_++; i < count_; i = next_++) {
+    std::exception_ptr error;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      error = error_;
+    }
+
+    if (!error) {
+      try {
+        fn_(i);
+      } catch (...) {
+        error = std::current_exception();
+      }
+    }
+
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (error && !error_) {
+      error_ = error;
+    }
+
+    if (++done_ == count_) {
+      cv_.notify_all();
+    }
+  }
+}
+
+void
+WorkerPool::Loop::wait() {
+  std::unique_lock<std::mutex> lock(mutex_);
+
+  cv_.wait(lock, [this] { return done_ == count_; });
+
+  if (error_) {
+    std::rethrow_exception(error_);
+  }
+}
+
+}  // namespace Utils
+
+}  // namespace IOTA
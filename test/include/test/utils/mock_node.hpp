@@ -0,0 +1,706 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <random>
+#include <set>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#include <ws2tcpip.h>
+#else
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+#include <json.hpp>
+
+#include <iota/constants.hpp>
+#include <iota/models/transaction.hpp>
+#include <iota/utils/compression.hpp>
+#include <test/utils/constants.hpp>
+
+using json = nlohmann::json;
+
+//! milestone referenced by the mock node
+static const std::string MOCK_NODE_MILESTONE =
+    "MILESTONE999999999999999999999999999999999999999999999999999999999999999999999999";
+static const int64_t MOCK_NODE_MILESTONE_INDEX = 1000;
+
+/**
+ * IRI node mock, serving the api commands used by the library over http on localhost.
+ *
+ * The tangle is kept in memory and filled from fixtures: transactions, confirmation states and
+ * balances. PoW is not checked, attachToTangle does not do any. Latency and failures can be
+ * injected to test timeouts, retries and failover, or to benchmark the library without network.
+ */
+class MockNode {
+public:
+#ifdef _WIN32
+  using Socket = SOCKET;
+#else
+  using Socket = int;
+#endif
+
+public:
+  /**
+   * Starts listening on an ephemeral localhost port.
+   */
+  MockNode() : running_(true), latency_(0), failNext_(0), failStatus_(503), failureRate_(0) {
+#ifdef _WIN32
+    WSADATA data;
+    WSAStartup(MAKEWORD(2, 2), &data);
+#endif
+
+    sockaddr_in addr{};
+    socklen_t   len = sizeof(addr);
+
+    addr.sin_family      = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    addr.sin_port        = 0;
+
+    listener_ = socket(AF_INET, SOCK_STREAM, 0);
+    bind(listener_, reinterpret_cast<sockaddr*>(&addr), sizeof(addr));
+    listen(listener_, 64);
+    getsockname(listener_, reinterpret_cast<sockaddr*>(&addr), &len);
+    port_ = ntohs(addr.sin_port);
+
+    acceptor_ = std::thread([this] { accept(); });
+  }
+
+  /**
+   * Closes all the connections and stops the server.
+   */
+  ~MockNode() {
+    running_ = false;
+
+    shutdown(listener_, 2);
+    close(listener_);
+    acceptor_.join();
+
+    {
+      std::lock_guard<std::mutex> lock(connectionsMutex_);
+      for (auto s : open_) {
+        shutdown(s, 2);
+      }
+    }
+
+    for (auto& connection : connections_) {
+      connection.join();
+    }
+
+#ifdef _WIN32
+    WSACleanup();
+#endif
+  }
+
+  MockNode(const MockNode&) = delete;
+  MockNode& operator=(const MockNode&) = delete;
+
+public:
+  const std::string& getHost() const {
+    static const std::string host = "http://localhost";
+    return host;
+  }
+
+  uint16_t getPort() const { return port_; }
+
+public:
+  /**
+   * Add a transaction to the tangle.
+   *
+   * @param trytes Trytes of the transaction.
+   * @param confirmed Whether the transaction is confirmed.
+   *
+   * @return The hash of the transaction.
+   */
+  std::string addTransaction(const std::string& trytes, bool confirmed = true) {
+    IOTA::Models::Transaction trx(trytes);
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    add(trx, trytes, confirmed);
+    return trx.getHash();
+  }
+
+  /**
+   * @param address Address, without checksum.
+   * @param balance Confirmed balance of the address.
+   */
+  void setBalance(const std::string& address, int64_t balance) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    balances_[address.substr(0, IOTA::AddressLength)] = balance;
+  }
+
+  /**
+   * @param hash Transaction hash.
+   * @param confirmed Whether the transaction is confirmed.
+   */
+  void setConfirmed(const std::string& hash, bool confirmed) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (confirmed) {
+      confirmed_.insert(hash);
+    } else {
+      confirmed_.erase(hash);
+    }
+  }
+
+  /**
+   * @param hash Transaction hash.
+   * @param consistent Whether the transaction passes checkConsistency, the default.
+   */
+  void setConsistent(const std::string& hash, bool consistent) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    if (consistent) {
+      inconsistent_.erase(hash);
+    } else {
+      inconsistent_.insert(hash);
+    }
+  }
+
+  /**
+   * @param latency Delay before each reply.
+   */
+  void setLatency(const std::chrono::microseconds& latency) { latency_ = latency.count(); }
+
+  /**
+   * Reply to the next requests with an error.
+   *
+   * @param count Number of requests to fail.
+   * @param status Http status of the error replies.
+   */
+  void failNext(int count, int status = 503) {
+    failStatus_ = status;
+    failNext_   = count;
+  }
+
+  /**
+   * Reply to random requests with a 503 error.
+   *
+   * @param rate Ratio of failed requests.
+   */
+  void setFailureRate(double rate) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    failureRate_ = rate;
+  }
+
+  /**
+   * @param command Api command.
+   *
+   * @return Number of requests received for the command.
+   */
+  std::size_t getRequestCount(const std::string& command) const {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    auto it = requests_.find(command);
+    return it == requests_.end() ? 0 : it->second;
+  }
+
+  /**
+   * @return Number of transactions in the tangle.
+   */
+  std::size_t size() const {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return trytes_.size();
+  }
+
+public:
+  /**
+   * Handle an api request.
+   *
+   * @param body The request body.
+   * @param status Set with the http status of the reply.
+   *
+   * @return The reply body.
+   */
+  std::string handle(const std::string& body, int& status) {
+    json req;
+
+    try {
+      req = json::parse(body);
+    } catch (const std::exception&) {
+      status = 400;
+      return json{ { "error", "Invalid JSON" } }.dump();
+    }
+
+    auto command = req.count("command") && req["command"].is_string()
+                       ? req["command"].get<std::string>()
+                       : std::string();
+    bool fail    = false;
+
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+
+      ++requests_[command];
+      fail = failureRate_ > 0 && std::uniform_real_distribution<>(0, 1)(random_) < failureRate_;
+    }
+
+    if (latency_ > 0) {
+      std::this_thread::sleep_for(std::chrono::microseconds(latency_.load()));
+    }
+
+    if (failNext_-- > 0 || fail) {
+      status = fail ? 503 : failStatus_.load();
+      return json{ { "error", "Injected failure" } }.dump();
+    }
+    failNext_ = std::max(0, failNext_.load());
+
+    std::lock_guard<std::mutex> lock(mutex_);
+    status = 200;
+
+    try {
+      return dispatch(command, req).dump();
+    } catch (const std::exception& e) {
+      status = 400;
+      return json{ { "error", e.what() } }.dump();
+    }
+  }
+
+private:
+  /**
+   * Add a transaction to the tangle, the mutex must be locked.
+   */
+  void add(const IOTA::Models::Transaction& trx, const std::string& trytes, bool confirmed) {
+    const auto& hash = trx.getHash();
+
+    if (trytes_.count(hash)) {
+      return;
+    }
+
+    trytes_[hash] = trytes;
+    addresses_[trx.getAddress().toTrytes()].push_back(hash);
+    bundles_[trx.getBundle()].push_back(hash);
+    tags_[trx.getTag().toTrytesWithPadding()].push_back(hash);
+    approvees_[trx.getTrunkTransaction()].push_back(hash);
+    if (trx.getBranchTransaction() != trx.getTrunkTransaction()) {
+      approvees_[trx.getBranchTransaction()].push_back(hash);
+    }
+
+    if (trx.getValue() < 0) {
+      spent_.insert(trx.getAddress().toTrytes());
+    }
+
+    if (confirmed) {
+      confirmed_.insert(hash);
+    }
+
+    tips_.erase(trx.getTrunkTransaction());
+    tips_.erase(trx.getBranchTransaction());
+    if (!approvees_.count(hash)) {
+      tips_.insert(hash);
+    }
+  }
+
+  /**
+   * Run an api command, the mutex must be locked.
+   */
+  json dispatch(const std::string& command, const json& req) {
+    if (command == "getNodeInfo") {
+      return json{ { "appName", "IRI Mock" },
+                   { "appVersion", "1.0.0" },
+                   { "jreAvailableProcessors", 1 },
+                   { "jreFreeMemory", 0 },
+                   { "jreMaxMemory", 0 },
+                   { "jreTotalMemory", 0 },
+                   { "latestMilestone", MOCK_NODE_MILESTONE },
+                   { "latestMilestoneIndex", MOCK_NODE_MILESTONE_INDEX },
+                   { "latestSolidSubtangleMilestone", MOCK_NODE_MILESTONE },
+                   { "latestSolidSubtangleMilestoneIndex", MOCK_NODE_MILESTONE_INDEX },
+                   { "neighbors", 0 },
+                   { "packetsQueueSize", 0 },
+                   { "time", 0 },
+                   { "tips", tips_.size() },
+                   { "transactionsToRequest", 0 } };
+    } else if (command == "getTips") {
+      return json{ { "hashes", std::vector<std::string>(tips_.begin(), tips_.end()) } };
+    } else if (command == "getNeighbors") {
+      return json{ { "neighbors", json::array() } };
+    } else if (command == "addNeighbors") {
+      return json{ { "addedNeighbors", req.at("uris").size() } };
+    } else if (command == "removeNeighbors") {
+      return json{ { "removedNeighbors", req.at("uris").size() } };
+    } else if (command == "findTransactions") {
+      return json{ { "hashes", findTransactions(req) } };
+    } else if (command == "getTrytes") {
+      std::vector<std::string> trytes;
+
+      for (const auto& hash : req.at("hashes")) {
+        auto it = trytes_.find(hash.get<std::string>());
+        trytes.push_back(it == trytes_.end() ? std::string(IOTA::TrxTrytesLength, '9')
+                                             : it->second);
+      }
+
+      return json{ { "trytes", trytes } };
+    } else if (command == "getInclusionStates") {
+      std::vector<bool> states;
+
+      for (const auto& hash : req.at("transactions")) {
+        states.push_back(confirmed_.count(hash.get<std::string>()) != 0);
+      }
+
+      return json{ { "states", states } };
+    } else if (command == "getBalances") {
+      std::vector<std::string> balances;
+
+      for (const auto& address : req.at("addresses")) {
+        auto it = balances_.find(address.get<std::string>());
+        balances.push_back(std::to_string(it == balances_.end() ? 0 : it->second));
+      }
+
+      return json{ { "balances", balances },
+                   { "references", { MOCK_NODE_MILESTONE } },
+                   { "milestoneIndex", MOCK_NODE_MILESTONE_INDEX } };
+    } else if (command == "wereAddressesSpentFrom") {
+      std::vector<bool> states;
+
+      for (const auto& address : req.at("addresses")) {
+        states.push_back(spent_.count(address.get<std::string>()) != 0);
+      }
+
+      return json{ { "states", states } };
+    } else if (command == "getTransactionsToApprove") {
+      std::vector<std::string> tips(tips_.begin(), tips_.end());
+
+      if (tips.empty()) {
+        tips.push_back(MOCK_NODE_MILESTONE);
+      }
+
+      //! a reference is always approved
+      std::uniform_int_distribution<std::size_t> pick(0, tips.size() - 1);
+      auto reference = req.find("reference");
+
+      if (reference != req.end() && reference->is_string() &&
+          !reference->get<std::string>().empty()) {
+        return json{ { "trunkTransaction", reference->get<std::string>() },
+                     { "branchTransaction", tips[pick(random_)] } };
+      }
+
+      return json{ { "trunkTransaction", tips[pick(random_)] },
+                   { "branchTransaction", tips[pick(random_)] } };
+    } else if (command == "attachToTangle") {
+      return json{ { "trytes", attachToTangle(req) } };
+    } else if (command == "interruptAttachingToTangle") {
+      return json::object();
+    } else if (command == "broadcastTransactions" || command == "storeTransactions") {
+      for (const auto& trytes : req.at("trytes")) {
+        add(IOTA::Models::Transaction(trytes.get<std::string>()), trytes, false);
+      }
+
+      return json::object();
+    } else if (command == "checkConsistency") {
+      for (const auto& tail : req.at("tails")) {
+        if (!trytes_.count(tail.get<std::string>())) {
+          throw std::runtime_error("Invalid parameters");
+        }
+      }
+
+      for (const auto& tail : req.at("tails")) {
+        if (inconsistent_.count(tail.get<std::string>())) {
+          return json{ { "state", false }, { "info", "tails are not consistent" } };
+        }
+      }
+
+      return json{ { "state", true }, { "info", "" } };
+    }
+
+    throw std::runtime_error("Command [" + command + "] is unknown");
+  }
+
+  /**
+   * Matches of any value of a field, intersected over the fields.
+   */
+  std::vector<std::string> findTransactions(const json& req) const {
+    std::set<std::string> result;
+    bool                  first = true;
+
+    for (const auto& field : { std::make_pair("addresses", &addresses_),
+                               std::make_pair("bundles", &bundles_),
+                               std::make_pair("tags", &tags_),
+                               std::make_pair("approvees", &approvees_) }) {
+      if (!req.count(field.first)) {
+        continue;
+      }
+
+      std::set<std::string> matches;
+      for (const auto& value : req.at(field.first)) {
+        auto it = field.second->find(value.get<std::string>());
+
+        if (it != field.second->end()) {
+          matches.insert(it->second.begin(), it->second.end());
+        }
+      }
+
+      if (first) {
+        result.swap(matches);
+        first = false;
+      } else {
+        std::set<std::string> intersection;
+        std::set_intersection(result.begin(), result.end(), matches.begin(), matches.end(),
+                              std::inserter(intersection, intersection.begin()));
+        result.swap(intersection);
+      }
+    }
+
+    return std::vector<std::string>(result.begin(), result.end());
+  }
+
+  /**
+   * Chain the transactions like the node does, without PoW.
+   */
+  std::vector<std::string> attachToTangle(const json& req) const {
+    auto                     trunk  = req.at("trunkTransaction").get<std::string>();
+    auto                     branch = req.at("branchTransaction").get<std::string>();
+    std::vector<std::string> result;
+    std::string              previous;
+
+    for (const auto& trytes : req.at("trytes")) {
+      IOTA::Models::Transaction trx(trytes.get<std::string>());
+
+      trx.setTrunkTransaction(previous.empty() ? trunk : previous);
+      trx.setBranchTransaction(previous.empty() ? branch : trunk);
+      trx.setAttachmentTimestamp(std::chrono::duration_cast<std::chrono::milliseconds>(
+                                     std::chrono::system_clock::now().time_since_epoch())
+                                     .count());
+
+      result.push_back(trx.toTrytes());
+      previous = IOTA::Models::Transaction(result.back()).getHash();
+    }
+
+    return result;
+  }
+
+private:
+  void accept() {
+    while (running_) {
+      auto s = ::accept(listener_, nullptr, nullptr);
+
+      if (!running_) {
+        if (s >= 0) {
+          close(s);
+        }
+        break;
+      }
+
+      if (s < 0) {
+        continue;
+      }
+
+      std::lock_guard<std::mutex> lock(connectionsMutex_);
+      open_.insert(s);
+      connections_.emplace_back([this, s] {
+        serve(s);
+
+        std::lock_guard<std::mutex> lock(connectionsMutex_);
+        open_.erase(s);
+        close(s);
+      });
+    }
+  }
+
+  /**
+   * Serve the http requests of a keep-alive connection.
+   */
+  void serve(Socket s) {
+    std::string buffer;
+
+    while (running_) {
+      std::size_t end;
+
+      while ((end = buffer.find("\r\n\r\n")) == std::string::npos) {
+        if (!receive(s, buffer)) {
+          return;
+        }
+      }
+
+      auto headers = parseHeaders(buffer.substr(0, end));
+      buffer.erase(0, end + 4);
+
+      std::size_t length = headers.count("content-length") ? std::stoul(headers["content-length"])
+                                                           : 0;
+
+      if (headers["expect"] == "100-continue" && !sendAll(s, "HTTP/1.1 100 Continue\r\n\r\n")) {
+        return;
+      }
+
+      while (buffer.size() < length) {
+        if (!receive(s, buffer)) {
+          return;
+        }
+      }
+
+      auto body = buffer.substr(0, length);
+      buffer.erase(0, length);
+
+      if (headers["content-encoding"] == "gzip" || headers["content-encoding"] == "deflate") {
+        body = IOTA::Utils::inflate(body);
+      }
+
+      int  status = 200;
+      auto reply  = handle(body, status);
+      auto res    = "HTTP/1.1 " + std::to_string(status) + (status == 200 ? " OK" : " Error") +
+                 "\r\nContent-Type: application/json\r\nContent-Length: " +
+                 std::to_string(reply.size()) + "\r\n\r\n" + reply;
+
+      if (!sendAll(s, res) || headers["connection"] == "close") {
+        return;
+      }
+    }
+  }
+
+  /**
+   * Lowercased header names, mapped to their values.
+   */
+  static std::map<std::string, std::string> parseHeaders(const std::string& head) {
+    std::map<std::string, std::string> headers;
+    std::size_t                        begin = head.find("\r\n");
+
+    while (begin != std::string::npos) {
+      begin += 2;
+
+      auto end   = head.find("\r\n", begin);
+      auto line  = head.substr(begin, end == std::string::npos ? std::string::npos : end - begin);
+      auto colon = line.find(':');
+
+      if (colon != std::string::npos) {
+        auto name  = line.substr(0, colon);
+        auto value = line.substr(line.find_first_not_of(' ', colon + 1) == std::string::npos
+                                     ? line.size()
+                                     : line.find_first_not_of(' ', colon + 1));
+
+        std::transform(name.begin(), name.end(), name.begin(), ::tolower);
+        headers[name] = value;
+      }
+
+      begin = end;
+    }
+
+    return headers;
+  }
+
+  static bool receive(Socket s, std::string& buffer) {
+    char data[16384];
+    auto size = recv(s, data, sizeof(data), 0);
+
+    if (size <= 0) {
+      return false;
+    }
+
+    buffer.append(data, size);
+    return true;
+  }
+
+  static bool sendAll(Socket s, const std::string& data) {
+    std::size_t sent = 0;
+
+    while (sent < data.size()) {
+      auto size = send(s, data.data() + sent, data.size() - sent, 0);
+
+      if (size <= 0) {
+        return false;
+      }
+
+      sent += size;
+    }
+
+    return true;
+  }
+
+#ifdef _WIN32
+  static void close(Socket s) { closesocket(s); }
+#else
+  static void close(Socket s) { ::close(s); }
+#endif
+
+private:
+  //! tangle, protected by mutex_
+  mutable std::mutex                                        mutex_;
+  std::unordered_map<std::string, std::string>              trytes_;
+  std::unordered_map<std::string, std::vector<std::string>> addresses_;
+  std::unordered_map<std::string, std::vector<std::string>> bundles_;
+  std::unordered_map<std::string, std::vector<std::string>> tags_;
+  std::unordered_map<std::string, std::vector<std::string>> approvees_;
+  std::unordered_map<std::string, int64_t>                  balances_;
+  std::set<std::string>                                     confirmed_;
+  std::set<std::string>                                     spent_;
+  std::set<std::string>                                     inconsistent_;
+  std::set<std::string>                                     tips_;
+  std::map<std::string, std::size_t>                        requests_;
+  std::minstd_rand                                          random_;
+
+  //! server
+  std::atomic<bool>        running_;
+  Socket                   listener_;
+  uint16_t                 port_;
+  std::thread              acceptor_;
+  std::mutex               connectionsMutex_;
+  std::set<Socket>         open_;
+  std::vector<std::thread> connections_;
+
+  //! fault injection
+  std::atomic<int64_t> latency_;
+  std::atomic<int>     failNext_;
+  std::atomic<int>     failStatus_;
+  double               failureRate_;
+};
+
+/**
+ * Fill a node with the transactions and balances of the account of ACCOUNT_2_SEED.
+ *
+ * @param node The node to fill.
+ * @param lastBundleConfirmed Whether the transactions of the last bundle are confirmed.
+ */
+inline void
+loadAccount2(MockNode& node, bool lastBundleConfirmed = true) {
+  for (const auto& trytes : { ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_2_TRX_1_TRYTES,
+                              ACCOUNT_2_BUNDLE_3_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_4_TRX_1_TRYTES }) {
+    node.addTransaction(trytes);
+  }
+
+  for (const auto& trytes : { ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES,
+                              ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES }) {
+    node.addTransaction(trytes, lastBundleConfirmed);
+  }
+
+  node.setBalance(ACCOUNT_2_ADDRESS_1_HASH_WITHOUT_CHECKSUM, ACCOUNT_2_ADDRESS_1_FUND);
+  node.setBalance(ACCOUNT_2_ADDRESS_2_HASH_WITHOUT_CHECKSUM, ACCOUNT_2_ADDRESS_2_FUND);
+  node.setBalance(ACCOUNT_2_ADDRESS_3_HASH_WITHOUT_CHECKSUM, ACCOUNT_2_ADDRESS_3_FUND);
+  node.setBalance(ACCOUNT_2_ADDRESS_4_HASH_WITHOUT_CHECKSUM, ACCOUNT_2_ADDRESS_4_FUND);
+  node.setBalance(ACCOUNT_2_ADDRESS_5_HASH_WITHOUT_CHECKSUM, ACCOUNT_2_ADDRESS_5_FUND);
+  node.setBalance(ACCOUNT_2_ADDRESS_6_HASH_WITHOUT_CHECKSUM, ACCOUNT_2_ADDRESS_6_FUND);
+}
@@ -0,0 +1,136 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/account.hpp>
+#include <iota/api/extended.hpp>
+#include <iota/models/bundle.hpp>
+#include <iota/models/seed.hpp>
+#include <iota/models/transaction.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/mock_node.hpp>
+
+TEST(Account, Refresh) {
+  MockNode            node;
+  IOTA::API::Extended api{ node.getHost(), node.getPort() };
+  IOTA::API::Account  account{ api, ACCOUNT_2_SEED };
+
+  loadAccount2(node);
+
+  auto res      = account.refresh();
+  auto expected = api.getAccountData(ACCOUNT_2_SEED, 0, 0, true, 0);
+
+  EXPECT_EQ(res.getAddresses(), expected.getAddresses());
+  EXPECT_EQ(res.getTransfers(), expected.getTransfers());
+  EXPECT_EQ(res.getBalance(), ACCOUNT_2_FUND);
+  EXPECT_EQ(account.getData().getBalance(), ACCOUNT_2_FUND);
+  EXPECT_EQ(account.getKnownTransactionsCount(), 7UL);
+}
+
+TEST(Account, RefreshWithoutChanges) {
+  MockNode            node;
+  IOTA::API::Extended api{ node.getHost(), node.getPort() };
+  IOTA::API::Account  account{ api, ACCOUNT_2_SEED };
+
+  loadAccount2(node);
+  account.refresh();
+
+  auto findTransactions = node.getRequestCount("findTransactions");
+  auto getTrytes        = node.getRequestCount("getTrytes");
+  auto getBalances      = node.getRequestCount("getBalances");
+  auto inclusions       = node.getRequestCount("getInclusionStates");
+
+  auto res = account.refresh();
+
+  //! a single findTransactions: nothing new, everything confirmed
+  EXPECT_EQ(node.getRequestCount("findTransactions"), findTransactions + 1);
+  EXPECT_EQ(node.getRequestCount("getTrytes"), getTrytes);
+  EXPECT_EQ(node.getRequestCount("getBalances"), getBalances);
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), inclusions);
+  EXPECT_EQ(res.getTransfers().size(), 5UL);
+  EXPECT_EQ(res.getBalance(), ACCOUNT_2_FUND);
+}
+
+TEST(Account, RefreshInclusionStates) {
+  MockNode            node;
+  IOTA::API::Extended api{ node.getHost(), node.getPort() };
+  IOTA::API::Account  account{ api, ACCOUNT_2_SEED };
+
+  loadAccount2(node, false);
+
+  auto res = account.refresh();
+  ASSERT_EQ(res.getTransfers().size(), 5UL);
+
+  auto tail =
+      std::find_if(res.getTransfers().begin(), res.getTransfers().end(),
+                   [](const IOTA::Models::Bundle& bundle) { return !bundle[0].getPersistence(); });
+  ASSERT_NE(tail, res.getTransfers().end());
+
+  auto getBalances = node.getRequestCount("getBalances");
+  auto inclusions  = node.getRequestCount("getInclusionStates");
+
+  //! still pending: only its state is requested again
+  account.refresh();
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), inclusions + 1);
+  EXPECT_EQ(node.getRequestCount("getBalances"), getBalances);
+
+  node.setConfirmed((*tail)[0].getHash(), true);
+
+  res = account.refresh();
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), inclusions + 2);
+  EXPECT_EQ(node.getRequestCount("getBalances"), getBalances + 1);
+
+  for (const auto& bundle : res.getTransfers()) {
+    EXPECT_TRUE(bundle[0].getPersistence());
+  }
+
+  //! everything is confirmed now
+  account.refresh();
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), inclusions + 2);
+}
+
+TEST(Account, RefreshNewAddress) {
+  MockNode            node;
+  IOTA::API::Extended api{ node.getHost(), node.getPort() };
+  IOTA::API::Account  account{ api, ACCOUNT_2_SEED };
+
+  loadAccount2(node);
+  ASSERT_EQ(account.refresh().getAddresses().size(), 6UL);
+
+  //! the last address, unused so far, gets a transaction
+  IOTA::Models::Bundle bundle;
+  bundle.addTransaction({ ACCOUNT_2_ADDRESS_6_HASH_WITHOUT_CHECKSUM, 0, "ACCOUNT", 42 });
+  bundle.finalize();
+  bundle.addTrytes({});
+  node.addTransaction(bundle[0].toTrytes());
+
+  auto res = account.refresh();
+
+  EXPECT_EQ(res.getAddresses().size(), 7UL);
+  EXPECT_EQ(res.getAddresses()[6], IOTA::Models::Seed(ACCOUNT_2_SEED).newAddress(6));
+  EXPECT_EQ(res.getTransfers().size(), 6UL);
+  EXPECT_EQ(account.getKnownTransactionsCount(), 8UL);
+}
@@ -0,0 +1,63 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstdio>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/archive_trytes_store.hpp>
+#include <test/utils/constants.hpp>
+
+static const std::string StorePath = "archive_trytes_store_test.bin";
+
+TEST(ArchiveTrytesStore, SaveAndLoad) {
+  std::remove(StorePath.c_str());
+
+  {
+    IOTA::API::ArchiveTrytesStore store(StorePath);
+    IOTA::Types::Trytes           trytes;
+
+    EXPECT_FALSE(store.load(BUNDLE_1_TRX_1_HASH, trytes));
+    EXPECT_FALSE(store.load("invalid", trytes));
+
+    EXPECT_TRUE(store.save(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES));
+    EXPECT_FALSE(store.save(BUNDLE_1_TRX_2_HASH, "invalid"));
+    EXPECT_EQ(store.size(), 1UL);
+
+    EXPECT_TRUE(store.load(BUNDLE_1_TRX_1_HASH, trytes));
+    EXPECT_EQ(trytes, BUNDLE_1_TRX_1_TRYTES);
+  }
+
+  //! transactions are kept across runs
+  {
+    IOTA::API::ArchiveTrytesStore store(StorePath);
+    IOTA::Types::Trytes           trytes;
+
+    EXPECT_TRUE(store.load(BUNDLE_1_TRX_1_HASH, trytes));
+    EXPECT_EQ(trytes, BUNDLE_1_TRX_1_TRYTES);
+  }
+
+  std::remove(StorePath.c_str());
+}
@@ -0,0 +1,131 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/coalescer.hpp>
+#include <iota/errors/bad_request.hpp>
+#include <test/utils/expect_exception.hpp>
+
+using Echo = std::vector<IOTA::Types::Trytes>;
+
+static Echo
+echo(const std::vector<IOTA::Types::Trytes>& items) {
+  return items;
+}
+
+TEST(Coalescer, Disabled) {
+  IOTA::API::Coalescer<Echo> coalescer;
+
+  EXPECT_FALSE(coalescer.enabled());
+
+  coalescer.setWindow(std::chrono::milliseconds(2));
+  EXPECT_TRUE(coalescer.enabled());
+  EXPECT_EQ(coalescer.getWindow(), std::chrono::microseconds(2000));
+}
+
+TEST(Coalescer, SingleCaller) {
+  IOTA::API::Coalescer<Echo> coalescer(std::chrono::milliseconds(1));
+
+  auto res = coalescer.join("", { "A", "B", "A" }, 0, echo);
+
+  EXPECT_EQ(*res.response, Echo({ "A", "B" }));
+  EXPECT_EQ(res.indexes, std::vector<std::size_t>({ 0, 1, 0 }));
+}
+
+TEST(Coalescer, ConcurrentCallers) {
+  IOTA::API::Coalescer<Echo> coalescer(std::chrono::milliseconds(200));
+  std::atomic<int>           fetches(0);
+  std::vector<std::thread>   threads;
+  std::vector<Echo>          results(8);
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    threads.emplace_back([&, i] {
+      IOTA::Types::Trytes item(1, "ABCDEFGH"[i]);
+
+      auto res = coalescer.join("", { item, "Z" }, 0, [&](const Echo& items) {
+        ++fetches;
+        return items;
+      });
+
+      for (auto index : res.indexes) {
+        results[i].push_back(res.response->at(index));
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  //! all callers joined the first batch well within the window
+  EXPECT_EQ(fetches, 1);
+
+  for (std::size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i], Echo({ IOTA::Types::Trytes(1, "ABCDEFGH"[i]), "Z" }));
+  }
+}
+
+TEST(Coalescer, Groups) {
+  IOTA::API::Coalescer<Echo> coalescer(std::chrono::milliseconds(50));
+  std::atomic<int>           fetches(0);
+
+  auto fetch = [&](const Echo& items) {
+    ++fetches;
+    return items;
+  };
+
+  std::thread other(
+      [&] { EXPECT_EQ(*coalescer.join("1", { "A" }, 0, fetch).response, Echo{ "A" }); });
+  EXPECT_EQ(*coalescer.join("2", { "B" }, 0, fetch).response, Echo{ "B" });
+  other.join();
+
+  EXPECT_EQ(fetches, 2);
+}
+
+TEST(Coalescer, MaxItems) {
+  IOTA::API::Coalescer<Echo> coalescer(std::chrono::seconds(60));
+
+  //! a full batch is sent without waiting for the window
+  auto res = coalescer.join("", { "A", "B" }, 2, echo);
+
+  EXPECT_EQ(*res.response, Echo({ "A", "B" }));
+}
+
+TEST(Coalescer, Error) {
+  IOTA::API::Coalescer<Echo> coalescer(std::chrono::milliseconds(1));
+
+  EXPECT_EXCEPTION(coalescer.join("", { "A" }, 0,
+                                  [](const Echo&) -> Echo {
+                                    throw IOTA::Errors::BadRequest("Invalid hashes input");
+                                  }),
+                   IOTA::Errors::BadRequest, "Invalid hashes input");
+
+  //! the failed batch does not prevent new ones
+  EXPECT_EQ(*coalescer.join("", { "B" }, 0, echo).response, Echo{ "B" });
+}
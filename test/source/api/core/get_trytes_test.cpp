@@ -48,3 +48,63 @@ TEST(Core, GetTrytesInvalidHash) {
 
   EXPECT_GE(res.getDuration(), 0);
 }
+
+TEST(Core, GetTrytesStream) {
+  IOTA::API::Core                  api(get_proxy_host(), get_proxy_port());
+  std::vector<IOTA::Types::Trytes> trytes;
+
+  api.getTrytes({ BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_HASH },
+                [&trytes](const IOTA::Types::Trytes& trx) { trytes.push_back(trx); });
+
+  ASSERT_EQ(trytes.size(), 2UL);
+  EXPECT_EQ(trytes[0], BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(trytes[1], BUNDLE_1_TRX_1_TRYTES);
+}
+
+TEST(Core, GetTrytesStreamInvalidHash) {
+  IOTA::API::Core api(get_proxy_host(), get_proxy_port());
+  int             calls = 0;
+
+  EXPECT_EXCEPTION(api.getTrytes({ "9999" }, [&calls](const IOTA::Types::Trytes&) { ++calls; }),
+                   IOTA::Errors::BadRequest, "Invalid hashes input")
+
+  EXPECT_EQ(calls, 0);
+}
+
+TEST(Core, GetTrytesAsync) {
+  IOTA::API::Core api(get_proxy_host(), get_proxy_port());
+
+  auto first  = api.getTrytesAsync({ BUNDLE_1_TRX_1_HASH });
+  auto second = api.getTrytesAsync({ BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_HASH });
+
+  EXPECT_EQ(first.get().getTrytes(), std::vector<IOTA::Types::Trytes>{ BUNDLE_1_TRX_1_TRYTES });
+  EXPECT_EQ(second.get().getTrytes().size(), 2UL);
+}
+
+TEST(Core, GetTrytesAsyncInvalidHash) {
+  IOTA::API::Core api(get_proxy_host(), get_proxy_port());
+
+  auto res = api.getTrytesAsync({ "9999" });
+
+  EXPECT_EXCEPTION(res.get(), IOTA::Errors::BadRequest, "Invalid hashes input")
+}
+
+TEST(Core, GetTrytesChunked) {
+  IOTA::API::Core api(get_proxy_host(), get_proxy_port());
+  api.setMaxItemsPerRequest(1);
+
+  auto res = api.getTrytes({ BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_2_HASH, BUNDLE_1_TRX_1_HASH });
+
+  ASSERT_EQ(res.getTrytes().size(), 3UL);
+  EXPECT_EQ(res.getTrytes()[0], BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(res.getTrytes()[1], BUNDLE_1_TRX_2_TRYTES);
+  EXPECT_EQ(res.getTrytes()[2], BUNDLE_1_TRX_1_TRYTES);
+
+  std::vector<IOTA::Types::Trytes> trytes;
+  api.getTrytes({ BUNDLE_1_TRX_2_HASH, BUNDLE_1_TRX_1_HASH },
+                [&trytes](const IOTA::Types::Trytes& trx) { trytes.push_back(trx); });
+
+  ASSERT_EQ(trytes.size(), 2UL);
+  EXPECT_EQ(trytes[0], BUNDLE_1_TRX_2_TRYTES);
+  EXPECT_EQ(trytes[1], BUNDLE_1_TRX_1_TRYTES);
+}
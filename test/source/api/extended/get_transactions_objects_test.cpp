@@ -53,6 +53,20 @@ TEST(Extended, GetTransactionsObjects) {
   EXPECT_EQ(trx1.getPersistence(), false);
 }
 
+TEST(Extended, GetTransactionsObjectsStream) {
+  auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
+
+  std::vector<IOTA::Types::Trytes> hashes;
+  api.getTransactionsObjects({ BUNDLE_1_TRX_1_HASH },
+                             [&hashes](const IOTA::Models::Transaction& trx) {
+                               hashes.push_back(trx.getHash());
+                               EXPECT_EQ(trx.getBundle(), BUNDLE_1_HASH);
+                             });
+
+  ASSERT_EQ(hashes.size(), 1UL);
+  EXPECT_EQ(hashes[0], BUNDLE_1_TRX_1_HASH);
+}
+
 TEST(Extended, GetTransactionsObjectsInvalidTrxHash) {
   auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
 
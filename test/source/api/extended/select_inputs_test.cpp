@@ -0,0 +1,114 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/responses/get_inputs_snapshot.hpp>
+#include <iota/api/responses/select_inputs.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/address.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+
+namespace {
+
+//! funded addresses by key index: 5, 40, 10, 25 and 7
+const IOTA::API::Responses::GetInputsSnapshot snapshot(
+    { { ACCOUNT_2_ADDRESS_1_HASH, 5, 0, 2 },
+      { ACCOUNT_2_ADDRESS_2_HASH, 40, 1, 2 },
+      { ACCOUNT_2_ADDRESS_3_HASH, 10, 2, 2 },
+      { ACCOUNT_2_ADDRESS_4_HASH, 25, 3, 2 },
+      { ACCOUNT_2_ADDRESS_5_HASH, 7, 4, 2 } },
+    87, { ACCOUNT_2_ADDRESS_6_HASH, 0, 5, 2 }, { "ref" }, 42, 0);
+
+std::vector<int32_t>
+keyIndexes(const IOTA::API::Responses::SelectInputs& selection) {
+  std::vector<int32_t> indexes;
+
+  for (const auto& input : selection.getInputs()) {
+    indexes.push_back(input.getKeyIndex());
+  }
+
+  return indexes;
+}
+
+}  // namespace
+
+TEST(Extended, SelectInputsOldestFirst) {
+  auto res = IOTA::API::Extended::selectInputs(snapshot, 30,
+                                               IOTA::API::Extended::InputStrategy::OldestFirst);
+
+  EXPECT_EQ(keyIndexes(res), std::vector<int32_t>({ 0, 1 }));
+  EXPECT_EQ(res.getTotalBalance(), 45);
+  EXPECT_EQ(res.getValue(), 30);
+  EXPECT_EQ(res.getRemainder(), 15);
+  EXPECT_EQ(res.getRemainderAddress().toTrytes(), ACCOUNT_2_ADDRESS_6_HASH_WITHOUT_CHECKSUM);
+  EXPECT_EQ(res.getReferences(), std::vector<IOTA::Types::Trytes>({ "ref" }));
+  EXPECT_EQ(res.getMilestoneIndex(), 42);
+}
+
+TEST(Extended, SelectInputsFewestInputs) {
+  auto res = IOTA::API::Extended::selectInputs(snapshot, 30,
+                                               IOTA::API::Extended::InputStrategy::FewestInputs);
+
+  EXPECT_EQ(keyIndexes(res), std::vector<int32_t>({ 1 }));
+  EXPECT_EQ(res.getRemainder(), 10);
+
+  //! the largest input is kept, the second one is the smallest completing it
+  res = IOTA::API::Extended::selectInputs(snapshot, 45,
+                                          IOTA::API::Extended::InputStrategy::FewestInputs);
+
+  EXPECT_EQ(keyIndexes(res), std::vector<int32_t>({ 0, 1 }));
+  EXPECT_EQ(res.getRemainder(), 0);
+}
+
+TEST(Extended, SelectInputsMinimizeRemainder) {
+  auto res = IOTA::API::Extended::selectInputs(
+      snapshot, 30, IOTA::API::Extended::InputStrategy::MinimizeRemainder);
+
+  EXPECT_EQ(keyIndexes(res), std::vector<int32_t>({ 0, 3 }));
+  EXPECT_EQ(res.getRemainder(), 0);
+
+  res = IOTA::API::Extended::selectInputs(snapshot, 13,
+                                          IOTA::API::Extended::InputStrategy::MinimizeRemainder);
+
+  EXPECT_EQ(keyIndexes(res), std::vector<int32_t>({ 0, 2 }));
+  EXPECT_EQ(res.getRemainder(), 2);
+}
+
+TEST(Extended, SelectInputsNoValue) {
+  auto res = IOTA::API::Extended::selectInputs(snapshot, 0,
+                                               IOTA::API::Extended::InputStrategy::FewestInputs);
+
+  EXPECT_EQ(res.getInputs().size(), 0UL);
+  EXPECT_EQ(res.getRemainder(), 0);
+}
+
+TEST(Extended, SelectInputsNotEnoughBalance) {
+  EXPECT_EXCEPTION(IOTA::API::Extended::selectInputs(
+                       snapshot, 88, IOTA::API::Extended::InputStrategy::MinimizeRemainder),
+                   IOTA::Errors::IllegalState, "Not enough balance");
+}
@@ -31,6 +31,7 @@
 #include <test/utils/configuration.hpp>
 #include <test/utils/constants.hpp>
 #include <test/utils/expect_exception.hpp>
+#include <test/utils/mock_node.hpp>
 
 TEST(Extended, TraverseBundleTransactionHash) {
   auto api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
@@ -125,3 +126,112 @@ TEST(Extended, TraverseBundleInvalidHash) {
 
   EXPECT_THROW(api.traverseBundle("salut"), IOTA::Errors::IllegalState);
 }
+
+TEST(Extended, TraverseBundlesRoundTrips) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  for (const auto& trytes :
+       { ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES,
+         ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES,
+         ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES }) {
+    node.addTransaction(trytes);
+  }
+
+  auto bundles = api.traverseBundles(
+      { IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES).getHash(),
+        IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES).getHash() });
+
+  ASSERT_EQ(bundles.size(), 2UL);
+  EXPECT_EQ(bundles[0],
+            IOTA::Models::Bundle({ IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES) }));
+  EXPECT_EQ(bundles[1],
+            IOTA::Models::Bundle({ IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES) }));
+
+  //! tails, then all the members of the bundle at once
+  EXPECT_EQ(node.getRequestCount("getTrytes"), 2UL);
+  EXPECT_EQ(node.getRequestCount("findTransactions"), 1UL);
+}
+
+TEST(Extended, TraverseShortBundle) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  //! two transactions bundle
+  IOTA::Models::Transaction second(ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES);
+  second.setLastIndex(1);
+
+  IOTA::Models::Transaction tail(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES);
+  tail.setLastIndex(1);
+  tail.setTrunkTransaction(node.addTransaction(second.toTrytes()));
+
+  auto bundle = api.traverseBundle(node.addTransaction(tail.toTrytes()));
+
+  EXPECT_EQ(bundle.getTransactions().size(), 2UL);
+
+  //! the trunk is walked rather than looking for the members of the bundle
+  EXPECT_EQ(node.getRequestCount("getTrytes"), 2UL);
+  EXPECT_EQ(node.getRequestCount("findTransactions"), 0UL);
+}
+
+TEST(Extended, TraverseReattachedBundle) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  for (const auto& trytes :
+       { ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES,
+         ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES }) {
+    node.addTransaction(trytes);
+
+    //! reattachments: same bundle, other nonces
+    for (char c : { 'A', 'B', 'C' }) {
+      auto reattached                       = trytes;
+      reattached[IOTA::TrxTrytesLength - 1] = c;
+      node.addTransaction(reattached);
+    }
+  }
+
+  auto tail   = IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES).getHash();
+  auto bundle = api.traverseBundle(tail);
+
+  EXPECT_EQ(bundle,
+            IOTA::Models::Bundle({ IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES) }));
+
+  //! too many transactions found for the bundle: its trunks are walked instead of fetching them all
+  EXPECT_EQ(node.getRequestCount("findTransactions"), 1UL);
+  EXPECT_EQ(node.getRequestCount("getTrytes"), 4UL);
+}
+
+TEST(Extended, TraverseBundleUnknownTrunk) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  //! the trunks of the last transactions are unknown to the node
+  for (const auto& trytes :
+       { ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES,
+         ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES,
+         ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES }) {
+    node.addTransaction(trytes);
+  }
+
+  auto tail   = IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES).getHash();
+  auto bundle = api.traverseBundle(tail);
+
+  EXPECT_EQ(bundle,
+            IOTA::Models::Bundle({ IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES) }));
+
+  tail   = IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES).getHash();
+  bundle = api.traverseBundle(tail);
+
+  EXPECT_EQ(bundle,
+            IOTA::Models::Bundle({ IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES) }));
+}
@@ -0,0 +1,412 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/responses/get_account_data.hpp>
+#include <iota/api/responses/get_balances.hpp>
+#include <iota/api/responses/get_inclusion_states.hpp>
+#include <iota/api/responses/get_inputs_snapshot.hpp>
+#include <iota/api/responses/get_node_info.hpp>
+#include <iota/api/responses/get_trytes.hpp>
+#include <iota/api/responses/select_inputs.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/errors/unrecognized.hpp>
+#include <iota/models/bundle.hpp>
+#include <iota/models/seed.hpp>
+#include <iota/models/transaction.hpp>
+#include <iota/models/transfer.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+#include <test/utils/mock_node.hpp>
+
+TEST(MockNode, Handle) {
+  MockNode node;
+  int      status;
+  auto     hash = node.addTransaction(BUNDLE_1_TRX_1_TRYTES, false);
+
+  EXPECT_EQ(hash, BUNDLE_1_TRX_1_HASH);
+  EXPECT_EQ(node.size(), 1UL);
+
+  auto res = json::parse(
+      node.handle(R"({"command":"getTrytes","hashes":[")" + hash + R"("]})", status));
+  EXPECT_EQ(status, 200);
+  EXPECT_EQ(res["trytes"][0].get<std::string>(), BUNDLE_1_TRX_1_TRYTES);
+
+  res = json::parse(node.handle(R"({"command":"findTransactions","addresses":[")" +
+                                    BUNDLE_1_TRX_1_ADDRESS_WITHOUT_CHECKSUM + R"("]})",
+                                status));
+  EXPECT_EQ(res["hashes"], json({ hash }));
+
+  res = json::parse(node.handle(R"({"command":"findTransactions","addresses":[")" +
+                                    BUNDLE_1_TRX_1_ADDRESS_WITHOUT_CHECKSUM +
+                                    R"("],"approvees":[")" + hash + R"("]})",
+                                status));
+  EXPECT_TRUE(res["hashes"].empty());
+
+  res = json::parse(
+      node.handle(R"({"command":"getInclusionStates","transactions":[")" + hash + R"("]})",
+                  status));
+  EXPECT_EQ(res["states"], json({ false }));
+
+  node.setConfirmed(hash, true);
+  res = json::parse(
+      node.handle(R"({"command":"getInclusionStates","transactions":[")" + hash + R"("]})",
+                  status));
+  EXPECT_EQ(res["states"], json({ true }));
+
+  node.handle(R"({"command":"unknown"})", status);
+  EXPECT_EQ(status, 400);
+  node.handle("not json", status);
+  EXPECT_EQ(status, 400);
+
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), 2UL);
+  EXPECT_EQ(node.getRequestCount("getBalances"), 0UL);
+}
+
+TEST(MockNode, FailureInjection) {
+  MockNode node;
+  int      status;
+
+  node.failNext(2, 500);
+  node.handle(R"({"command":"getTips"})", status);
+  EXPECT_EQ(status, 500);
+  node.handle(R"({"command":"getTips"})", status);
+  EXPECT_EQ(status, 500);
+  node.handle(R"({"command":"getTips"})", status);
+  EXPECT_EQ(status, 200);
+
+  node.setFailureRate(1);
+  node.handle(R"({"command":"getTips"})", status);
+  EXPECT_EQ(status, 503);
+}
+
+TEST(MockNode, Core) {
+  MockNode node;
+  auto     api = IOTA::API::Core{ node.getHost(), node.getPort() };
+
+  node.addTransaction(BUNDLE_1_TRX_1_TRYTES);
+  node.setBalance(BUNDLE_1_TRX_1_ADDRESS_WITHOUT_CHECKSUM, 42);
+
+  EXPECT_EQ(api.getNodeInfo().getLatestMilestone(), MOCK_NODE_MILESTONE);
+  EXPECT_EQ(api.getTrytes({ BUNDLE_1_TRX_1_HASH }).getTrytes(),
+            std::vector<IOTA::Types::Trytes>({ BUNDLE_1_TRX_1_TRYTES }));
+  EXPECT_EQ(api.getBalances({ BUNDLE_1_TRX_1_ADDRESS_WITHOUT_CHECKSUM }, 100).getBalances(),
+            std::vector<std::string>({ "42" }));
+  EXPECT_EQ(node.getRequestCount("getNodeInfo"), 1UL);
+}
+
+TEST(MockNode, Failover) {
+  MockNode failing, healthy;
+  auto     api = IOTA::API::Core{ std::vector<IOTA::API::Endpoint>{
+      { failing.getHost(), failing.getPort() }, { healthy.getHost(), healthy.getPort() } } };
+
+  failing.setFailureRate(1);
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_EQ(api.getNodeInfo().getLatestMilestone(), MOCK_NODE_MILESTONE);
+  }
+
+  EXPECT_EQ(healthy.getRequestCount("getNodeInfo"), 5UL);
+
+  healthy.setFailureRate(1);
+  EXPECT_EXCEPTION(api.getNodeInfo(), IOTA::Errors::Unrecognized, "Injected failure");
+}
+
+TEST(MockNode, Hedge) {
+  MockNode slow, fast;
+  auto     api = IOTA::API::Core{ std::vector<IOTA::API::Endpoint>{
+      { slow.getHost(), slow.getPort() }, { fast.getHost(), fast.getPort() } } };
+
+  slow.setLatency(std::chrono::milliseconds(300));
+  api.getService().setHedgeDelay(std::chrono::milliseconds(20));
+
+  for (int i = 0; i < 4; ++i) {
+    EXPECT_EQ(api.getNodeInfo().getLatestMilestone(), MOCK_NODE_MILESTONE);
+  }
+
+  //! requests sent to the slow node first are hedged on the fast one
+  EXPECT_EQ(fast.getRequestCount("getNodeInfo"), 4UL);
+}
+
+TEST(MockNode, GetAccountData) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  loadAccount2(node);
+
+  auto res = api.getAccountData(ACCOUNT_2_SEED, 0, 0, true, 0);
+
+  EXPECT_EQ(res.getAddresses(),
+            std::vector<IOTA::Models::Address>(
+                { ACCOUNT_2_ADDRESS_1_HASH, ACCOUNT_2_ADDRESS_2_HASH, ACCOUNT_2_ADDRESS_3_HASH,
+                  ACCOUNT_2_ADDRESS_4_HASH, ACCOUNT_2_ADDRESS_5_HASH, ACCOUNT_2_ADDRESS_6_HASH }));
+  EXPECT_EQ(res.getTransfers().size(), 5UL);
+  EXPECT_EQ(res.getBalance(), ACCOUNT_2_FUND);
+}
+
+TEST(MockNode, GetInputsSnapshot) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  loadAccount2(node);
+
+  auto res = api.getInputsSnapshot(ACCOUNT_2_SEED);
+
+  EXPECT_EQ(res.getInputs(), std::vector<IOTA::Models::Address>(
+                                 { ACCOUNT_2_ADDRESS_2_HASH, ACCOUNT_2_ADDRESS_3_HASH,
+                                   ACCOUNT_2_ADDRESS_4_HASH, ACCOUNT_2_ADDRESS_5_HASH }));
+  EXPECT_EQ(res.getInputs()[1].getBalance(), ACCOUNT_2_ADDRESS_3_FUND);
+  EXPECT_EQ(res.getTotalBalance(), ACCOUNT_2_FUND);
+  EXPECT_EQ(res.getRemainderAddress().toTrytes(), ACCOUNT_2_ADDRESS_6_HASH_WITHOUT_CHECKSUM);
+  EXPECT_EQ(res.getReferences(), std::vector<IOTA::Types::Trytes>({ MOCK_NODE_MILESTONE }));
+  EXPECT_EQ(res.getMilestoneIndex(), MOCK_NODE_MILESTONE_INDEX);
+
+  //! a single window of addresses is enough, and all balances are read at once
+  EXPECT_EQ(node.getRequestCount("wereAddressesSpentFrom"), 1UL);
+  EXPECT_EQ(node.getRequestCount("getBalances"), 1UL);
+
+  //! used addresses are found by the window, then by each address not spent from, without trytes
+  EXPECT_EQ(node.getRequestCount("findTransactions"), 10UL);
+  EXPECT_EQ(node.getRequestCount("getTrytes"), 0UL);
+
+  res = api.getInputsSnapshot(ACCOUNT_2_SEED, 2, 4);
+
+  EXPECT_EQ(res.getInputs(), std::vector<IOTA::Models::Address>(
+                                 { ACCOUNT_2_ADDRESS_3_HASH, ACCOUNT_2_ADDRESS_4_HASH }));
+  EXPECT_TRUE(res.getRemainderAddress().empty());
+  EXPECT_EQ(node.getRequestCount("wereAddressesSpentFrom"), 1UL);
+}
+
+TEST(MockNode, PrepareTransfersFromSelection) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  loadAccount2(node);
+
+  auto selection = api.selectInputs(ACCOUNT_2_SEED, 100);
+
+  EXPECT_EQ(selection.getInputs(),
+            std::vector<IOTA::Models::Address>({ ACCOUNT_2_ADDRESS_2_HASH }));
+  EXPECT_EQ(node.getRequestCount("getBalances"), 1UL);
+
+  auto transfer = IOTA::Models::Transfer{ ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM, 100, "",
+                                          "TESTTAG99999999999999999999" };
+  auto trytes   = api.prepareTransfers(ACCOUNT_2_SEED, { transfer }, selection);
+
+  //! output, input on two transactions and remainder, without any new balances request
+  ASSERT_EQ(trytes.size(), 4UL);
+  EXPECT_EQ(IOTA::Models::Transaction(trytes[3]).getAddress(), selection.getRemainderAddress());
+  EXPECT_EQ(IOTA::Models::Transaction(trytes[3]).getValue(), ACCOUNT_2_ADDRESS_2_FUND - 100);
+  EXPECT_EQ(node.getRequestCount("getBalances"), 1UL);
+
+  transfer.setValue(ACCOUNT_2_FUND);
+  EXPECT_EXCEPTION(api.prepareTransfers(ACCOUNT_2_SEED, { transfer }, selection),
+                   IOTA::Errors::IllegalState, "Not enough balance");
+}
+
+TEST(MockNode, BundlesFromAddresses) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  loadAccount2(node);
+
+  auto bundles = api.bundlesFromAddresses(
+      { ACCOUNT_2_ADDRESS_1_HASH, ACCOUNT_2_ADDRESS_2_HASH, ACCOUNT_2_ADDRESS_3_HASH,
+        ACCOUNT_2_ADDRESS_4_HASH, ACCOUNT_2_ADDRESS_5_HASH },
+      true);
+
+  ASSERT_EQ(bundles.size(), 5UL);
+  EXPECT_EQ(bundles[4],
+            IOTA::Models::Bundle({ IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES) }));
+
+  for (const auto& bundle : bundles) {
+    EXPECT_TRUE(bundle[0].getPersistence());
+  }
+}
+
+TEST(MockNode, BundlesFromTransactions) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  loadAccount2(node);
+
+  //! duplicated tails and non-tail transactions only known through their bundle
+  auto bundles = api.bundlesFromTransactions(
+      { IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES),
+        IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES),
+        IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES),
+        IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES),
+        IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES) });
+
+  ASSERT_EQ(bundles.size(), 2UL);
+  EXPECT_EQ(bundles[0],
+            IOTA::Models::Bundle({ IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES) }));
+  EXPECT_EQ(bundles[1],
+            IOTA::Models::Bundle({ IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES) }));
+
+  //! one lookup for the bundle without known tail, one for the traversal prefetch
+  EXPECT_EQ(node.getRequestCount("findTransactions"), 2UL);
+}
+
+TEST(MockNode, IsReattachable) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  loadAccount2(node);
+
+  //! the first address is the input of a confirmed transfer
+  auto res = api.isReattachable(
+      { { ACCOUNT_2_ADDRESS_1_HASH, ACCOUNT_2_ADDRESS_2_HASH, ACCOUNT_2_ADDRESS_3_HASH },
+        { ACCOUNT_2_ADDRESS_4_HASH, ACCOUNT_2_ADDRESS_1_HASH } });
+
+  ASSERT_EQ(res.size(), 2UL);
+  EXPECT_EQ(res[0], std::vector<bool>({ false, true, true }));
+  EXPECT_EQ(res[1], std::vector<bool>({ true, false }));
+
+  //! a single request per step for all the sets
+  EXPECT_EQ(node.getRequestCount("findTransactions"), 1UL);
+  EXPECT_EQ(node.getRequestCount("getTrytes"), 1UL);
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), 1UL);
+
+  for (const auto& trytes :
+       { ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES,
+         ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES }) {
+    node.setConfirmed(IOTA::Models::Transaction(trytes).getHash(), false);
+  }
+
+  EXPECT_EQ(api.isReattachable({ ACCOUNT_2_ADDRESS_1_HASH, ACCOUNT_2_ADDRESS_2_HASH }),
+            std::vector<bool>({ true, true }));
+}
+
+TEST(MockNode, IsPromotable) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  auto tail1 = node.addTransaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES, false);
+  auto tail2 = node.addTransaction(ACCOUNT_2_BUNDLE_2_TRX_1_TRYTES, false);
+  auto tail3 = node.addTransaction(ACCOUNT_2_BUNDLE_3_TRX_1_TRYTES, false);
+  auto tail4 = node.addTransaction(ACCOUNT_2_BUNDLE_4_TRX_1_TRYTES, false);
+
+  node.setConsistent(tail2, false);
+  api.setMaxItemsPerRequest(4);
+
+  //! unknown tails are rejected by the node, invalid hashes are not sent
+  auto res = api.isPromotable({ tail1, tail2, tail3, tail4, MOCK_NODE_MILESTONE, "INVALID" });
+
+  EXPECT_EQ(res, std::vector<bool>({ true, false, true, true, false, false }));
+
+  //! the first chunk is bisected down to the inconsistent tail
+  EXPECT_EQ(node.getRequestCount("checkConsistency"), 6UL);
+}
+
+TEST(MockNode, GetTailStates) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  auto tail1 = node.addTransaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES, true);
+  auto tail2 = node.addTransaction(ACCOUNT_2_BUNDLE_2_TRX_1_TRYTES, false);
+  auto tail3 = node.addTransaction(ACCOUNT_2_BUNDLE_3_TRX_1_TRYTES, false);
+
+  node.setConsistent(tail2, false);
+
+  auto res = api.getTailStates({ tail1, tail2, tail3 });
+
+  EXPECT_EQ(res, std::vector<IOTA::API::Extended::TailState>(
+                     { IOTA::API::Extended::TailState::Confirmed,
+                       IOTA::API::Extended::TailState::Reattachable,
+                       IOTA::API::Extended::TailState::Promotable }));
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), 1UL);
+  EXPECT_EQ(node.getRequestCount("checkConsistency"), 3UL);
+}
+
+TEST(MockNode, CachedNodeInfo) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  auto tail = node.addTransaction(ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES);
+
+  //! the latest milestone is only requested once
+  EXPECT_EQ(api.getLatestInclusion({ tail }).getStates(), std::vector<bool>({ true }));
+  EXPECT_EQ(api.getLatestInclusion({ tail }).getStates(), std::vector<bool>({ true }));
+  EXPECT_EQ(node.getRequestCount("getNodeInfo"), 1UL);
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), 2UL);
+
+  //! the cache is shared by copies
+  auto copy = api;
+  EXPECT_EQ(copy.getCachedNodeInfo().getLatestSolidSubtangleMilestone(), MOCK_NODE_MILESTONE);
+  EXPECT_EQ(node.getRequestCount("getNodeInfo"), 1UL);
+
+  api.getNodeInfoCache().setTtl(std::chrono::milliseconds(0));
+  api.getLatestInclusion({ tail });
+  EXPECT_EQ(node.getRequestCount("getNodeInfo"), 2UL);
+}
+
+TEST(MockNode, SendTrytes) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort(), false };
+
+  auto trxs = api.sendTrytes({ BUNDLE_1_TRX_1_TRYTES }, 3, POW_LEVEL);
+
+  ASSERT_EQ(trxs.size(), 1UL);
+  EXPECT_EQ(trxs[0].getTrunkTransaction(), MOCK_NODE_MILESTONE);
+  EXPECT_EQ(node.getRequestCount("getTransactionsToApprove"), 1UL);
+  EXPECT_EQ(node.getRequestCount("attachToTangle"), 1UL);
+  EXPECT_EQ(node.getRequestCount("storeTransactions"), 1UL);
+  EXPECT_EQ(node.getRequestCount("broadcastTransactions"), 1UL);
+  EXPECT_EQ(node.size(), 1UL);
+}
+
+TEST(MockNode, Load) {
+  MockNode node;
+  auto     api = IOTA::API::Extended{ node.getHost(), node.getPort() };
+
+  loadAccount2(node);
+  node.setLatency(std::chrono::milliseconds(1));
+
+  std::vector<std::thread> clients;
+
+  for (int i = 0; i < 2; ++i) {
+    clients.emplace_back([&api] {
+      for (int j = 0; j < 2; ++j) {
+        EXPECT_EQ(api.getAccountData(ACCOUNT_2_SEED, 0, 0, true, 0).getBalance(),
+                  ACCOUNT_2_FUND);
+      }
+    });
+  }
+
+  for (auto& client : clients) {
+    client.join();
+  }
+
+  EXPECT_EQ(node.getRequestCount("getBalances"), 4UL);
+}
@@ -0,0 +1,163 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <atomic>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/node_info_cache.hpp>
+#include <iota/errors/bad_request.hpp>
+#include <test/utils/expect_exception.hpp>
+
+namespace {
+
+//! node info fetches, each one with the next milestone index
+class Node {
+public:
+  IOTA::API::NodeInfoCache::Fetch fetch(const std::chrono::milliseconds& latency =
+                                            std::chrono::milliseconds(0)) {
+    return [this, latency] {
+      std::this_thread::sleep_for(latency);
+      return IOTA::API::Responses::GetNodeInfo("", "", 0, 0, 0, 0, "", ++count);
+    };
+  }
+
+  std::atomic<int64_t> count{ 0 };
+};
+
+}  // namespace
+
+TEST(NodeInfoCache, Ttl) {
+  IOTA::API::NodeInfoCache cache;
+  Node                     node;
+
+  EXPECT_EQ(cache.getTtl(), IOTA::API::NodeInfoCache::DefaultTtl);
+
+  EXPECT_EQ(cache.get(node.fetch()).getLatestMilestoneIndex(), 1);
+  EXPECT_EQ(cache.get(node.fetch()).getLatestMilestoneIndex(), 1);
+
+  cache.invalidate();
+  EXPECT_EQ(cache.get(node.fetch()).getLatestMilestoneIndex(), 2);
+
+  //! no caching
+  cache.setTtl(std::chrono::milliseconds(0));
+  EXPECT_EQ(cache.get(node.fetch()).getLatestMilestoneIndex(), 3);
+  EXPECT_EQ(cache.get(node.fetch()).getLatestMilestoneIndex(), 4);
+}
+
+TEST(NodeInfoCache, Expiry) {
+  IOTA::API::NodeInfoCache cache(std::chrono::milliseconds(20));
+  Node                     node;
+
+  EXPECT_EQ(cache.get(node.fetch()).getLatestMilestoneIndex(), 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_EQ(cache.get(node.fetch()).getLatestMilestoneIndex(), 2);
+}
+
+TEST(NodeInfoCache, ConcurrentCallers) {
+  IOTA::API::NodeInfoCache cache;
+  Node                     node;
+  std::vector<std::thread> callers;
+  std::atomic<int>         total{ 0 };
+
+  for (int i = 0; i < 8; ++i) {
+    callers.emplace_back([&] {
+      total += cache.get(node.fetch(std::chrono::milliseconds(50))).getLatestMilestoneIndex();
+    });
+  }
+
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  //! a single request, shared by all the callers
+  EXPECT_EQ(node.count, 1);
+  EXPECT_EQ(total, 8);
+}
+
+TEST(NodeInfoCache, Failure) {
+  IOTA::API::NodeInfoCache cache;
+  Node                     node;
+
+  auto failure = []() -> IOTA::API::Responses::GetNodeInfo {
+    throw IOTA::Errors::BadRequest("Unavailable");
+  };
+
+  EXPECT_EXCEPTION(cache.get(failure), IOTA::Errors::BadRequest, "Unavailable");
+
+  //! failures are not cached
+  EXPECT_EQ(cache.get(node.fetch()).getLatestMilestoneIndex(), 1);
+}
+
+TEST(NodeInfoCache, Refresh) {
+  IOTA::API::NodeInfoCache cache(std::chrono::milliseconds(20));
+  Node                     node;
+
+  cache.startRefresh(node.fetch());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+
+  //! callers never fetch the node info themselves
+  auto info = cache.get([]() -> IOTA::API::Responses::GetNodeInfo {
+    throw IOTA::Errors::BadRequest("Unexpected fetch");
+  });
+
+  cache.stopRefresh();
+
+  EXPECT_GE(node.count, 2);
+  EXPECT_GE(info.getLatestMilestoneIndex(), 2);
+}
+
+TEST(NodeInfoCache, InvalidateWhileWaiting) {
+  IOTA::API::NodeInfoCache cache;
+  Node                     node;
+  std::vector<std::thread> callers;
+  std::atomic<int>         total{ 0 };
+  std::atomic<bool>        done{ false };
+
+  for (int i = 0; i < 8; ++i) {
+    callers.emplace_back([&] {
+      total += cache.get(node.fetch(std::chrono::milliseconds(50))).getLatestMilestoneIndex();
+    });
+  }
+
+  //! waiters get the response of the fetch they waited for, even if dropped from the cache
+  std::thread invalidator([&] {
+    while (!done) {
+      cache.invalidate();
+    }
+  });
+
+  for (auto& caller : callers) {
+    caller.join();
+  }
+
+  done = true;
+  invalidator.join();
+
+  EXPECT_GE(node.count, 1);
+  EXPECT_GE(total, 8);
+}
@@ -0,0 +1,158 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/portfolio.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/bundle.hpp>
+#include <iota/models/seed.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+#include <test/utils/mock_node.hpp>
+
+TEST(Portfolio, DiscoveryWindow) {
+  MockNode             node;
+  IOTA::API::Extended  api{ node.getHost(), node.getPort() };
+  IOTA::API::Portfolio portfolio{ api };
+
+  EXPECT_EQ(portfolio.getDiscoveryWindow(), IOTA::API::Portfolio::DefaultDiscoveryWindow);
+  portfolio.setDiscoveryWindow(3);
+  EXPECT_EQ(portfolio.getDiscoveryWindow(), 3UL);
+  EXPECT_EXCEPTION(portfolio.setDiscoveryWindow(0), IOTA::Errors::IllegalState,
+                   "Discovery window can not be empty");
+}
+
+TEST(Portfolio, Refresh) {
+  MockNode             node;
+  IOTA::API::Extended  api{ node.getHost(), node.getPort() };
+  IOTA::API::Portfolio portfolio{ api };
+
+  loadAccount2(node);
+
+  auto account2 = portfolio.addAccount(ACCOUNT_2_SEED);
+  auto account3 = portfolio.addAccount(ACCOUNT_3_SEED);
+  auto res      = portfolio.refresh();
+
+  ASSERT_EQ(res.size(), 2UL);
+
+  auto expected = api.getAccountData(ACCOUNT_2_SEED, 0, 0, true, 0);
+  EXPECT_EQ(res[0].getAddresses(), expected.getAddresses());
+  EXPECT_EQ(res[0].getTransfers(), expected.getTransfers());
+  EXPECT_EQ(res[0].getBalance(), ACCOUNT_2_FUND);
+
+  //! the last bundle of account 2 is a transfer to the first address of account 3
+  ASSERT_EQ(res[1].getAddresses().size(), 2UL);
+  EXPECT_EQ(res[1].getAddresses()[0], ACCOUNT_3_ADDRESS_1_HASH);
+  ASSERT_EQ(res[1].getTransfers().size(), 1UL);
+  EXPECT_EQ(res[1].getTransfers()[0],
+            IOTA::Models::Bundle({ IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES),
+                                   IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES) }));
+
+  EXPECT_EQ(account2->getData().getBalance(), ACCOUNT_2_FUND);
+  EXPECT_EQ(account3->getData().getAddresses().size(), 2UL);
+  EXPECT_EQ(account3->getKnownTransactionsCount(), 1UL);
+}
+
+TEST(Portfolio, MergedRequests) {
+  MockNode             node;
+  IOTA::API::Extended  api{ node.getHost(), node.getPort() };
+  IOTA::API::Portfolio portfolio{ api };
+
+  loadAccount2(node);
+
+  for (const auto& seed : { ACCOUNT_1_SEED, ACCOUNT_2_SEED, ACCOUNT_3_SEED, ACCOUNT_4_SEED }) {
+    portfolio.addAccount(seed);
+  }
+
+  portfolio.refresh();
+
+  //! one window of addresses is enough for all the accounts
+  EXPECT_EQ(node.getRequestCount("wereAddressesSpentFrom"), 1UL);
+  EXPECT_EQ(node.getRequestCount("getBalances"), 1UL);
+
+  auto findTransactions = node.getRequestCount("findTransactions");
+  auto getTrytes        = node.getRequestCount("getTrytes");
+
+  //! nothing new: one findTransactions for all the accounts
+  auto res = portfolio.refresh();
+
+  EXPECT_EQ(node.getRequestCount("findTransactions"), findTransactions + 1);
+  EXPECT_EQ(node.getRequestCount("getTrytes"), getTrytes);
+  EXPECT_EQ(node.getRequestCount("getBalances"), 1UL);
+  EXPECT_EQ(node.getRequestCount("wereAddressesSpentFrom"), 1UL);
+  EXPECT_EQ(res[1].getBalance(), ACCOUNT_2_FUND);
+}
+
+TEST(Portfolio, SmallWindow) {
+  MockNode             node;
+  IOTA::API::Extended  api{ node.getHost(), node.getPort() };
+  IOTA::API::Portfolio portfolio{ api };
+
+  loadAccount2(node);
+  portfolio.setDiscoveryWindow(2);
+  portfolio.addAccount(ACCOUNT_2_SEED);
+
+  auto res = portfolio.refresh();
+
+  //! 6 addresses, by windows of 2
+  EXPECT_EQ(node.getRequestCount("wereAddressesSpentFrom"), 3UL);
+  EXPECT_EQ(res[0].getAddresses().size(), 6UL);
+  EXPECT_EQ(res[0].getTransfers().size(), 5UL);
+}
+
+TEST(Portfolio, InvalidBundle) {
+  MockNode             node;
+  IOTA::API::Extended  api{ node.getHost(), node.getPort() };
+  IOTA::API::Portfolio portfolio{ api };
+
+  //! first bundle with another timestamp: its bundle hash does not match anymore
+  auto invalid  = ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES;
+  invalid[2322] = invalid[2322] == 'A' ? 'B' : 'A';
+
+  for (const auto& trytes :
+       { invalid, ACCOUNT_2_BUNDLE_2_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_3_TRX_1_TRYTES,
+         ACCOUNT_2_BUNDLE_4_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES,
+         ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES,
+         ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES }) {
+    node.addTransaction(trytes);
+  }
+
+  portfolio.addAccount(ACCOUNT_2_SEED);
+
+  auto res       = portfolio.refresh();
+  auto getTrytes = node.getRequestCount("getTrytes");
+
+  EXPECT_EQ(res[0].getTransfers().size(), 4UL);
+
+  //! the invalid bundle is not read again
+  res = portfolio.refresh();
+
+  EXPECT_EQ(node.getRequestCount("getTrytes"), getTrytes);
+  EXPECT_EQ(res[0].getTransfers().size(), 4UL);
+}
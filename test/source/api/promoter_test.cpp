@@ -0,0 +1,275 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <mutex>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/extended.hpp>
+#include <iota/api/promoter.hpp>
+#include <iota/api/responses/get_trytes.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/transaction.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+#include <test/utils/mock_node.hpp>
+
+namespace {
+
+using Event = IOTA::API::Promoter::Event;
+
+//! outcomes reported by a promoter
+class Events {
+public:
+  IOTA::API::Promoter::Callback callback() {
+    return [this](const IOTA::Types::Trytes& tail, Event event, const IOTA::Types::Trytes& trx,
+                  std::exception_ptr) {
+      std::lock_guard<std::mutex> lock(mutex_);
+      events_.push_back({ tail, event, trx });
+    };
+  }
+
+  struct Outcome {
+    IOTA::Types::Trytes tail;
+    Event               event;
+    IOTA::Types::Trytes trx;
+  };
+
+  std::vector<Outcome> take() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    std::vector<Outcome>        events;
+    events.swap(events_);
+    return events;
+  }
+
+private:
+  std::mutex           mutex_;
+  std::vector<Outcome> events_;
+};
+
+std::string
+addBundle5(MockNode& node, bool confirmed) {
+  for (const auto& trytes : { ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES, ACCOUNT_2_BUNDLE_5_TRX_3_TRYTES,
+                              ACCOUNT_2_BUNDLE_5_TRX_4_TRYTES }) {
+    node.addTransaction(trytes, confirmed);
+  }
+
+  return node.addTransaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES, confirmed);
+}
+
+}  // namespace
+
+TEST(Promoter, Confirmed) {
+  MockNode            node;
+  auto                api = IOTA::API::Extended{ node.getHost(), node.getPort(), false };
+  IOTA::API::Promoter promoter(api, 3, POW_LEVEL);
+  Events              events;
+
+  auto tail = addBundle5(node, true);
+
+  promoter.track(tail, events.callback());
+  EXPECT_EQ(promoter.size(), 1UL);
+
+  promoter.tick();
+
+  auto outcomes = events.take();
+  ASSERT_EQ(outcomes.size(), 1UL);
+  EXPECT_EQ(outcomes[0].tail, tail);
+  EXPECT_EQ(outcomes[0].event, Event::Confirmed);
+  EXPECT_EQ(outcomes[0].trx, tail);
+  EXPECT_EQ(promoter.size(), 0UL);
+  EXPECT_EQ(node.getRequestCount("attachToTangle"), 0UL);
+}
+
+TEST(Promoter, Promote) {
+  MockNode            node;
+  auto                api = IOTA::API::Extended{ node.getHost(), node.getPort(), false };
+  IOTA::API::Promoter promoter(api, 3, POW_LEVEL);
+  Events              events;
+
+  auto tail = addBundle5(node, false);
+
+  promoter.setInterval(std::chrono::milliseconds(1));
+  promoter.setResolution(std::chrono::milliseconds(1));
+  promoter.track(tail, events.callback());
+
+  for (int i = 0; i < 2; ++i) {
+    promoter.tick();
+
+    auto outcomes = events.take();
+    ASSERT_EQ(outcomes.size(), 1UL);
+    EXPECT_EQ(outcomes[0].tail, tail);
+    EXPECT_EQ(outcomes[0].event, Event::Promoted);
+
+    //! the promotion is a zero-value transaction approving the tail
+    IOTA::Models::Transaction promotion(api.getTrytes({ outcomes[0].trx }).getTrytes()[0]);
+    EXPECT_EQ(promotion.getValue(), 0);
+    EXPECT_EQ(promotion.getTrunkTransaction(), tail);
+  }
+
+  EXPECT_EQ(promoter.size(), 1UL);
+  EXPECT_EQ(node.getRequestCount("attachToTangle"), 2UL);
+}
+
+TEST(Promoter, Reattach) {
+  MockNode            node;
+  auto                api = IOTA::API::Extended{ node.getHost(), node.getPort(), false };
+  IOTA::API::Promoter promoter(api, 3, POW_LEVEL);
+  Events              events;
+
+  auto tail = addBundle5(node, false);
+  node.setConsistent(tail, false);
+
+  promoter.setInterval(std::chrono::milliseconds(1));
+  promoter.setResolution(std::chrono::milliseconds(1));
+  promoter.track(tail, events.callback());
+  promoter.tick();
+
+  auto outcomes = events.take();
+  ASSERT_EQ(outcomes.size(), 1UL);
+  EXPECT_EQ(outcomes[0].event, Event::Reattached);
+
+  //! the reattachment is a new tail of the same bundle
+  const auto reattachment = outcomes[0].trx;
+  IOTA::Models::Transaction trx(api.getTrytes({ reattachment }).getTrytes()[0]);
+  EXPECT_NE(reattachment, tail);
+  EXPECT_TRUE(trx.isTailTransaction());
+  EXPECT_EQ(trx.getBundle(),
+            IOTA::Models::Transaction(ACCOUNT_2_BUNDLE_5_TRX_1_TRYTES).getBundle());
+
+  //! confirmation of the reattachment confirms the bundle
+  node.setConfirmed(reattachment, true);
+  promoter.tick();
+
+  outcomes = events.take();
+  ASSERT_EQ(outcomes.size(), 1UL);
+  EXPECT_EQ(outcomes[0].tail, tail);
+  EXPECT_EQ(outcomes[0].event, Event::Confirmed);
+  EXPECT_EQ(outcomes[0].trx, reattachment);
+  EXPECT_EQ(promoter.size(), 0UL);
+}
+
+TEST(Promoter, ManyBundles) {
+  MockNode            node;
+  auto                api = IOTA::API::Extended{ node.getHost(), node.getPort(), false };
+  IOTA::API::Promoter promoter(api, 3, POW_LEVEL);
+  Events              events;
+
+  promoter.setPowCapacity(2);
+
+  for (const auto& trytes :
+       { ACCOUNT_2_BUNDLE_1_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_2_TRX_1_TRYTES,
+         ACCOUNT_2_BUNDLE_3_TRX_1_TRYTES, ACCOUNT_2_BUNDLE_4_TRX_1_TRYTES }) {
+    promoter.track(node.addTransaction(trytes, false), events.callback());
+  }
+
+  promoter.tick();
+
+  auto outcomes = events.take();
+  ASSERT_EQ(outcomes.size(), 4UL);
+
+  for (const auto& outcome : outcomes) {
+    EXPECT_EQ(outcome.event, Event::Promoted);
+  }
+
+  //! a single inclusion check for all the bundles
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), 1UL);
+  EXPECT_EQ(node.getRequestCount("attachToTangle"), 4UL);
+
+  //! not due before the promotion interval
+  promoter.tick();
+  EXPECT_TRUE(events.take().empty());
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), 1UL);
+}
+
+TEST(Promoter, Untrack) {
+  MockNode            node;
+  auto                api = IOTA::API::Extended{ node.getHost(), node.getPort(), false };
+  IOTA::API::Promoter promoter(api, 3, POW_LEVEL);
+  Events              events;
+
+  auto tail = addBundle5(node, false);
+
+  promoter.track(tail, events.callback());
+  EXPECT_TRUE(promoter.untrack(tail));
+  EXPECT_FALSE(promoter.untrack(tail));
+  EXPECT_EQ(promoter.size(), 0UL);
+
+  promoter.tick();
+  EXPECT_TRUE(events.take().empty());
+  EXPECT_EQ(node.getRequestCount("getInclusionStates"), 0UL);
+}
+
+TEST(Promoter, Failure) {
+  MockNode            node;
+  auto                api = IOTA::API::Extended{ node.getHost(), node.getPort(), false };
+  IOTA::API::Promoter promoter(api, 3, POW_LEVEL);
+  Events              events;
+
+  auto tail = addBundle5(node, false);
+
+  promoter.setInterval(std::chrono::milliseconds(1));
+  promoter.setResolution(std::chrono::milliseconds(1));
+  promoter.track(tail, events.callback());
+
+  node.failNext(1);
+  promoter.tick();
+
+  auto outcomes = events.take();
+  ASSERT_EQ(outcomes.size(), 1UL);
+  EXPECT_EQ(outcomes[0].event, Event::Failed);
+
+  //! still tracked, tried again on the next tick
+  promoter.tick();
+
+  outcomes = events.take();
+  ASSERT_EQ(outcomes.size(), 1UL);
+  EXPECT_EQ(outcomes[0].event, Event::Promoted);
+}
+
+TEST(Promoter, Thread) {
+  MockNode            node;
+  auto                api = IOTA::API::Extended{ node.getHost(), node.getPort(), false };
+  IOTA::API::Promoter promoter(api, 3, POW_LEVEL);
+  Events              events;
+
+  promoter.setResolution(std::chrono::milliseconds(5));
+  promoter.start();
+  promoter.track(addBundle5(node, true), events.callback());
+
+  for (int i = 0; i < 200 && promoter.size(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+
+  promoter.stop();
+
+  auto outcomes = events.take();
+  ASSERT_EQ(outcomes.size(), 1UL);
+  EXPECT_EQ(outcomes[0].event, Event::Confirmed);
+
+  EXPECT_EXCEPTION(promoter.setResolution(std::chrono::milliseconds(0)),
+                   IOTA::Errors::IllegalState, "Promoter resolution can not be null");
+}
@@ -48,3 +48,24 @@ TEST(FindTransactionsRequest, ConstructAndSerialize) {
   EXPECT_EQ(data["approvees"], std::vector<IOTA::Types::Trytes>({ "approvee1", "approvee2" }));
   EXPECT_EQ(data["bundles"], std::vector<IOTA::Types::Trytes>({ "bundle1", "bundle2" }));
 }
+
+TEST(FindTransactionsRequest, SerializeWithWriter) {
+  const IOTA::API::Requests::FindTransactions full{ { ACCOUNT_1_ADDRESS_1_HASH,
+                                                      ACCOUNT_1_ADDRESS_2_HASH },
+                                                    { { "TAGONE" }, { "TAGTWO" } },
+                                                    { "approvee1", "approvee2" },
+                                                    { "bundle1", "bundle2" } };
+  const IOTA::API::Requests::FindTransactions partial{ {}, { { "TAGONE" } }, {}, {} };
+
+  for (const auto& req : { full, partial }) {
+    IOTA::Utils::JsonWriter writer;
+    json                    data;
+
+    writer.startObject();
+    req.serialize(writer);
+    writer.endObject();
+    req.serialize(data);
+
+    EXPECT_EQ(json::parse(writer.str()), data);
+  }
+}
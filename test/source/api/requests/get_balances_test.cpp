@@ -46,3 +46,23 @@ TEST(GetBalancesRequest, ConstructAndSerialize) {
   EXPECT_EQ(data["tips"],
             std::vector<IOTA::Types::Trytes>({ BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_2_HASH }));
 }
+
+TEST(GetBalancesRequest, SerializeWithWriter) {
+  const IOTA::API::Requests::GetBalances full{ { ACCOUNT_1_ADDRESS_1_HASH,
+                                                 ACCOUNT_1_ADDRESS_2_HASH },
+                                               42,
+                                               { BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_2_HASH } };
+  const IOTA::API::Requests::GetBalances noTips{ { ACCOUNT_1_ADDRESS_1_HASH }, 100, {} };
+
+  for (const auto& req : { full, noTips }) {
+    IOTA::Utils::JsonWriter writer;
+    json                    data;
+
+    writer.startObject();
+    req.serialize(writer);
+    writer.endObject();
+    req.serialize(data);
+
+    EXPECT_EQ(json::parse(writer.str()), data);
+  }
+}
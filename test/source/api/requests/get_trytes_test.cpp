@@ -37,3 +37,17 @@ TEST(GetTrytesRequest, ConstructAndSerialize) {
   EXPECT_EQ(data["command"], "getTrytes");
   EXPECT_EQ(data["hashes"], std::vector<IOTA::Types::Trytes>({ "TESTA", "TESTB" }));
 }
+
+TEST(GetTrytesRequest, SerializeWithWriter) {
+  const IOTA::API::Requests::GetTrytes req{ { "TESTA", "TESTB" } };
+  IOTA::Utils::JsonWriter              writer;
+  json                                 data;
+
+  writer.startObject();
+  req.serialize(writer);
+  writer.endObject();
+  req.serialize(data);
+
+  EXPECT_EQ(writer.str(), "{\"command\":\"getTrytes\",\"hashes\":[\"TESTA\",\"TESTB\"]}");
+  EXPECT_EQ(json::parse(writer.str()), data);
+}
@@ -105,3 +105,21 @@ TEST(GetBalancesReponse, DeserializeShouldSetFields) {
   EXPECT_EQ(res.getMilestoneIndex(), 1);
   EXPECT_EQ(res.getDuration(), 0);
 }
+
+TEST(GetBalancesReponse, Bind) {
+  const std::string reply = "{\"balances\":[\"1\",\"2\"],\"references\":[\"ref\"],"
+                            "\"milestoneIndex\":42,\"duration\":7}";
+
+  IOTA::API::Responses::GetBalances res;
+  IOTA::Utils::JsonFieldsHandler    handler;
+  IOTA::Utils::JsonStreamParser     parser(handler);
+
+  res.bind(handler);
+  parser.feed(reply.data(), reply.size());
+  parser.finish();
+
+  EXPECT_EQ(res.getBalances(), std::vector<std::string>({ "1", "2" }));
+  EXPECT_EQ(res.getReferences(), std::vector<std::string>({ "ref" }));
+  EXPECT_EQ(res.getMilestoneIndex(), 42);
+  EXPECT_EQ(res.getDuration(), 7);
+}
@@ -63,3 +63,17 @@ TEST(GetTrytesResponse, DeserializeShouldSetFields) {
   res.deserialize(data);
   EXPECT_EQ(res.getTrytes(), trytes);
 }
+
+TEST(GetTrytesResponse, Bind) {
+  IOTA::API::Responses::GetTrytes res;
+  IOTA::Utils::JsonFieldsHandler  handler;
+  IOTA::Utils::JsonStreamParser   parser(handler);
+  std::string                     reply = "{\"trytes\":[\"TESTA\",\"TESTB\"],\"duration\":3}";
+
+  res.bind(handler);
+  parser.feed(reply.data(), reply.size());
+  parser.finish();
+
+  EXPECT_EQ(res.getTrytes(), std::vector<IOTA::Types::Trytes>({ "TESTA", "TESTB" }));
+  EXPECT_EQ(res.getDuration(), 3);
+}
@@ -0,0 +1,135 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/service_metrics.hpp>
+#include <iota/errors/bad_request.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/errors/network.hpp>
+
+namespace {
+
+IOTA::API::ServiceMetrics::Sample
+makeSample(const std::string& command, int latencyMs, const std::string& error = "") {
+  IOTA::API::ServiceMetrics::Sample sample;
+
+  sample.command       = command;
+  sample.serializeTime = std::chrono::microseconds(100);
+  sample.networkTime   = std::chrono::milliseconds(latencyMs) - std::chrono::microseconds(200);
+  sample.parseTime     = std::chrono::microseconds(100);
+  sample.requestBytes  = 10;
+  sample.responseBytes = 1000;
+  sample.attempts      = error.empty() ? 1 : 3;
+  sample.error         = error;
+
+  return sample;
+}
+
+}  // namespace
+
+TEST(ServiceMetrics, Record) {
+  IOTA::API::ServiceMetrics metrics;
+
+  metrics.record(makeSample("getTrytes", 3));
+  metrics.record(makeSample("getTrytes", 40));
+  metrics.record(makeSample("getTrytes", 20000, "network"));
+  metrics.record(makeSample("getNodeInfo", 7, "bad_request"));
+
+  auto commands = metrics.getCommands();
+  ASSERT_EQ(commands.size(), 2UL);
+
+  const auto& trytes = commands["getTrytes"];
+  EXPECT_EQ(trytes.requests, 3UL);
+  EXPECT_EQ(trytes.retries, 2UL);
+  EXPECT_EQ(trytes.requestBytes, 30UL);
+  EXPECT_EQ(trytes.responseBytes, 3000UL);
+  EXPECT_EQ(trytes.serializeTime.count(), 300);
+  EXPECT_EQ(trytes.parseTime.count(), 300);
+  EXPECT_EQ(trytes.networkTime.count(), 20043000 - 600);
+  EXPECT_EQ(trytes.errors, (std::map<std::string, uint64_t>{ { "network", 1 } }));
+
+  ASSERT_EQ(trytes.latencyBuckets.size(), IOTA::API::ServiceMetrics::getLatencyBounds().size() + 1);
+  EXPECT_EQ(trytes.latencyBuckets[0], 1UL);
+  EXPECT_EQ(trytes.latencyBuckets[3], 1UL);
+  EXPECT_EQ(trytes.latencyBuckets.back(), 1UL);
+
+  metrics.reset();
+  EXPECT_TRUE(metrics.getCommands().empty());
+}
+
+TEST(ServiceMetrics, Callback) {
+  IOTA::API::ServiceMetrics                      metrics;
+  std::vector<IOTA::API::ServiceMetrics::Sample> samples;
+
+  metrics.setCallback([&](const IOTA::API::ServiceMetrics::Sample& s) { samples.push_back(s); });
+  metrics.record(makeSample("getTips", 12));
+
+  ASSERT_EQ(samples.size(), 1UL);
+  EXPECT_EQ(samples[0].command, "getTips");
+  EXPECT_EQ(samples[0].getLatency().count(), 12000);
+
+  metrics.setCallback(nullptr);
+  metrics.record(makeSample("getTips", 12));
+  EXPECT_EQ(samples.size(), 1UL);
+}
+
+TEST(ServiceMetrics, Prometheus) {
+  IOTA::API::ServiceMetrics metrics;
+
+  metrics.record(makeSample("getTips", 12));
+  metrics.record(makeSample("getTips", 30, "network"));
+
+  auto text   = metrics.toPrometheus();
+  auto bucket = std::string("iota_api_request_duration_seconds_bucket{command=\"getTips\",le=");
+
+  EXPECT_NE(text.find("# TYPE iota_api_request_duration_seconds histogram\n"), std::string::npos);
+  EXPECT_NE(text.find(bucket + "\"0.01\"} 0\n"), std::string::npos);
+  EXPECT_NE(text.find(bucket + "\"0.025\"} 1\n"), std::string::npos);
+  EXPECT_NE(text.find(bucket + "\"+Inf\"} 2\n"), std::string::npos);
+  EXPECT_NE(text.find("iota_api_request_duration_seconds_sum{command=\"getTips\"} 0.042\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("iota_api_request_duration_seconds_count{command=\"getTips\"} 2\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("iota_api_request_phase_seconds_total{command=\"getTips\",phase=\"parse\"} "
+                      "0.0002\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("iota_api_response_bytes_total{command=\"getTips\"} 2000\n"),
+            std::string::npos);
+  EXPECT_NE(text.find("iota_api_retries_total{command=\"getTips\"} 2\n"), std::string::npos);
+  EXPECT_NE(text.find("iota_api_errors_total{command=\"getTips\",class=\"network\"} 1\n"),
+            std::string::npos);
+}
+
+TEST(ServiceMetrics, Classify) {
+  using IOTA::API::ServiceMetrics;
+
+  EXPECT_EQ(ServiceMetrics::classify(std::make_exception_ptr(IOTA::Errors::Network("x"))),
+            "network");
+  EXPECT_EQ(ServiceMetrics::classify(std::make_exception_ptr(IOTA::Errors::BadRequest("x"))),
+            "bad_request");
+  EXPECT_EQ(ServiceMetrics::classify(std::make_exception_ptr(IOTA::Errors::IllegalState("x"))),
+            "other");
+}
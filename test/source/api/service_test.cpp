@@ -0,0 +1,133 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/api/core.hpp>
+#include <iota/api/responses/get_node_info.hpp>
+#include <iota/api/service.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/errors/network.hpp>
+#include <iota/utils/compression.hpp>
+#include <test/utils/configuration.hpp>
+#include <test/utils/expect_exception.hpp>
+
+TEST(Service, MultiNodeCtor) {
+  IOTA::API::Service service({ { "http://localhost", 14265 }, { "https://node", 443 } });
+
+  ASSERT_EQ(service.getNodes().size(), 2UL);
+  EXPECT_EQ(service.getNodes()[0]->getUrl(), "http://localhost:14265");
+  EXPECT_EQ(service.getNodes()[1]->getUrl(), "https://node:443");
+  EXPECT_EQ(service.getNodes()[0]->getLatency(), IOTA::API::Node::PriorLatency);
+  EXPECT_GT(service.getNodes()[0]->getScore(), 0);
+  EXPECT_EQ(service.getNodes()[0]->getInFlight(), 0);
+
+  EXPECT_EXCEPTION(IOTA::API::Service{ std::vector<IOTA::API::Endpoint>{} },
+                   IOTA::Errors::IllegalState, "No node provided");
+}
+
+TEST(Service, Settings) {
+  IOTA::API::Service service("http://localhost", 14265);
+
+  EXPECT_EQ(service.getMaxAttempts(), IOTA::API::Service::DefaultMaxAttempts);
+  service.setMaxAttempts(0);
+  EXPECT_EQ(service.getMaxAttempts(), 1UL);
+
+  EXPECT_EQ(service.getHedgeDelay(), std::chrono::milliseconds(0));
+  service.setHedgeDelay(std::chrono::milliseconds(50));
+  EXPECT_EQ(service.getHedgeDelay(), std::chrono::milliseconds(50));
+  EXPECT_EQ(service.getHedgeWorkerPool().getSize(), IOTA::API::Service::DefaultHedgeWorkers);
+
+  EXPECT_EQ(service.getAcceptCompression(), IOTA::Utils::isCompressionSupported());
+  service.setAcceptCompression(false);
+  EXPECT_FALSE(service.getAcceptCompression());
+
+  EXPECT_EQ(service.getCompressRequestsAbove(), 0UL);
+
+  if (IOTA::Utils::isCompressionSupported()) {
+    service.setAcceptCompression(true);
+    EXPECT_TRUE(service.getAcceptCompression());
+    service.setCompressRequestsAbove(4096);
+    EXPECT_EQ(service.getCompressRequestsAbove(), 4096UL);
+  } else {
+    EXPECT_EXCEPTION(service.setAcceptCompression(true), IOTA::Errors::IllegalState,
+                     "Compression is not supported: built without zlib");
+    EXPECT_EXCEPTION(service.setCompressRequestsAbove(4096), IOTA::Errors::IllegalState,
+                     "Compression is not supported: built without zlib");
+  }
+}
+
+TEST(Service, AllNodesDown) {
+  IOTA::API::Core api(std::vector<IOTA::API::Endpoint>{ { "http://localhost", 1 },
+                                                        { "http://localhost", 2 } });
+
+  EXPECT_THROW(api.getNodeInfo(), IOTA::Errors::Network);
+
+  for (const auto& node : api.getService().getNodes()) {
+    EXPECT_GT(node->getErrorRate(), 0);
+  }
+}
+
+TEST(Service, UnreachableNodeScore) {
+  IOTA::API::Service service(
+      std::vector<IOTA::API::Endpoint>{ { "http://localhost", 1 }, { "http://localhost", 2 } }, 5);
+
+  auto& down    = *service.getNodes()[0];
+  auto& untried = *service.getNodes()[1];
+
+  //! failures count as the timeout, even when the connection is refused right away
+  EXPECT_THROW(down.post("{}"), IOTA::Errors::Network);
+  EXPECT_GE(down.getLatency(), std::chrono::seconds(5));
+  EXPECT_GT(down.getScore(), untried.getScore());
+}
+
+TEST(Service, MetricsOnError) {
+  IOTA::API::Core api(std::vector<IOTA::API::Endpoint>{ { "http://localhost", 1 },
+                                                        { "http://localhost", 2 } });
+
+  EXPECT_THROW(api.getNodeInfo(), IOTA::Errors::Network);
+
+  auto commands = api.getService().getMetrics().getCommands();
+  ASSERT_EQ(commands.count("getNodeInfo"), 1UL);
+
+  const auto& metrics = commands["getNodeInfo"];
+  EXPECT_EQ(metrics.requests, 1UL);
+  EXPECT_EQ(metrics.retries, 1UL);
+  EXPECT_GT(metrics.requestBytes, 0UL);
+  EXPECT_EQ(metrics.responseBytes, 0UL);
+  EXPECT_EQ(metrics.errors.at("network"), 1UL);
+}
+
+TEST(Service, Failover) {
+  IOTA::API::Core api(std::vector<IOTA::API::Endpoint>{
+      { "http://localhost", 1 }, { get_proxy_host(), get_proxy_port() } });
+
+  for (int i = 0; i < 5; ++i) {
+    EXPECT_FALSE(api.getNodeInfo().getAppName().empty());
+  }
+
+  EXPECT_EQ(api.getService().getNodes()[1]->getErrorRate(), 0);
+  EXPECT_GT(api.getService().getNodes()[1]->getLatency().count(), 0);
+}
@@ -0,0 +1,139 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/session_pool.hpp>
+
+class SessionPoolTest : public ::testing::Test {
+protected:
+  SessionPoolTest()
+      : created_(0), pool_([this] {
+          ++created_;
+          return std::unique_ptr<cpr::Session>(new cpr::Session);
+        }) {
+  }
+
+  std::atomic<int>       created_;
+  IOTA::API::SessionPool pool_;
+};
+
+TEST_F(SessionPoolTest, ReusesSessions) {
+  cpr::Session* first;
+
+  {
+    auto session = pool_.acquire();
+    first        = &*session;
+    EXPECT_EQ(pool_.idleCount(), 0UL);
+  }
+
+  EXPECT_EQ(pool_.idleCount(), 1UL);
+
+  auto session = pool_.acquire();
+  EXPECT_EQ(&*session, first);
+  EXPECT_EQ(created_, 1);
+  EXPECT_EQ(pool_.idleCount(), 0UL);
+}
+
+TEST_F(SessionPoolTest, ConcurrentLeases) {
+  {
+    auto first  = pool_.acquire();
+    auto second = pool_.acquire();
+    EXPECT_NE(&*first, &*second);
+  }
+
+  EXPECT_EQ(created_, 2);
+  EXPECT_EQ(pool_.idleCount(), 2UL);
+}
+
+TEST_F(SessionPoolTest, MaxIdle) {
+  pool_.setMaxIdle(1);
+  EXPECT_EQ(pool_.getMaxIdle(), 1UL);
+
+  {
+    auto first  = pool_.acquire();
+    auto second = pool_.acquire();
+  }
+
+  EXPECT_EQ(pool_.idleCount(), 1UL);
+
+  pool_.setMaxIdle(0);
+  EXPECT_EQ(pool_.idleCount(), 0UL);
+
+  pool_.acquire();
+  EXPECT_EQ(pool_.idleCount(), 0UL);
+  EXPECT_EQ(created_, 3);
+}
+
+TEST_F(SessionPoolTest, Discard) {
+  {
+    auto session = pool_.acquire();
+    session.discard();
+  }
+
+  EXPECT_EQ(pool_.idleCount(), 0UL);
+}
+
+TEST_F(SessionPoolTest, IdleTimeout) {
+  EXPECT_EQ(pool_.getIdleTimeout(), IOTA::API::SessionPool::DefaultIdleTimeout);
+  pool_.setIdleTimeout(std::chrono::seconds(0));
+
+  pool_.acquire();
+  EXPECT_EQ(pool_.idleCount(), 1UL);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  pool_.acquire();
+  EXPECT_EQ(created_, 2);
+}
+
+TEST_F(SessionPoolTest, Clear) {
+  pool_.acquire();
+  pool_.clear();
+  EXPECT_EQ(pool_.idleCount(), 0UL);
+}
+
+TEST_F(SessionPoolTest, ThreadSafety) {
+  std::vector<std::thread> threads;
+
+  for (int i = 0; i < 8; ++i) {
+    threads.emplace_back([this] {
+      for (int j = 0; j < 100; ++j) {
+        auto session = pool_.acquire();
+      }
+    });
+  }
+
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_LE(pool_.idleCount(), IOTA::API::SessionPool::DefaultMaxIdle);
+  EXPECT_LE(created_, 8);
+}
@@ -0,0 +1,163 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <map>
+
+#include <gtest/gtest.h>
+
+#include <iota/api/trytes_cache.hpp>
+#include <iota/constants.hpp>
+#include <test/utils/constants.hpp>
+
+namespace {
+
+//! In-memory store counting its accesses
+class MapStore : public IOTA::API::TrytesStore {
+public:
+  bool load(const IOTA::Types::Trytes& hash, IOTA::Types::Trytes& trytes) override {
+    ++loads;
+
+    auto it = trytesByHash.find(hash);
+    if (it == trytesByHash.end()) {
+      return false;
+    }
+
+    trytes = it->second;
+    return true;
+  }
+
+  bool save(const IOTA::Types::Trytes& hash, const IOTA::Types::Trytes& trytes) override {
+    trytesByHash[hash] = trytes;
+    return true;
+  }
+
+public:
+  std::map<IOTA::Types::Trytes, IOTA::Types::Trytes> trytesByHash;
+  int                                                 loads = 0;
+};
+
+}  // namespace
+
+TEST(TrytesCache, GetAndPut) {
+  IOTA::API::TrytesCache cache;
+  IOTA::Types::Trytes    trytes;
+
+  EXPECT_EQ(cache.getCapacity(), IOTA::API::TrytesCache::DefaultCapacity);
+  EXPECT_FALSE(cache.get(BUNDLE_1_TRX_1_HASH, trytes));
+
+  cache.put(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES);
+
+  EXPECT_EQ(cache.size(), 1UL);
+  EXPECT_TRUE(cache.get(BUNDLE_1_TRX_1_HASH, trytes));
+  EXPECT_EQ(trytes, BUNDLE_1_TRX_1_TRYTES);
+
+  cache.clear();
+  EXPECT_EQ(cache.size(), 0UL);
+  EXPECT_FALSE(cache.get(BUNDLE_1_TRX_1_HASH, trytes));
+}
+
+TEST(TrytesCache, UnknownTransactionsAreNotCached) {
+  IOTA::API::TrytesCache cache;
+
+  cache.put(BUNDLE_1_TRX_1_HASH, std::string(IOTA::TrxTrytesLength, '9'));
+  cache.put(BUNDLE_1_TRX_2_HASH, "");
+
+  EXPECT_EQ(cache.size(), 0UL);
+}
+
+TEST(TrytesCache, MismatchingHashesAreNotCached) {
+  IOTA::API::TrytesCache cache;
+  IOTA::Types::Trytes    trytes;
+
+  //! trytes of another transaction
+  cache.put(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_2_TRYTES);
+
+  EXPECT_EQ(cache.size(), 0UL);
+  EXPECT_FALSE(cache.get(BUNDLE_1_TRX_1_HASH, trytes));
+}
+
+TEST(TrytesCache, LeastRecentlyUsedIsEvicted) {
+  IOTA::API::TrytesCache cache(2);
+  IOTA::Types::Trytes    trytes;
+
+  cache.put(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES);
+  cache.put(BUNDLE_1_TRX_2_HASH, BUNDLE_1_TRX_2_TRYTES);
+  EXPECT_TRUE(cache.get(BUNDLE_1_TRX_1_HASH, trytes));
+
+  cache.put(BUNDLE_1_TRX_3_HASH, BUNDLE_1_TRX_3_TRYTES);
+
+  EXPECT_EQ(cache.size(), 2UL);
+  EXPECT_TRUE(cache.get(BUNDLE_1_TRX_1_HASH, trytes));
+  EXPECT_FALSE(cache.get(BUNDLE_1_TRX_2_HASH, trytes));
+  EXPECT_TRUE(cache.get(BUNDLE_1_TRX_3_HASH, trytes));
+
+  cache.setCapacity(1);
+  EXPECT_EQ(cache.size(), 1UL);
+  EXPECT_TRUE(cache.get(BUNDLE_1_TRX_3_HASH, trytes));
+}
+
+TEST(TrytesCache, Statistics) {
+  IOTA::API::TrytesCache cache;
+  IOTA::Types::Trytes    trytes;
+
+  EXPECT_EQ(cache.getHitRate(), 0);
+
+  cache.put(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES);
+  cache.get(BUNDLE_1_TRX_1_HASH, trytes);
+  cache.get(BUNDLE_1_TRX_1_HASH, trytes);
+  cache.get(BUNDLE_1_TRX_1_HASH, trytes);
+  cache.get(BUNDLE_1_TRX_2_HASH, trytes);
+
+  EXPECT_EQ(cache.getHits(), 3UL);
+  EXPECT_EQ(cache.getMisses(), 1UL);
+  EXPECT_EQ(cache.getHitRate(), 0.75);
+
+  cache.resetStatistics();
+  EXPECT_EQ(cache.getHits(), 0UL);
+  EXPECT_EQ(cache.getMisses(), 0UL);
+}
+
+TEST(TrytesCache, Store) {
+  auto                   store = std::make_shared<MapStore>();
+  IOTA::API::TrytesCache cache(1, store);
+  IOTA::Types::Trytes    trytes;
+
+  EXPECT_EQ(cache.getStore(), store);
+
+  cache.put(BUNDLE_1_TRX_1_HASH, BUNDLE_1_TRX_1_TRYTES);
+  cache.put(BUNDLE_1_TRX_2_HASH, BUNDLE_1_TRX_2_TRYTES);
+  EXPECT_EQ(store->trytesByHash.size(), 2UL);
+
+  //! evicted from memory, but still in the store
+  EXPECT_TRUE(cache.get(BUNDLE_1_TRX_1_HASH, trytes));
+  EXPECT_EQ(trytes, BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(cache.getStoreHits(), 1UL);
+  EXPECT_EQ(store->loads, 1);
+
+  //! loaded back in memory
+  EXPECT_TRUE(cache.get(BUNDLE_1_TRX_1_HASH, trytes));
+  EXPECT_EQ(store->loads, 1);
+  EXPECT_EQ(cache.getHits(), 2UL);
+}
@@ -155,3 +155,28 @@ TEST(Curl, Reset) {
   EXPECT_EQ(IOTA::Types::tritsToTrytes(res3),
             "SRMFSVMTJCABOJEROVGLGZAEAJYHIIESFU9ZZCMKHGSVGGBNPFKGWUZNFLWRNFCBBDENYKHZDT9RBXXIW");
 }
+
+TEST(Curl, AbsorbAndSqueezePacked) {
+  IOTA::Types::Trytes trytes =
+      "KPWCHICGJZXKE9GSUDXZYUAPLHAKAHYHDXNPHENTERYMMBQOPSQIDENXKLKCEYCPVTZQLEEJVYJZV9BWU99999999999"
+      "9999999999999999MNPL99999999999999999999999RUKCAXD99999999999A99999999";
+
+  IOTA::Crypto::Curl c;
+  c.absorb(IOTA::Types::PackedTrits::fromTrytes(trytes));
+
+  IOTA::Types::PackedTrits res(IOTA::TritHashLength);
+  c.squeeze(res);
+
+  EXPECT_EQ(res.toTrytes(),
+            "SRMFSVMTJCABOJEROVGLGZAEAJYHIIESFU9ZZCMKHGSVGGBNPFKGWUZNFLWRNFCBBDENYKHZDT9RBXXIW");
+
+  //! T3B1 must give the same result
+  IOTA::Crypto::Curl c2;
+  c2.absorb(IOTA::Types::PackedTrytes::fromTrytes(trytes));
+
+  IOTA::Types::Trits res2(IOTA::TritHashLength);
+  c2.squeeze(res2);
+
+  EXPECT_EQ(IOTA::Types::tritsToTrytes(res2),
+            "SRMFSVMTJCABOJEROVGLGZAEAJYHIIESFU9ZZCMKHGSVGGBNPFKGWUZNFLWRNFCBBDENYKHZDT9RBXXIW");
+}
@@ -29,6 +29,7 @@
 #include <iota/constants.hpp>
 #include <iota/crypto/multi_signing.hpp>
 #include <iota/models/bundle.hpp>
+#include <iota/models/multisig_address_builder.hpp>
 #include <iota/models/seed.hpp>
 #include <iota/models/transfer.hpp>
 #include <iota/types/trinary.hpp>
@@ -36,8 +37,8 @@
 #include <test/utils/constants.hpp>
 
 TEST(Multisigning, Basic) {
-  IOTA::Models::Address msa(IOTA::Models::Address::MULTISIG);
-  auto                  api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
+  IOTA::Models::MultisigAddressBuilder builder;
+  auto                                 api = IOTA::API::Extended{ get_proxy_host(), get_proxy_port() };
 
   auto firstKey = IOTA::Crypto::MultiSigning::key(IOTA::Types::trytesToBytes(ACCOUNT_1_SEED), 0, 3);
   auto firstDigest = IOTA::Crypto::MultiSigning::digests(firstKey);
@@ -56,9 +57,9 @@ TEST(Multisigning, Basic) {
       "MVPPSRNZYFSGXSKAKCLYMKJRZJHXRUXUTAYS9YBNKHVVVOANLAMKPPGXSEWQZOVBFQPAZAGNXBMYIUGPDRJMVQGXFZAI"
       "APTLAMPW9BFEHTWEL9UIB9XHVEAGSFATCDYLYLHOAVPCKPNSVVJRGXOYZ9C");
 
-  msa.absorbDigests(firstDigest);
-  msa.absorbDigests(secondDigest);
-  msa.finalize();
+  builder.absorbDigests(firstDigest);
+  builder.absorbDigests(secondDigest);
+  auto msa = builder.finalize();
 
   // TODO add in constants.hpp
   EXPECT_EQ(msa.toTrytes(),
@@ -306,3 +306,14 @@ TEST(Address, OperatorNEqTrytes) {
   IOTA::Types::Trytes   rhs_neq(ACCOUNT_1_ADDRESS_2_HASH);
   EXPECT_TRUE(lhs_neq != rhs_neq);
 }
+
+TEST(Address, OperatorEqTrytesInvalidLength) {
+  IOTA::Models::Address addr(ACCOUNT_1_ADDRESS_1_HASH);
+  EXPECT_FALSE(addr == ACCOUNT_1_ADDRESS_1_HASH_WITHOUT_CHECKSUM.substr(0, 80));
+  EXPECT_FALSE(addr == IOTA::Types::Trytes{});
+  EXPECT_TRUE(addr != ACCOUNT_1_ADDRESS_1_HASH + "A");
+
+  IOTA::Models::Address empty;
+  EXPECT_TRUE(empty == IOTA::Types::Trytes{});
+  EXPECT_FALSE(empty == ACCOUNT_1_ADDRESS_1_HASH);
+}
@@ -0,0 +1,89 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/models/multisig_address_builder.hpp>
+#include <iota/types/trinary.hpp>
+#include <test/utils/expect_exception.hpp>
+
+static const std::vector<uint8_t> FIRST_DIGEST = IOTA::Types::trytesToBytes(
+    "GU9ZRLULWQRZWNHBLUYGDNURQXUFPBULCL9IECYWSNNFLNSDRXTUUFVHWKAOBPQBWQABPQGS9HXEVGPFXFIEUIGGEZQK"
+    "9NVQNNPUCJIP9UL9HFEHCQF9EUKOFBRDMXTYEVA9PTAQGQWTJSFSPNG9MVCN9WKAUPCMHCPROSOJXGRAVOVKBCLOSDCP"
+    "EMZTZEASAOQVT9JSTATWUZRPBXQCRAPMWGKOXBRSGPMUWAYDPYRLUWALURC");
+
+static const std::vector<uint8_t> SECOND_DIGEST = IOTA::Types::trytesToBytes(
+    "RBORTXIJFOBZZ9Z9UPMLKMFWFSNIPUDAYCAQOZNHKQ9XRZCZTCCWRJHXAXARSUXCPIHSIEYPPGFGHCADBR9YVOBNQNVE"
+    "MVPPSRNZYFSGXSKAKCLYMKJRZJHXRUXUTAYS9YBNKHVVVOANLAMKPPGXSEWQZOVBFQPAZAGNXBMYIUGPDRJMVQGXFZAI"
+    "APTLAMPW9BFEHTWEL9UIB9XHVEAGSFATCDYLYLHOAVPCKPNSVVJRGXOYZ9C");
+
+static const std::string MULTISIG_ADDRESS =
+    "IZRSJJABYOJ9ZGMIDQPEYLIORMSJBHLIYVBOCOYG9CKKCCJG99MDZYANLWQFEIBGUA9QJSXXKTACDHSSZ";
+
+TEST(MultisigAddressBuilder, Finalize) {
+  IOTA::Models::MultisigAddressBuilder builder;
+
+  builder.absorbDigests(FIRST_DIGEST);
+  builder.absorbDigests(SECOND_DIGEST);
+  auto address = builder.finalize();
+
+  EXPECT_EQ(address.toTrytes(), MULTISIG_ADDRESS);
+  EXPECT_EQ(address.getSecurity(), 6);
+  EXPECT_TRUE(address.validate({ FIRST_DIGEST, SECOND_DIGEST }));
+  EXPECT_FALSE(address.validate({ SECOND_DIGEST, FIRST_DIGEST }));
+}
+
+TEST(MultisigAddressBuilder, AlreadyFinalized) {
+  IOTA::Models::MultisigAddressBuilder builder;
+
+  builder.absorbDigests(FIRST_DIGEST);
+  builder.finalize();
+
+  EXPECT_EXCEPTION(builder.absorbDigests(SECOND_DIGEST), IOTA::Errors::IllegalState,
+                   "multisig address has already been finalized");
+  EXPECT_EXCEPTION(builder.finalize(), IOTA::Errors::IllegalState,
+                   "multisig address has already been finalized");
+}
+
+TEST(MultisigAddressBuilder, DeprecatedAddressMethods) {
+  IOTA::Models::Address address(IOTA::Models::Address::MULTISIG);
+
+  address.absorbDigests(FIRST_DIGEST);
+  address.absorbDigests(SECOND_DIGEST);
+  address.finalize();
+
+  EXPECT_EQ(address.toTrytes(), MULTISIG_ADDRESS);
+  EXPECT_EQ(address.getSecurity(), 6);
+
+  //! no-op on plain addresses
+  IOTA::Models::Address plain(MULTISIG_ADDRESS);
+
+  plain.absorbDigests(FIRST_DIGEST);
+  plain.finalize();
+
+  EXPECT_EQ(plain.toTrytes(), MULTISIG_ADDRESS);
+  EXPECT_EQ(plain.getSecurity(), 2);
+}
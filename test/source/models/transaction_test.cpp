@@ -169,6 +169,15 @@ TEST(Transaction, CtorFromTrxTrytesAndToTrytes) {
       "99999");
 }
 
+TEST(Transaction, CtorFromTrxTrytesAndHash) {
+  //! the given hash is trusted
+  IOTA::Models::Transaction t(BUNDLE_1_TRX_1_TRYTES, BUNDLE_1_TRX_2_HASH);
+
+  EXPECT_EQ(t.getHash(), BUNDLE_1_TRX_2_HASH);
+  EXPECT_EQ(t.getBundle(), BUNDLE_1_HASH);
+  EXPECT_EQ(t.toTrytes(), BUNDLE_1_TRX_1_TRYTES);
+}
+
 TEST(Transaction, CtorFromTrxTrytesEmptyTrytes) {
   EXPECT_EXCEPTION(IOTA::Models::Transaction t(""), IOTA::Errors::IllegalState,
                    "Invalid transaction trytes");
@@ -229,6 +238,21 @@ TEST(Transaction, CtorFromTrxTrytesInvalidTrytes) {
             "9999999999999999999999999999999999999999999999999");
 }
 
+TEST(Transaction, FieldsFromTrytes) {
+  for (const auto& trytes : { BUNDLE_1_TRX_1_TRYTES, BUNDLE_1_TRX_2_TRYTES,
+                              ACCOUNT_2_BUNDLE_5_TRX_2_TRYTES }) {
+    IOTA::Models::Transaction t(trytes);
+
+    EXPECT_EQ(IOTA::Models::Transaction::addressFromTrytes(trytes), t.getAddress().toTrytes());
+    EXPECT_EQ(IOTA::Models::Transaction::valueFromTrytes(trytes), t.getValue());
+  }
+
+  EXPECT_EXCEPTION(IOTA::Models::Transaction::valueFromTrytes(""), IOTA::Errors::IllegalState,
+                   "Invalid transaction trytes");
+  EXPECT_EXCEPTION(IOTA::Models::Transaction::addressFromTrytes(""), IOTA::Errors::IllegalState,
+                   "Invalid transaction trytes");
+}
+
 TEST(Transaction, CtorFull) {
   IOTA::Models::Transaction t("signatureFragments", 1, 2, "nonce", "hash", 3, "trunkTransaction",
                               "branchTransaction", ACCOUNT_1_ADDRESS_1_HASH, 4, "bundle", "TAG", 5,
@@ -0,0 +1,214 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <cstdio>
+#include <fstream>
+#include <thread>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/storage/transaction_archive.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+
+static const std::string ArchivePath = "transaction_archive_test.bin";
+
+TEST(TransactionArchive, Empty) {
+  std::remove(ArchivePath.c_str());
+
+  {
+    IOTA::Storage::TransactionArchive archive(ArchivePath);
+
+    EXPECT_TRUE(archive.empty());
+    EXPECT_EQ(archive.size(), 0UL);
+    EXPECT_FALSE(archive.contains(BUNDLE_1_TRX_1_HASH));
+    EXPECT_TRUE(archive.findByBundle(BUNDLE_1_HASH).empty());
+    EXPECT_EXCEPTION(archive.at(0), IOTA::Errors::IllegalState, "Index out of range");
+  }
+
+  std::remove(ArchivePath.c_str());
+}
+
+TEST(TransactionArchive, AppendAndRead) {
+  std::remove(ArchivePath.c_str());
+
+  IOTA::Storage::TransactionArchive archive(ArchivePath);
+
+  EXPECT_TRUE(archive.append(BUNDLE_1_TRX_1_TRYTES));
+  EXPECT_TRUE(archive.append(IOTA::Models::Transaction{ BUNDLE_1_TRX_2_TRYTES }));
+  EXPECT_TRUE(archive.append(BUNDLE_1_TRX_3_TRYTES));
+
+  //! duplicates are ignored
+  EXPECT_FALSE(archive.append(BUNDLE_1_TRX_1_TRYTES));
+  EXPECT_FALSE(archive.append(IOTA::Models::Transaction{ BUNDLE_1_TRX_3_TRYTES }));
+
+  ASSERT_EQ(archive.size(), 3UL);
+  EXPECT_TRUE(archive.contains(BUNDLE_1_TRX_2_HASH));
+
+  auto trx = archive.get(BUNDLE_1_TRX_1_HASH);
+  EXPECT_EQ(trx.getHash(), BUNDLE_1_TRX_1_HASH);
+  EXPECT_EQ(trx.getAddress(), BUNDLE_1_TRX_1_ADDRESS_WITHOUT_CHECKSUM);
+  EXPECT_EQ(trx.getBundle(), BUNDLE_1_HASH);
+  EXPECT_EQ(trx.getTrunkTransaction(), BUNDLE_1_TRX_1_TRUNK);
+  EXPECT_EQ(trx.getBranchTransaction(), BUNDLE_1_TRX_1_BRANCH);
+  EXPECT_EQ(trx.getValue(), BUNDLE_1_TRX_1_VALUE);
+  EXPECT_EQ(trx.getTimestamp(), BUNDLE_1_TRX_1_TS);
+  EXPECT_EQ(trx.getCurrentIndex(), BUNDLE_1_TRX_1_CURRENT_INDEX);
+  EXPECT_EQ(trx.getLastIndex(), BUNDLE_1_TRX_1_LAST_INDEX);
+  EXPECT_TRUE(trx.isTailTransaction());
+  EXPECT_EQ(trx.toTrytes(), BUNDLE_1_TRX_1_TRYTES);
+  EXPECT_EQ(trx.toTransaction(), IOTA::Models::Transaction{ BUNDLE_1_TRX_1_TRYTES });
+
+  EXPECT_EQ(archive.at(1).getValue(), BUNDLE_1_TRX_2_VALUE);
+  EXPECT_EQ(archive.at(2).getHash(), BUNDLE_1_TRX_3_HASH);
+
+  auto bundle = archive.findByBundle(BUNDLE_1_HASH);
+  ASSERT_EQ(bundle.size(), 3UL);
+  EXPECT_EQ(bundle[0].getHash(), BUNDLE_1_TRX_1_HASH);
+  EXPECT_EQ(bundle[1].getHash(), BUNDLE_1_TRX_2_HASH);
+  EXPECT_EQ(bundle[2].getHash(), BUNDLE_1_TRX_3_HASH);
+
+  auto address = archive.findByAddress(BUNDLE_1_TRX_1_ADDRESS);
+  ASSERT_EQ(address.size(), 1UL);
+  EXPECT_EQ(address[0].getHash(), BUNDLE_1_TRX_1_HASH);
+
+  EXPECT_EXCEPTION(archive.get(BUNDLE_1_TRX_1_BRANCH), IOTA::Errors::IllegalState,
+                   ("Unknown transaction " + BUNDLE_1_TRX_1_BRANCH).c_str());
+  EXPECT_EXCEPTION(archive.append("ABC"), IOTA::Errors::IllegalState,
+                   "Invalid transaction trytes");
+  EXPECT_EXCEPTION(archive.append(IOTA::Models::Transaction{ BUNDLE_1_TRX_4_TRYTES,
+                                                             BUNDLE_1_TRX_1_HASH }),
+                   IOTA::Errors::IllegalState,
+                   ("Invalid transaction hash " + BUNDLE_1_TRX_1_HASH).c_str());
+
+  std::remove(ArchivePath.c_str());
+}
+
+TEST(TransactionArchive, Reopen) {
+  std::remove(ArchivePath.c_str());
+
+  {
+    IOTA::Storage::TransactionArchive archive(ArchivePath);
+
+    archive.append(BUNDLE_1_TRX_1_TRYTES);
+    archive.append(BUNDLE_1_TRX_2_TRYTES);
+  }
+
+  {
+    IOTA::Storage::TransactionArchive archive(ArchivePath);
+
+    ASSERT_EQ(archive.size(), 2UL);
+    EXPECT_EQ(archive.get(BUNDLE_1_TRX_2_HASH).toTrytes(), BUNDLE_1_TRX_2_TRYTES);
+    EXPECT_EQ(archive.findByBundle(BUNDLE_1_HASH).size(), 2UL);
+
+    EXPECT_FALSE(archive.append(BUNDLE_1_TRX_1_TRYTES));
+    EXPECT_TRUE(archive.append(BUNDLE_1_TRX_3_TRYTES));
+  }
+
+  {
+    IOTA::Storage::TransactionArchive archive(ArchivePath);
+
+    ASSERT_EQ(archive.size(), 3UL);
+    EXPECT_EQ(archive.at(2).toTrytes(), BUNDLE_1_TRX_3_TRYTES);
+  }
+
+  std::remove(ArchivePath.c_str());
+}
+
+TEST(TransactionArchive, PartialRecord) {
+  std::remove(ArchivePath.c_str());
+
+  {
+    IOTA::Storage::TransactionArchive archive(ArchivePath);
+
+    archive.append(BUNDLE_1_TRX_1_TRYTES);
+    archive.append(BUNDLE_1_TRX_2_TRYTES);
+  }
+
+  //! interrupted append
+  {
+    std::ofstream file(ArchivePath, std::ios::binary | std::ios::app);
+    file << "partial record";
+  }
+
+  {
+    IOTA::Storage::TransactionArchive archive(ArchivePath);
+
+    ASSERT_EQ(archive.size(), 2UL);
+    EXPECT_TRUE(archive.append(BUNDLE_1_TRX_3_TRYTES));
+  }
+
+  {
+    IOTA::Storage::TransactionArchive archive(ArchivePath);
+
+    ASSERT_EQ(archive.size(), 3UL);
+    EXPECT_EQ(archive.at(2).toTrytes(), BUNDLE_1_TRX_3_TRYTES);
+  }
+
+  std::remove(ArchivePath.c_str());
+}
+
+TEST(TransactionArchive, ConcurrentReads) {
+  std::remove(ArchivePath.c_str());
+
+  IOTA::Storage::TransactionArchive archive(ArchivePath);
+
+  archive.append(BUNDLE_1_TRX_1_TRYTES);
+  archive.append(BUNDLE_1_TRX_2_TRYTES);
+  archive.append(BUNDLE_1_TRX_3_TRYTES);
+
+  //! readers remap concurrently, views of each reader stay valid
+  std::vector<std::thread> readers;
+
+  for (int i = 0; i < 4; ++i) {
+    readers.emplace_back([&archive, i] {
+      auto first = archive.at(i % 3);
+      auto last  = archive.at(2);
+
+      EXPECT_EQ(last.getHash(), BUNDLE_1_TRX_3_HASH);
+      EXPECT_EQ(first.getBundle(), BUNDLE_1_HASH);
+    });
+  }
+
+  for (auto& reader : readers) {
+    reader.join();
+  }
+
+  std::remove(ArchivePath.c_str());
+}
+
+TEST(TransactionArchive, InvalidFile) {
+  {
+    std::ofstream file(ArchivePath, std::ios::binary | std::ios::trunc);
+    file << "not an archive";
+  }
+
+  EXPECT_EXCEPTION(IOTA::Storage::TransactionArchive{ ArchivePath }, IOTA::Errors::IllegalState,
+                   ("Invalid transaction archive " + ArchivePath).c_str());
+
+  std::remove(ArchivePath.c_str());
+}
@@ -0,0 +1,210 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/constants.hpp>
+#include <iota/errors/illegal_state.hpp>
+#include <iota/types/packed_trits.hpp>
+#include <iota/types/trinary.hpp>
+#include <test/utils/expect_exception.hpp>
+
+namespace {
+
+IOTA::Types::Trits
+sampleTrits(std::size_t size) {
+  IOTA::Types::Trits trits(size);
+
+  for (std::size_t i = 0; i < size; ++i) {
+    trits[i] = static_cast<int8_t>((i * 7 + i / 3) % 3) - 1;
+  }
+
+  return trits;
+}
+
+}  // namespace
+
+TEST(PackedTrits, DefaultCtor) {
+  IOTA::Types::PackedTrits p;
+
+  EXPECT_TRUE(p.empty());
+  EXPECT_EQ(p.size(), 0UL);
+  EXPECT_TRUE(p.getBytes().empty());
+}
+
+TEST(PackedTrits, SizeCtor) {
+  IOTA::Types::PackedTrits p(12);
+
+  EXPECT_EQ(p.size(), 12UL);
+  EXPECT_EQ(p.getBytes().size(), 3UL);
+  EXPECT_EQ(p.toTrits(), IOTA::Types::Trits(12, 0));
+}
+
+TEST(PackedTrits, PackedSize) {
+  EXPECT_EQ(IOTA::Types::PackedTrits::packedSize(IOTA::TxLength), 1604UL);
+  EXPECT_EQ(IOTA::Types::PackedTrytes::packedSize(IOTA::TxLength), 2673UL);
+  EXPECT_EQ(IOTA::Types::PackedTrits::packedSize(IOTA::TritHashLength), 49UL);
+  EXPECT_EQ(IOTA::Types::PackedTrits::packedSize(0), 0UL);
+}
+
+TEST(PackedTrits, Encoding) {
+  IOTA::Types::PackedTrits p({ 1, 0, 0, 0, 0, -1, 1, 0, 0, 0, 1, 1, 1, 1, 1 });
+
+  EXPECT_EQ(p.getBytes(), std::vector<uint8_t>({ 1, 2, 121 }));
+
+  IOTA::Types::PackedTrytes t({ -1, -1, -1, 1, 1 });
+
+  EXPECT_EQ(t.getBytes(), std::vector<uint8_t>({ static_cast<uint8_t>(-13), 4 }));
+}
+
+TEST(PackedTrits, RoundTripTrits) {
+  for (std::size_t size : { 0UL, 1UL, 4UL, 5UL, 6UL, 242UL, 243UL, 8019UL }) {
+    auto trits = sampleTrits(size);
+
+    EXPECT_EQ(IOTA::Types::PackedTrits(trits).toTrits(), trits);
+    EXPECT_EQ(IOTA::Types::PackedTrytes(trits).toTrits(), trits);
+  }
+}
+
+TEST(PackedTrits, RoundTripTrytes) {
+  IOTA::Types::Trytes trytes = IOTA::TryteAlphabet;
+
+  for (int i = 0; i < 100; ++i) {
+    trytes += IOTA::TryteAlphabet[(i * 11) % 27];
+  }
+
+  for (std::size_t size = 0; size < trytes.size(); ++size) {
+    auto sub = trytes.substr(0, size);
+    auto p   = IOTA::Types::PackedTrits::fromTrytes(sub);
+    auto t   = IOTA::Types::PackedTrytes::fromTrytes(sub);
+
+    EXPECT_EQ(p.size(), size * 3);
+    EXPECT_EQ(p.toTrits(), IOTA::Types::trytesToTrits(sub));
+    EXPECT_EQ(p.toTrytes(), sub);
+    EXPECT_EQ(t.toTrytes(), sub);
+    EXPECT_EQ(p, IOTA::Types::PackedTrits(IOTA::Types::trytesToTrits(sub)));
+  }
+}
+
+TEST(PackedTrits, FromTrytesInvalid) {
+  EXPECT_EXCEPTION(IOTA::Types::PackedTrits::fromTrytes("ABC8"), IOTA::Errors::IllegalState,
+                   "Invalid trytes provided");
+}
+
+TEST(PackedTrits, ToTrytesInvalidLength) {
+  IOTA::Types::PackedTrits p(4);
+
+  EXPECT_EXCEPTION(p.toTrytes(), IOTA::Errors::IllegalState, "Illegal length");
+}
+
+TEST(PackedTrits, FromBytes) {
+  auto trits = sampleTrits(243);
+  auto p     = IOTA::Types::PackedTrits(trits);
+
+  EXPECT_EQ(IOTA::Types::PackedTrits::fromBytes(p.getBytes(), 243), p);
+
+  EXPECT_EXCEPTION(IOTA::Types::PackedTrits::fromBytes(p.getBytes(), 250),
+                   IOTA::Errors::IllegalState, "Invalid packed trits size");
+
+  //! 122 is out of the T5B1 range
+  EXPECT_EXCEPTION(IOTA::Types::PackedTrits::fromBytes({ 122 }, 5), IOTA::Errors::IllegalState,
+                   "Invalid packed trits");
+
+  //! padding trits must be 0
+  EXPECT_EXCEPTION(IOTA::Types::PackedTrits::fromBytes({ 81 }, 4), IOTA::Errors::IllegalState,
+                   "Invalid packed trits");
+}
+
+TEST(PackedTrits, Set) {
+  auto                     trits = sampleTrits(17);
+  IOTA::Types::PackedTrits p(trits.size());
+
+  for (std::size_t i = 0; i < trits.size(); ++i) {
+    p.set(i, trits[i]);
+  }
+
+  EXPECT_EQ(p.toTrits(), trits);
+
+  p.set(3, -1);
+  trits[3] = -1;
+  EXPECT_EQ(p[3], -1);
+  EXPECT_EQ(p.toTrits(), trits);
+
+  EXPECT_EXCEPTION(p.set(17, 0), IOTA::Errors::IllegalState, "Index out of range");
+  EXPECT_EXCEPTION(p.set(0, 2), IOTA::Errors::IllegalState, "Invalid trit provided");
+}
+
+TEST(PackedTrits, AssignAndUnpack) {
+  auto trits = sampleTrits(100);
+
+  for (std::size_t offset : { 0UL, 1UL, 3UL, 5UL, 7UL, 20UL }) {
+    for (std::size_t length : { 0UL, 1UL, 4UL, 5UL, 13UL, 50UL }) {
+      IOTA::Types::PackedTrits p(trits);
+      IOTA::Types::Trits       update(length, 1);
+      IOTA::Types::Trits       expected = trits;
+
+      std::copy(update.begin(), update.end(), expected.begin() + offset);
+      p.assign(update.data(), offset, length);
+      EXPECT_EQ(p.toTrits(), expected);
+
+      IOTA::Types::Trits unpacked(length);
+      p.unpack(unpacked.data(), offset, length);
+      EXPECT_EQ(unpacked, update);
+    }
+  }
+
+  IOTA::Types::PackedTrits p(trits);
+  IOTA::Types::Trits       out(10);
+
+  EXPECT_EXCEPTION(p.unpack(out.data(), 95, 10), IOTA::Errors::IllegalState,
+                   "Index out of range");
+  EXPECT_EXCEPTION(p.assign(out.data(), 95, 10), IOTA::Errors::IllegalState,
+                   "Index out of range");
+}
+
+TEST(PackedTrits, Iterators) {
+  auto                      trits = sampleTrits(42);
+  IOTA::Types::PackedTrytes p(trits);
+
+  EXPECT_EQ(p.end() - p.begin(), 42);
+  EXPECT_EQ(IOTA::Types::Trits(p.begin(), p.end()), trits);
+  EXPECT_EQ(*(p.begin() + 10), trits[10]);
+  EXPECT_EQ(p.begin()[41], trits[41]);
+}
+
+TEST(PackedTrits, Comparison) {
+  auto                     trits = sampleTrits(10);
+  IOTA::Types::PackedTrits p1(trits);
+  IOTA::Types::PackedTrits p2(trits);
+
+  EXPECT_TRUE(p1 == p2);
+  EXPECT_FALSE(p1 != p2);
+
+  p2.set(9, p2[9] == 1 ? 0 : 1);
+
+  EXPECT_FALSE(p1 == p2);
+  EXPECT_TRUE(p1 != p2);
+  EXPECT_FALSE(p1 == IOTA::Types::PackedTrits(sampleTrits(9)));
+}
@@ -45,6 +45,27 @@ TEST(Trinary, IsValidTrytes) {
   EXPECT_FALSE(IOTA::Types::isValidTrytes("8"));
 }
 
+TEST(Trinary, IsValidTrytesLong) {
+  IOTA::Types::Trytes trytes;
+
+  for (int i = 0; i < 100; ++i) {
+    trytes += IOTA::TryteAlphabet;
+  }
+
+  EXPECT_TRUE(IOTA::Types::isValidTrytes(""));
+  EXPECT_TRUE(IOTA::Types::isValidTrytes(trytes));
+
+  //! any invalid char must be detected, in a full block or in the remainder
+  for (char c : { '8', ':', '@', '[', 'a', 'z', ' ', '\x80', '\xff', '\0' }) {
+    for (std::size_t pos : { 0UL, 7UL, 31UL, 32UL, 100UL, trytes.size() - 1 }) {
+      auto invalid = trytes;
+
+      invalid[pos] = c;
+      EXPECT_FALSE(IOTA::Types::isValidTrytes(invalid));
+    }
+  }
+}
+
 TEST(Trinary, IsArrayOfHashes) {
   EXPECT_TRUE(IOTA::Types::isArrayOfHashes(
       { "999999999999999999999999999999999999999999999999999999999999999999999999999999999",
@@ -124,6 +145,22 @@ TEST(Trinary, trytesToString) {
           "LCMCNCOCODPDQDRDEAI9J9"),
       "0123456789abcdefghijklmnopqrstuvwxyzABCDEFGHIJKLMNOPQRSTUVW"
       "XYZ!\"#$%&'()*+,-./:;<=>?@[\\]^_`{|}~ \t\n");
+  EXPECT_EXCEPTION(IOTA::Types::trytesToString("KBB8"), IOTA::Errors::IllegalState,
+                   "Invalid trytes provided");
+}
+
+TEST(Trinary, StringToTrytesRoundTrip) {
+  std::string str;
+
+  for (int c = 0; c < 256; ++c) {
+    str += static_cast<char>(c);
+  }
+
+  auto trytes = IOTA::Types::stringToTrytes(str);
+
+  EXPECT_EQ(trytes.size(), 512UL);
+  EXPECT_TRUE(IOTA::Types::isValidTrytes(trytes));
+  EXPECT_EQ(IOTA::Types::trytesToString(trytes), str);
 }
 
 TEST(Trinary, tritsToBytes) {
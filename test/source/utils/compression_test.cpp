@@ -0,0 +1,109 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#if defined(IOTA_WITH_ZLIB)
+#include <zlib.h>
+#endif
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/errors/network.hpp>
+#include <iota/errors/unrecognized.hpp>
+#include <iota/utils/compression.hpp>
+#include <test/utils/constants.hpp>
+#include <test/utils/expect_exception.hpp>
+
+#if defined(IOTA_WITH_ZLIB)
+
+TEST(Compression, RoundTrip) {
+  auto data       = "{\"trytes\":[\"" + BUNDLE_1_TRX_1_TRYTES + "\"]}";
+  auto compressed = IOTA::Utils::gzip(data);
+
+  //! gzip magic
+  ASSERT_GT(compressed.size(), 2UL);
+  EXPECT_EQ(static_cast<unsigned char>(compressed[0]), 0x1f);
+  EXPECT_EQ(static_cast<unsigned char>(compressed[1]), 0x8b);
+
+  EXPECT_LT(compressed.size(), data.size() / 2);
+  EXPECT_EQ(IOTA::Utils::inflate(compressed), data);
+}
+
+TEST(Compression, Empty) {
+  EXPECT_EQ(IOTA::Utils::inflate(IOTA::Utils::gzip("")), "");
+}
+
+TEST(Compression, Deflate) {
+  std::string data = BUNDLE_1_TRX_2_TRYTES + BUNDLE_1_TRX_3_TRYTES;
+
+  //! zlib-wrapped and raw deflate
+  for (int windowBits : { 15, -15 }) {
+    z_stream stream{};
+    ASSERT_EQ(deflateInit2(&stream, 9, Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY), Z_OK);
+
+    std::string out(deflateBound(&stream, data.size()), '\0');
+    stream.next_in   = reinterpret_cast<Bytef*>(&data[0]);
+    stream.avail_in  = data.size();
+    stream.next_out  = reinterpret_cast<Bytef*>(&out[0]);
+    stream.avail_out = out.size();
+    ASSERT_EQ(deflate(&stream, Z_FINISH), Z_STREAM_END);
+    out.resize(stream.total_out);
+    deflateEnd(&stream);
+
+    EXPECT_EQ(IOTA::Utils::inflate(out), data);
+  }
+}
+
+TEST(Compression, InvalidData) {
+  auto compressed = IOTA::Utils::gzip(BUNDLE_1_TRX_1_TRYTES);
+
+  EXPECT_EXCEPTION(IOTA::Utils::inflate("{\"not\":\"compressed\"}"), IOTA::Errors::Unrecognized,
+                   "Invalid compressed data");
+  EXPECT_EXCEPTION(IOTA::Utils::inflate(compressed.substr(0, compressed.size() / 2)),
+                   IOTA::Errors::Unrecognized, "Invalid compressed data");
+}
+
+TEST(Compression, MaxSize) {
+  std::string data(1024 * 1024, '9');
+  auto        compressed = IOTA::Utils::gzip(data);
+
+  //! a 1MB reply compresses to a few kB
+  EXPECT_LT(compressed.size(), data.size() / 100);
+  EXPECT_EQ(IOTA::Utils::inflate(compressed, data.size()), data);
+  EXPECT_EXCEPTION(IOTA::Utils::inflate(compressed, data.size() - 1), IOTA::Errors::Network,
+                   "Decompressed reply exceeds 1048575 bytes");
+}
+
+#else
+
+TEST(Compression, NotSupported) {
+  EXPECT_FALSE(IOTA::Utils::isCompressionSupported());
+  EXPECT_EXCEPTION(IOTA::Utils::gzip(BUNDLE_1_TRX_1_TRYTES), IOTA::Errors::IllegalState,
+                   "Compression is not supported: built without zlib");
+  EXPECT_EXCEPTION(IOTA::Utils::inflate(BUNDLE_1_TRX_1_TRYTES), IOTA::Errors::IllegalState,
+                   "Compression is not supported: built without zlib");
+}
+
+#endif
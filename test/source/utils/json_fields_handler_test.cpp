@@ -0,0 +1,124 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/errors/unrecognized.hpp>
+#include <iota/utils/json_fields_handler.hpp>
+#include <test/utils/expect_exception.hpp>
+
+namespace {
+
+void
+parse(IOTA::Utils::JsonFieldsHandler& handler, const std::string& json) {
+  IOTA::Utils::JsonStreamParser parser(handler);
+
+  parser.feed(json.data(), json.size());
+  parser.finish();
+}
+
+}  // namespace
+
+TEST(JsonFieldsHandler, BoundFields) {
+  IOTA::Utils::JsonFieldsHandler handler;
+  std::string                    name;
+  int64_t                        count = 0;
+  std::vector<std::string>       hashes;
+  std::vector<bool>              states;
+
+  handler.bindString("name", [&](std::string& v) { name = v; });
+  handler.bindInteger("count", [&](int64_t v) { count = v; });
+  handler.bindStrings("hashes", [&](std::string& v) { hashes.push_back(v); });
+  handler.bindBools("states", [&](bool v) { states.push_back(v); });
+
+  parse(handler,
+        "{\"name\":\"abc\",\"count\":-12,\"hashes\":[\"A\",\"B\"],\"states\":[true,false,true]}");
+
+  EXPECT_EQ(name, "abc");
+  EXPECT_EQ(count, -12);
+  EXPECT_EQ(hashes, std::vector<std::string>({ "A", "B" }));
+  EXPECT_EQ(states, std::vector<bool>({ true, false, true }));
+}
+
+TEST(JsonFieldsHandler, SkipOtherFields) {
+  IOTA::Utils::JsonFieldsHandler handler;
+  std::vector<std::string>       hashes;
+
+  handler.bindStrings("hashes", [&](std::string& v) { hashes.push_back(v); });
+
+  parse(handler, "{\"other\":[\"X\",{\"hashes\":[\"Y\"]}],\"nested\":{\"hashes\":[\"Z\"]},"
+                 "\"hashes\":[\"A\"],\"after\":\"B\",\"null\":null,\"n\":1.5}");
+
+  EXPECT_EQ(hashes, std::vector<std::string>({ "A" }));
+}
+
+TEST(JsonFieldsHandler, IntegerFormats) {
+  IOTA::Utils::JsonFieldsHandler handler;
+  std::vector<int64_t>           values;
+
+  handler.bindInteger("a", [&](int64_t v) { values.push_back(v); });
+  handler.bindInteger("b", [&](int64_t v) { values.push_back(v); });
+
+  parse(handler, "{\"a\":2779530283277761,\"b\":1e3}");
+
+  EXPECT_EQ(values, std::vector<int64_t>({ 2779530283277761, 1000 }));
+}
+
+TEST(JsonFieldsHandler, NullIsIgnored) {
+  IOTA::Utils::JsonFieldsHandler handler;
+  bool                           called = false;
+
+  handler.bindString("name", [&](std::string&) { called = true; });
+
+  parse(handler, "{\"name\":null}");
+
+  EXPECT_FALSE(called);
+}
+
+TEST(JsonFieldsHandler, TypeMismatch) {
+  auto parseBound = [](const std::string& json) {
+    IOTA::Utils::JsonFieldsHandler handler;
+
+    handler.bindString("name", [](std::string&) {});
+    handler.bindInteger("count", [](int64_t) {});
+    handler.bindStrings("hashes", [](std::string&) {});
+    handler.bindBools("states", [](bool) {});
+
+    parse(handler, json);
+  };
+
+  EXPECT_EXCEPTION(parseBound("{\"name\":1}"), IOTA::Errors::Unrecognized,
+                   "Invalid json: unexpected value for 'name'");
+  EXPECT_EXCEPTION(parseBound("{\"count\":\"1\"}"), IOTA::Errors::Unrecognized,
+                   "Invalid json: unexpected value for 'count'");
+  EXPECT_EXCEPTION(parseBound("{\"hashes\":\"A\"}"), IOTA::Errors::Unrecognized,
+                   "Invalid json: unexpected value for 'hashes'");
+  EXPECT_EXCEPTION(parseBound("{\"hashes\":[[\"A\"]]}"), IOTA::Errors::Unrecognized,
+                   "Invalid json: unexpected value for 'hashes'");
+  EXPECT_EXCEPTION(parseBound("{\"states\":[\"true\"]}"), IOTA::Errors::Unrecognized,
+                   "Invalid json: unexpected value for 'states'");
+  EXPECT_EXCEPTION(parseBound("{\"name\":{\"a\":\"b\"}}"), IOTA::Errors::Unrecognized,
+                   "Invalid json: unexpected value for 'name'");
+}
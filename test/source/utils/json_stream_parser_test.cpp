@@ -0,0 +1,138 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+
+#include <iota/errors/unrecognized.hpp>
+#include <iota/utils/json_stream_parser.hpp>
+#include <test/utils/expect_exception.hpp>
+
+namespace {
+
+//! Records parsing events as a flat string
+class Recorder : public IOTA::Utils::JsonStreamParser::Handler {
+public:
+  void onStartObject() override { events += "{"; }
+  void onEndObject() override { events += "}"; }
+  void onStartArray() override { events += "["; }
+  void onEndArray() override { events += "]"; }
+  void onKey(std::string& key) override { events += "k:" + key + ";"; }
+  void onString(std::string& value) override { events += "s:" + value + ";"; }
+  void onNumber(const std::string& value) override { events += "n:" + value + ";"; }
+  void onBool(bool value) override { events += value ? "true;" : "false;"; }
+  void onNull() override { events += "null;"; }
+
+public:
+  std::string events;
+};
+
+std::string
+parse(const std::string& json, std::size_t chunkSize = 0) {
+  Recorder                      recorder;
+  IOTA::Utils::JsonStreamParser parser(recorder);
+
+  if (chunkSize == 0) {
+    chunkSize = json.size();
+  }
+
+  for (std::size_t i = 0; i < json.size(); i += chunkSize) {
+    parser.feed(json.data() + i, std::min(chunkSize, json.size() - i));
+  }
+  parser.finish();
+
+  return recorder.events;
+}
+
+}  // namespace
+
+TEST(JsonStreamParser, Object) {
+  EXPECT_EQ(parse(R"({"trytes":["ABC","9"],"duration":12})"),
+            "{k:trytes;[s:ABC;s:9;]k:duration;n:12;}");
+}
+
+TEST(JsonStreamParser, Values) {
+  EXPECT_EQ(parse(R"( [ true , false, null, -1.5e3, "", {}, [] ] )"),
+            "[true;false;null;n:-1.5e3;s:;{}[]]");
+  EXPECT_EQ(parse("42"), "n:42;");
+  EXPECT_EQ(parse("\"A\""), "s:A;");
+}
+
+TEST(JsonStreamParser, Escapes) {
+  EXPECT_EQ(parse(R"(["a\"b\\c\/d\n\t", "\u0041\u00e9\ud83d\ude00"])"),
+            "[s:a\"b\\c/d\n\t;s:A\xc3\xa9\xf0\x9f\x98\x80;]");
+}
+
+TEST(JsonStreamParser, Chunks) {
+  const std::string json     = R"({"hashes":["ABC\u0041",12345,true,null],"error":"x\"y"})";
+  const std::string expected = parse(json);
+
+  for (std::size_t chunkSize = 1; chunkSize < json.size(); ++chunkSize) {
+    EXPECT_EQ(parse(json, chunkSize), expected);
+  }
+}
+
+TEST(JsonStreamParser, Depth) {
+  class DepthRecorder : public IOTA::Utils::JsonStreamParser::Handler {
+  public:
+    void onString(std::string&) override { depths.push_back(parser->depth()); }
+
+  public:
+    IOTA::Utils::JsonStreamParser* parser = nullptr;
+    std::vector<std::size_t>       depths;
+  };
+
+  DepthRecorder                 recorder;
+  IOTA::Utils::JsonStreamParser parser(recorder);
+  const std::string             json = R"({"a":"b","c":["d",["e"]]})";
+
+  recorder.parser = &parser;
+  parser.feed(json.data(), json.size());
+  parser.finish();
+
+  EXPECT_EQ(recorder.depths, std::vector<std::size_t>({ 1, 2, 3 }));
+}
+
+TEST(JsonStreamParser, Invalid) {
+  EXPECT_EXCEPTION(parse("{\"a\" 1}"), IOTA::Errors::Unrecognized, "Invalid json: expecting ':'");
+  EXPECT_EXCEPTION(parse("{1:2}"), IOTA::Errors::Unrecognized,
+                   "Invalid json: expecting object key");
+  EXPECT_EXCEPTION(parse("[1,]"), IOTA::Errors::Unrecognized, "Invalid json: expecting value");
+  EXPECT_EXCEPTION(parse("[1}"), IOTA::Errors::Unrecognized, "Invalid json: unexpected character");
+  EXPECT_EXCEPTION(parse("[1] 2"), IOTA::Errors::Unrecognized,
+                   "Invalid json: unexpected data after the end of the document");
+  EXPECT_EXCEPTION(parse("[\"abc"), IOTA::Errors::Unrecognized,
+                   "Invalid json: unexpected end of data");
+  EXPECT_EXCEPTION(parse("{\"a\":"), IOTA::Errors::Unrecognized,
+                   "Invalid json: unexpected end of data");
+  EXPECT_EXCEPTION(parse("[tru]"), IOTA::Errors::Unrecognized, "Invalid json: invalid literal");
+  EXPECT_EXCEPTION(parse("[1-2]"), IOTA::Errors::Unrecognized, "Invalid json: invalid number");
+  EXPECT_EXCEPTION(parse("[\"\\x\"]"), IOTA::Errors::Unrecognized,
+                   "Invalid json: invalid escape sequence");
+  EXPECT_EXCEPTION(parse("[\"\\u12g4\"]"), IOTA::Errors::Unrecognized,
+                   "Invalid json: invalid unicode escape");
+  EXPECT_EXCEPTION(parse("[\"a\nb\"]"), IOTA::Errors::Unrecognized,
+                   "Invalid json: control character in string");
+  EXPECT_EXCEPTION(parse(""), IOTA::Errors::Unrecognized, "Invalid json: unexpected end of data");
+}
@@ -0,0 +1,82 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <gtest/gtest.h>
+#include <json.hpp>
+
+#include <iota/utils/json_writer.hpp>
+
+using json = nlohmann::json;
+
+TEST(JsonWriter, Empty) {
+  IOTA::Utils::JsonWriter writer;
+
+  EXPECT_EQ(writer.str(), "");
+  writer.startObject().endObject();
+  EXPECT_EQ(writer.str(), "{}");
+}
+
+TEST(JsonWriter, Separators) {
+  IOTA::Utils::JsonWriter writer;
+
+  writer.startObject();
+  writer.key("a").value(1);
+  writer.key("b").value(std::vector<std::string>{ "x", "y" });
+  writer.key("c").value(std::vector<bool>{ true, false });
+  writer.key("d").startArray().endArray();
+  writer.key("e").startObject().key("f").value("g").endObject();
+  writer.endObject();
+
+  EXPECT_EQ(writer.str(),
+            "{\"a\":1,\"b\":[\"x\",\"y\"],\"c\":[true,false],\"d\":[],\"e\":{\"f\":\"g\"}}");
+}
+
+TEST(JsonWriter, Numbers) {
+  IOTA::Utils::JsonWriter writer;
+
+  writer.startArray().value(0).value(-42).value(static_cast<int64_t>(2779530283277761)).endArray();
+
+  EXPECT_EQ(writer.str(), "[0,-42,2779530283277761]");
+}
+
+TEST(JsonWriter, Escaping) {
+  IOTA::Utils::JsonWriter writer;
+  std::string             str = "a\"b\\c\nd\te\x01";
+
+  writer.startObject().key("k\"").value(str).endObject();
+
+  EXPECT_EQ(writer.str(), "{\"k\\\"\":\"a\\\"b\\\\c\\nd\\te\\u0001\"}");
+  EXPECT_EQ(json::parse(writer.str())["k\""], str);
+}
+
+TEST(JsonWriter, SameAsJson) {
+  IOTA::Utils::JsonWriter  writer;
+  std::vector<std::string> trytes(100, std::string(2673, '9'));
+
+  writer.startObject().key("command").value("storeTransactions").key("trytes").value(trytes);
+  writer.endObject();
+
+  EXPECT_EQ(writer.str(), (json{ { "command", "storeTransactions" }, { "trytes", trytes } }).dump());
+}
@@ -0,0 +1,222 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <atomic>
+#include <chrono>
+#include <mutex>
+#include <set>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/utils/parallel_for.hpp>
+#include <iota/utils/task_scheduler.hpp>
+#include <test/utils/expect_exception.hpp>
+
+TEST(TaskScheduler, Size) {
+  IOTA::Utils::TaskScheduler scheduler(3);
+
+  EXPECT_EQ(scheduler.getSize(), 3UL);
+  scheduler.setSize(0);
+  EXPECT_EQ(scheduler.getSize(), std::max(1U, std::thread::hardware_concurrency()));
+  scheduler.setSize(2);
+  EXPECT_EQ(scheduler.getSize(), 2UL);
+
+  scheduler.spawn([] {});
+  EXPECT_EXCEPTION(scheduler.setSize(4), IOTA::Errors::IllegalState,
+                   "Task scheduler already started");
+}
+
+TEST(TaskScheduler, ParallelFor) {
+  IOTA::Utils::TaskScheduler scheduler(4);
+  std::vector<int>           squares(1000);
+
+  scheduler.parallelFor(squares.size(), [&](std::size_t i) { squares[i] = i * i; });
+
+  for (std::size_t i = 0; i < squares.size(); ++i) {
+    EXPECT_EQ(squares[i], static_cast<int>(i * i));
+  }
+
+  scheduler.parallelFor(0, [](std::size_t) { FAIL(); });
+}
+
+TEST(TaskScheduler, ParallelForException) {
+  IOTA::Utils::TaskScheduler scheduler(2);
+  std::atomic<int>           calls(0);
+
+  EXPECT_EXCEPTION(scheduler.parallelFor(100,
+                                         [&](std::size_t i) {
+                                           ++calls;
+                                           if (i == 0) {
+                                             throw IOTA::Errors::IllegalState("failure");
+                                           }
+                                           std::this_thread::sleep_for(
+                                               std::chrono::milliseconds(1));
+                                         }),
+                   IOTA::Errors::IllegalState, "failure");
+
+  //! remaining calls are skipped
+  EXPECT_LT(calls, 100);
+}
+
+TEST(TaskScheduler, Balancing) {
+  IOTA::Utils::TaskScheduler scheduler(2);
+  std::mutex                 mutex;
+  std::set<std::thread::id>  fastThreads;
+  std::thread::id            slowThread;
+
+  //! a slow call must not hold back the calls that would have been in the same slice
+  scheduler.parallelFor(20, [&](std::size_t i) {
+    if (i == 0) {
+      slowThread = std::this_thread::get_id();
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      return;
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    fastThreads.insert(std::this_thread::get_id());
+  });
+
+  EXPECT_EQ(fastThreads.count(slowThread), 0UL);
+}
+
+TEST(TaskScheduler, Nested) {
+  IOTA::Utils::TaskScheduler scheduler(2);
+  std::atomic<int>           count(0);
+
+  //! more nested loops than threads: waiting threads must help instead of blocking
+  scheduler.parallelFor(8, [&](std::size_t) {
+    scheduler.parallelFor(8, [&](std::size_t) {
+      scheduler.parallelFor(8, [&](std::size_t) { ++count; });
+    });
+  });
+
+  EXPECT_EQ(count, 512);
+}
+
+TEST(TaskScheduler, DtorRunsPendingTasks) {
+  std::atomic<int> count(0);
+
+  {
+    IOTA::Utils::TaskScheduler scheduler(1);
+
+    for (int i = 0; i < 10; ++i) {
+      scheduler.spawn([&count] { ++count; });
+    }
+  }
+
+  EXPECT_EQ(count, 10);
+}
+
+TEST(TaskGroup, Wait) {
+  IOTA::Utils::TaskScheduler scheduler(2);
+  IOTA::Utils::TaskGroup     group(scheduler);
+  std::atomic<int>           count(0);
+
+  for (int i = 0; i < 50; ++i) {
+    group.run([&count] { ++count; });
+  }
+
+  group.wait();
+  EXPECT_EQ(count, 50);
+
+  group.run([] { throw IOTA::Errors::IllegalState("failure"); });
+  group.run([&count] { ++count; });
+
+  EXPECT_EXCEPTION(group.wait(), IOTA::Errors::IllegalState, "failure");
+  EXPECT_EQ(count, 51);
+
+  //! the error is reported once
+  group.wait();
+}
+
+TEST(TaskGroup, WaitOnlyRunsOwnTasks) {
+  IOTA::Utils::TaskScheduler scheduler(1);
+  IOTA::Utils::TaskGroup     group(scheduler);
+  std::atomic<bool>          release(false);
+  std::atomic<bool>          unrelated(false);
+  std::atomic<bool>          own(false);
+
+  //! keep the only thread busy, and queue an unrelated task behind it
+  scheduler.spawn([&release] {
+    while (!release) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  scheduler.spawn([&unrelated] { unrelated = true; });
+
+  group.run([&own] { own = true; });
+  group.wait();
+
+  EXPECT_TRUE(own);
+  EXPECT_FALSE(unrelated);
+
+  release = true;
+}
+
+TEST(TaskGroup, DefaultScheduler) {
+  std::atomic<int> count(0);
+
+  IOTA::Utils::parallel_for(10, 20, [&](std::size_t i) {
+    EXPECT_GE(i, 10UL);
+    EXPECT_LT(i, 20UL);
+    ++count;
+  });
+
+  EXPECT_EQ(count, 10);
+}
+
+TEST(ParallelFor, Threads) {
+  auto             threads = IOTA::Utils::TaskScheduler::getDefault().getSize() + 2;
+  std::atomic<int> running(0);
+  std::set<int>    cpus;
+  std::mutex       mutex;
+
+  //! all the calls run at once, whatever the size of the scheduler
+  IOTA::Utils::parallel_for(static_cast<int>(threads), [&](int cpu, int num_cpus) {
+    EXPECT_EQ(num_cpus, static_cast<int>(threads));
+    ++running;
+
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (running < num_cpus && std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+
+    std::lock_guard<std::mutex> lock(mutex);
+    cpus.insert(cpu);
+  });
+
+  EXPECT_EQ(running, static_cast<int>(threads));
+  EXPECT_EQ(cpus.size(), threads);
+
+  EXPECT_EXCEPTION(IOTA::Utils::parallel_for(
+                       2, [](int cpu, int) {
+                         if (cpu == 1) {
+                           throw IOTA::Errors::IllegalState("failure");
+                         }
+                       }),
+                   IOTA::Errors::IllegalState, "failure");
+}
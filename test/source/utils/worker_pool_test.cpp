@@ -0,0 +1,145 @@
+//
+// MIT License
+//
+// Copyright (c) 2017-2018 Thibault Martinez and Simon Ninon
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in
+// all copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+//
+//
+
+#include <atomic>
+#include <stdexcept>
+
+#include <gtest/gtest.h>
+
+#include <iota/errors/illegal_state.hpp>
+#include <iota/utils/worker_pool.hpp>
+#include <test/utils/expect_exception.hpp>
+
+TEST(WorkerPool, Submit) {
+  IOTA::Utils::WorkerPool pool;
+
+  auto answer  = pool.submit([] { return 42; });
+  auto nothing = pool.submit([] {});
+
+  EXPECT_EQ(answer.get(), 42);
+  nothing.get();
+}
+
+TEST(WorkerPool, Exception) {
+  IOTA::Utils::WorkerPool pool;
+
+  auto res = pool.submit([]() -> int { throw IOTA::Errors::IllegalState("failure"); });
+
+  EXPECT_EXCEPTION(res.get(), IOTA::Errors::IllegalState, "failure");
+}
+
+TEST(WorkerPool, ManyTasks) {
+  IOTA::Utils::WorkerPool       pool(3);
+  std::vector<std::future<int>> results;
+
+  for (int i = 0; i < 100; ++i) {
+    results.push_back(pool.submit([i] { return i * i; }));
+  }
+
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(results[i].get(), i * i);
+  }
+}
+
+TEST(WorkerPool, DtorRunsPendingTasks) {
+  std::atomic<int> count(0);
+
+  {
+    IOTA::Utils::WorkerPool pool(1);
+
+    for (int i = 0; i < 10; ++i) {
+      pool.submit([&count] { ++count; });
+    }
+  }
+
+  EXPECT_EQ(count, 10);
+}
+
+TEST(WorkerPool, DestroyedFromTask) {
+  auto pool = std::make_shared<IOTA::Utils::WorkerPool>(2);
+  auto res  = pool->submit([pool] { return 1; });
+
+  //! the task now owns the last reference to the pool
+  pool.reset();
+
+  EXPECT_EQ(res.get(), 1);
+}
+
+TEST(WorkerPool, Size) {
+  IOTA::Utils::WorkerPool pool;
+  EXPECT_EQ(pool.getSize(), IOTA::Utils::WorkerPool::DefaultSize);
+
+  pool.setSize(2);
+  EXPECT_EQ(pool.getSize(), 2UL);
+
+  EXPECT_EXCEPTION(pool.setSize(0), IOTA::Errors::IllegalState,
+                   "Worker pool needs at least one thread");
+
+  pool.submit([] {}).get();
+
+  EXPECT_EXCEPTION(pool.setSize(3), IOTA::Errors::IllegalState, "Worker pool already started");
+  EXPECT_EXCEPTION(IOTA::Utils::WorkerPool{ 0 }, IOTA::Errors::IllegalState,
+                   "Worker pool needs at least one thread");
+}
+
+TEST(WorkerPool, ParallelFor) {
+  IOTA::Utils::WorkerPool pool(3);
+  std::vector<int>        values(100, 0);
+
+  pool.parallelFor(values.size(), [&values](std::size_t i) { values[i] = static_cast<int>(i); });
+
+  for (std::size_t i = 0; i < values.size(); ++i) {
+    EXPECT_EQ(values[i], static_cast<int>(i));
+  }
+
+  pool.parallelFor(0, [](std::size_t) { FAIL(); });
+}
+
+TEST(WorkerPool, ParallelForException) {
+  IOTA::Utils::WorkerPool pool(2);
+
+  EXPECT_EXCEPTION(pool.parallelFor(10,
+                                    [](std::size_t i) {
+                                      if (i == 5) {
+                                        throw IOTA::Errors::IllegalState("failure");
+                                      }
+                                    }),
+                   IOTA::Errors::IllegalState, "failure");
+}
+
+TEST(WorkerPool, NestedParallelFor) {
+  IOTA::Utils::WorkerPool pool(2);
+  std::atomic<int>        count(0);
+
+  //! every thread of the pool waits on a nested loop
+  pool.parallelFor(4, [&](std::size_t) { pool.parallelFor(10, [&](std::size_t) { ++count; }); });
+
+  auto res = pool.submit([&] {
+    pool.parallelFor(10, [&](std::size_t) { ++count; });
+    return count.load();
+  });
+
+  EXPECT_EQ(res.get(), 50);
+}